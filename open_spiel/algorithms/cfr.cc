@@ -22,25 +22,11 @@
 namespace open_spiel {
 namespace algorithms {
 
-CFRAveragePolicy::CFRAveragePolicy(
-    const CFRInfoStateValuesTable& info_states,
-    std::shared_ptr<TabularPolicy> default_policy)
-    : info_states_(info_states), default_policy_(default_policy) {}
+namespace {
 
-ActionsAndProbs CFRAveragePolicy::GetStatePolicy(
-    const std::string& info_state) const {
+// The normalized cumulative policy, or uniform if it is zero everywhere.
+ActionsAndProbs AveragePolicyFromValues(const CFRInfoStateValues& is_vals) {
   ActionsAndProbs actions_and_probs;
-  auto entry = info_states_.find(info_state);
-  if (entry == info_states_.end()) {
-    if (default_policy_) {
-      return default_policy_->GetStatePolicy(info_state);
-    } else {
-      return actions_and_probs;
-    }
-  }
-
-  const CFRInfoStateValues& is_vals = entry->second;
-
   double sum_prob = 0.0;
   for (int aidx = 0; aidx < is_vals.num_actions(); ++aidx) {
     sum_prob += is_vals.cumulative_policy[aidx];
@@ -62,6 +48,44 @@ ActionsAndProbs CFRAveragePolicy::GetStatePolicy(
   return actions_and_probs;
 }
 
+}  // namespace
+
+CFRAveragePolicy::CFRAveragePolicy(
+    const CFRInfoStateValuesTable& info_states,
+    std::shared_ptr<TabularPolicy> default_policy)
+    : info_states_(info_states), default_policy_(default_policy) {}
+
+ActionsAndProbs CFRAveragePolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  auto entry = info_states_.find(info_state);
+  if (entry == info_states_.end()) {
+    if (default_policy_) {
+      return default_policy_->GetStatePolicy(info_state);
+    } else {
+      return {};
+    }
+  }
+  return AveragePolicyFromValues(entry->second);
+}
+
+CFRFingerprintAveragePolicy::CFRFingerprintAveragePolicy(
+    const CFRInfoStateValuesFingerprintTable& info_states,
+    std::shared_ptr<TabularPolicy> default_policy)
+    : info_states_(info_states), default_policy_(default_policy) {}
+
+ActionsAndProbs CFRFingerprintAveragePolicy::GetStatePolicy(
+    const State& state) const {
+  auto entry = info_states_.find(state.InformationStateFingerprint());
+  if (entry == info_states_.end()) {
+    if (default_policy_) {
+      return default_policy_->GetStatePolicy(state.InformationStateString());
+    } else {
+      return {};
+    }
+  }
+  return AveragePolicyFromValues(entry->second);
+}
+
 CFRCurrentPolicy::CFRCurrentPolicy(
     const CFRInfoStateValuesTable& info_states,
     std::shared_ptr<TabularPolicy> default_policy)
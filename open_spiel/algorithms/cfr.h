@@ -15,8 +15,10 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_H_
 
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/fingerprint.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -52,6 +54,11 @@ struct CFRInfoStateValues {
 using CFRInfoStateValuesTable =
     std::unordered_map<std::string, CFRInfoStateValues>;
 
+// A type for tables holding CFR values, keyed by information state
+// fingerprints instead of strings (see State::InformationStateFingerprint).
+using CFRInfoStateValuesFingerprintTable =
+    std::unordered_map<absl::uint128, CFRInfoStateValues, FingerprintHash>;
+
 // A policy that extracts the average policy from the CFR table values, which
 // can be passed to tabular exploitability.
 class CFRAveragePolicy : public Policy {
@@ -70,6 +77,21 @@ class CFRAveragePolicy : public Policy {
   std::shared_ptr<TabularPolicy> default_policy_;
 };
 
+// Same as CFRAveragePolicy, for tables keyed by fingerprints. A fingerprint
+// cannot be recovered from an information state string, so this policy can
+// only be queried with states.
+class CFRFingerprintAveragePolicy : public Policy {
+ public:
+  CFRFingerprintAveragePolicy(
+      const CFRInfoStateValuesFingerprintTable& info_states,
+      std::shared_ptr<TabularPolicy> default_policy);
+  ActionsAndProbs GetStatePolicy(const State& state) const override;
+
+ private:
+  const CFRInfoStateValuesFingerprintTable& info_states_;
+  std::shared_ptr<TabularPolicy> default_policy_;
+};
+
 // A policy that extracts the current policy from the CFR table values.
 class CFRCurrentPolicy : public Policy {
  public:
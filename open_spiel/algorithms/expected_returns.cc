@@ -223,13 +223,22 @@ std::vector<double> ExpectedReturns(const State& state,
 
 std::vector<double> ExpectedReturns(const State& state,
                                     const Policy& joint_policy,
-                                    int depth_limit) {
-  return ExpectedReturnsImpl(
-      state,
-      [&joint_policy](Player player, const std::string& info_state) {
-        return joint_policy.GetStatePolicy(info_state);
-      },
-      depth_limit);
+                                    int depth_limit, bool provides_infostate) {
+  if (provides_infostate) {
+    return ExpectedReturnsImpl(
+        state,
+        [&joint_policy](Player player, const std::string& info_state) {
+          return joint_policy.GetStatePolicy(info_state);
+        },
+        depth_limit);
+  } else {
+    return ExpectedReturnsImpl(
+        state,
+        [&joint_policy](Player player, const State& state) {
+          return joint_policy.GetStatePolicy(state);
+        },
+        depth_limit);
+  }
 }
 
 }  // namespace algorithms
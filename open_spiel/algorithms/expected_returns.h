@@ -39,7 +39,8 @@ std::vector<double> ExpectedReturns(const State& state,
                                     bool provides_infostate = true);
 std::vector<double> ExpectedReturns(const State& state,
                                     const Policy& joint_policy,
-                                    int depth_limit);
+                                    int depth_limit,
+                                    bool provides_infostate = true);
 
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -16,6 +16,7 @@
 
 #include <numeric>
 #include <random>
+#include <utility>
 
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/spiel.h"
@@ -26,10 +27,12 @@ namespace algorithms {
 
 ExternalSamplingMCCFRSolver::ExternalSamplingMCCFRSolver(const Game& game,
                                                          int seed,
-                                                         AverageType avg_type)
+                                                         AverageType avg_type,
+                                                         InfoStateKey key)
     : game_(game.Clone()),
       rng_(new std::mt19937(seed)),
       avg_type_(avg_type),
+      key_(key),
       dist_(0.0, 1.0),
       uniform_policy_(std::shared_ptr<TabularPolicy>(
           new TabularPolicy(GetUniformPolicy(game)))) {
@@ -69,15 +72,10 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
   }
 
   Player cur_player = state.CurrentPlayer();
-  std::string is_key = state.InformationStateString(cur_player);
   std::vector<Action> legal_actions = state.LegalActions();
+  CFRInfoStateValues& info_state = InfoStateValues(state, legal_actions);
 
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
-
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues info_state_copy = info_state;
   info_state_copy.ApplyRegretMatching();
 
   double value = 0;
@@ -97,8 +95,6 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
   }
 
   // Now the regret and avg strategy updates.
-  CFRInfoStateValues& info_state = info_states_[is_key];
-
   if (cur_player == player) {
     // Update regrets
     for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
@@ -140,15 +136,10 @@ void ExternalSamplingMCCFRSolver::FullUpdateAverage(
   if (sum == 0.0) return;
 
   Player cur_player = state.CurrentPlayer();
-  std::string is_key = state.InformationStateString(cur_player);
   std::vector<Action> legal_actions = state.LegalActions();
+  CFRInfoStateValues& info_state = InfoStateValues(state, legal_actions);
 
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
-
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues info_state_copy = info_state;
   info_state_copy.ApplyRegretMatching();
 
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
@@ -158,12 +149,27 @@ void ExternalSamplingMCCFRSolver::FullUpdateAverage(
   }
 
   // Now update the cumulative policy.
-  CFRInfoStateValues& info_state = info_states_[is_key];
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
     info_state.cumulative_policy[aidx] +=
         (reach_probs[cur_player] * info_state_copy.current_policy[aidx]);
   }
 }
 
+CFRInfoStateValues& ExternalSamplingMCCFRSolver::InfoStateValues(
+    const State& state, const std::vector<Action>& legal_actions) {
+  // The insert here only inserts the default value if the key is not found,
+  // otherwise returns the entry in the map. Entries never move, so the
+  // reference stays valid while the subtree below is traversed.
+  CFRInfoStateValues values(legal_actions, kInitialTableValues);
+  if (key_ == InfoStateKey::kFingerprint) {
+    return fingerprint_info_states_
+        .insert({state.InformationStateFingerprint(), std::move(values)})
+        .first->second;
+  }
+  return info_states_
+      .insert({state.InformationStateString(), std::move(values)})
+      .first->second;
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
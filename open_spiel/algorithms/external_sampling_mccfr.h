@@ -54,13 +54,22 @@ enum class AverageType {
   kFull,
 };
 
+// How the solver keys its tables. Fingerprints avoid building an information
+// state string at every node, which dominates the running time in games such
+// as poker, but the resulting average policy can only be queried with states.
+enum class InfoStateKey {
+  kString,
+  kFingerprint,
+};
+
 class ExternalSamplingMCCFRSolver {
  public:
   static inline constexpr double kInitialTableValues = 0.000001;
 
   // Creates a solver with a specific seed and average type.
   ExternalSamplingMCCFRSolver(const Game& game, int seed = 0,
-                              AverageType avg_type = AverageType::kSimple);
+                              AverageType avg_type = AverageType::kSimple,
+                              InfoStateKey key = InfoStateKey::kString);
 
   // Performs one iteration of external sampling MCCFR, updating the regrets
   // and average strategy for all players. This method uses the internal random
@@ -74,6 +83,10 @@ class ExternalSamplingMCCFRSolver {
   // The returned policy instance should only be used during the lifetime of
   // the CFRSolver object.
   std::unique_ptr<Policy> AveragePolicy() const {
+    if (key_ == InfoStateKey::kFingerprint) {
+      return std::unique_ptr<Policy>(new CFRFingerprintAveragePolicy(
+          fingerprint_info_states_, uniform_policy_));
+    }
     return std::unique_ptr<Policy>(
         new CFRAveragePolicy(info_states_, uniform_policy_));
   }
@@ -82,11 +95,18 @@ class ExternalSamplingMCCFRSolver {
   double UpdateRegrets(const State& state, Player player, std::mt19937* rng);
   void FullUpdateAverage(const State& state,
                          const std::vector<double>& reach_probs);
+  // Returns the table entry for the information state of the player to move
+  // in `state`, inserting it first if needed.
+  CFRInfoStateValues& InfoStateValues(const State& state,
+                                      const std::vector<Action>& legal_actions);
 
   std::shared_ptr<const Game> game_;
   std::unique_ptr<std::mt19937> rng_;
   AverageType avg_type_;
+  InfoStateKey key_;
+  // Only the table selected by key_ is used.
   CFRInfoStateValuesTable info_states_;
+  CFRInfoStateValuesFingerprintTable fingerprint_info_states_;
   std::uniform_real_distribution<double> dist_;
   std::shared_ptr<TabularPolicy> uniform_policy_;
 };
@@ -63,6 +63,22 @@ void MCCFR_KuhnPoker3PTest(std::mt19937* rng) {
             << NashConv(*game, *full_average_policy) << std::endl;
 }
 
+// Keying the tables by fingerprints must not change the computation.
+void MCCFR_FingerprintKeysTest(const std::string& game_name, int iterations) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  ExternalSamplingMCCFRSolver string_solver(*game, kSeed);
+  ExternalSamplingMCCFRSolver fingerprint_solver(
+      *game, kSeed, AverageType::kSimple, InfoStateKey::kFingerprint);
+  for (int i = 0; i < iterations; i++) {
+    string_solver.RunIteration();
+    fingerprint_solver.RunIteration();
+  }
+  SPIEL_CHECK_FLOAT_EQ(
+      NashConv(*game, *string_solver.AveragePolicy()),
+      NashConv(*game, *fingerprint_solver.AveragePolicy(),
+               /*use_state_get_policy=*/true));
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -78,4 +94,7 @@ int main(int argc, char** argv) {
   algorithms::MCCFR_2PGameTest("leduc_poker", &rng, 1000, 3.0);
   algorithms::MCCFR_2PGameTest("liars_dice", &rng, 1000, 1.0);
   algorithms::MCCFR_KuhnPoker3PTest(&rng);
+  algorithms::MCCFR_FingerprintKeysTest("kuhn_poker", 100);
+  algorithms::MCCFR_FingerprintKeysTest("leduc_poker", 100);
+  algorithms::MCCFR_FingerprintKeysTest("liars_dice", 100);
 }
@@ -0,0 +1,314 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/is_mcts.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>  // NOLINT
+#include <unordered_map>
+
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/fingerprint.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Hands out arrays of T from large blocks. Clear makes all the blocks
+// available again without freeing them, so a search reuses the memory of the
+// previous one.
+template <typename T>
+class Arena {
+ public:
+  // Returns n value-initialized objects.
+  T* Allocate(int n) {
+    while (block_ < blocks_.size() && used_ + n > blocks_[block_].size) {
+      ++block_;
+      used_ = 0;
+    }
+    if (block_ == blocks_.size()) {
+      const int size = std::max(n, kBlockSize);
+      blocks_.push_back({std::make_unique<T[]>(size), size});
+      used_ = 0;
+    }
+    T* objects = blocks_[block_].objects.get() + used_;
+    used_ += n;
+    std::fill(objects, objects + n, T());
+    return objects;
+  }
+
+  void Clear() {
+    block_ = 0;
+    used_ = 0;
+  }
+
+ private:
+  static constexpr int kBlockSize = 4096;
+
+  struct Block {
+    std::unique_ptr<T[]> objects;
+    int size;
+  };
+  std::vector<Block> blocks_;
+  int block_ = 0;  // The block being filled.
+  int used_ = 0;   // The number of objects handed out from it.
+};
+
+absl::uint128 Extend(absl::uint128 key, int64_t value) {
+  return Fingerprinter()
+      .Add(absl::Uint128High64(key))
+      .Add(absl::Uint128Low64(key))
+      .Add(value)
+      .Fingerprint();
+}
+
+}  // namespace
+
+// The search of one thread.
+class ISMCTSBot::Tree {
+ public:
+  Tree(ISMCTSObserver observer, double uct_c,
+       std::unique_ptr<Evaluator> evaluator, int seed)
+      : observer_(observer),
+        uct_c_(uct_c),
+        evaluator_(std::move(evaluator)),
+        rng_(seed) {}
+
+  // Forgets the previous search and runs `num_simulations` from `state`.
+  void Search(const State& state, int num_simulations) {
+    nodes_.clear();
+    node_arena_.Clear();
+    edge_arena_.Clear();
+    const Player player = state.CurrentPlayer();
+    const absl::uint128 infostate = state.InformationStateFingerprint(player);
+    for (int i = 0; i < num_simulations; ++i) {
+      Simulate(state, player, infostate);
+    }
+    auto it = nodes_.find(Extend(infostate, player));
+    root_ = it == nodes_.end() ? nullptr : it->second;
+  }
+
+  // The root of the last search, if a simulation got there.
+  const ISMCTSNode* root() const { return root_; }
+
+ private:
+  void Simulate(const State& root_state, Player root_player,
+                absl::uint128 root_infostate) {
+    std::unique_ptr<State> state =
+        root_state.ResampleFromInfostate(root_player, [this]() {
+          return std::uniform_real_distribution<double>()(rng_);
+        });
+    // In the single observer tree, the root followed by all the actions.
+    absl::uint128 path = root_infostate;
+    visit_path_.clear();
+    std::vector<double> returns;
+    while (true) {
+      if (state->IsTerminal()) {
+        returns = state->Returns();
+        break;
+      }
+      if (state->IsChanceNode()) {
+        const double z = std::uniform_real_distribution<double>()(rng_);
+        const Action outcome = SampleAction(state->ChanceOutcomes(), z).first;
+        if (observer_ == ISMCTSObserver::kSingle) path = Extend(path, outcome);
+        state->ApplyAction(outcome);
+        continue;
+      }
+      const Player player = state->CurrentPlayer();
+      const absl::uint128 key =
+          observer_ == ISMCTSObserver::kSingle
+              ? Extend(path, player)
+              : Extend(state->InformationStateFingerprint(player), player);
+      ISMCTSNode*& node = nodes_[key];
+      if (node == nullptr) {
+        // A new leaf: evaluate the determinization from here.
+        node = node_arena_.Allocate(1);
+        node->player = player;
+        returns = evaluator_->Evaluate(*state);
+        break;
+      }
+      const int edge = SelectEdge(node, state->LegalActions());
+      visit_path_.push_back({node, edge});
+      const Action action = node->edges[edge].action;
+      if (observer_ == ISMCTSObserver::kSingle) path = Extend(path, action);
+      state->ApplyAction(action);
+    }
+    for (const auto& [node, edge] : visit_path_) {
+      ++node->edges[edge].explore_count;
+      node->edges[edge].total_reward += returns[node->player];
+    }
+  }
+
+  // Returns the index of the edge to follow among those of the legal actions,
+  // which are marked available.
+  int SelectEdge(ISMCTSNode* node, const std::vector<Action>& legal_actions) {
+    candidates_.clear();
+    for (Action action : legal_actions) {
+      candidates_.push_back(FindOrAddEdge(node, action));
+    }
+    unexplored_.clear();
+    int best = -1;
+    double best_value = -std::numeric_limits<double>::infinity();
+    for (int index : candidates_) {
+      ISMCTSEdge& edge = node->edges[index];
+      ++edge.available_count;
+      if (edge.explore_count == 0) {
+        unexplored_.push_back(index);
+        continue;
+      }
+      const double value =
+          edge.total_reward / edge.explore_count +
+          uct_c_ * std::sqrt(std::log(edge.available_count) /
+                             edge.explore_count);
+      if (value > best_value) {
+        best = index;
+        best_value = value;
+      }
+    }
+    if (!unexplored_.empty()) {
+      return unexplored_[std::uniform_int_distribution<int>(
+          0, unexplored_.size() - 1)(rng_)];
+    }
+    return best;
+  }
+
+  int FindOrAddEdge(ISMCTSNode* node, Action action) {
+    for (int i = 0; i < node->num_edges; ++i) {
+      if (node->edges[i].action == action) return i;
+    }
+    if (node->num_edges == node->capacity) {
+      // The old edges stay in the arena until the next search.
+      const int capacity = std::max(4, 2 * node->capacity);
+      ISMCTSEdge* edges = edge_arena_.Allocate(capacity);
+      std::copy(node->edges, node->edges + node->num_edges, edges);
+      node->edges = edges;
+      node->capacity = capacity;
+    }
+    node->edges[node->num_edges].action = action;
+    return node->num_edges++;
+  }
+
+  const ISMCTSObserver observer_;
+  const double uct_c_;
+  std::unique_ptr<Evaluator> evaluator_;
+  std::mt19937 rng_;
+  Arena<ISMCTSNode> node_arena_;
+  Arena<ISMCTSEdge> edge_arena_;
+  std::unordered_map<absl::uint128, ISMCTSNode*, FingerprintHash> nodes_;
+  const ISMCTSNode* root_ = nullptr;
+  // Reused by each simulation.
+  std::vector<std::pair<ISMCTSNode*, int>> visit_path_;
+  std::vector<int> candidates_;
+  std::vector<int> unexplored_;
+};
+
+EvaluatorFactory RandomRolloutEvaluatorFactory(int n_rollouts) {
+  return [n_rollouts](int seed) {
+    return std::make_unique<RandomRolloutEvaluator>(n_rollouts, seed);
+  };
+}
+
+ISMCTSBot::ISMCTSBot(const Game& game, EvaluatorFactory evaluator_factory,
+                     double uct_c, int max_simulations,
+                     ISMCTSObserver observer, int num_threads, int seed)
+    : max_simulations_(max_simulations) {
+  SPIEL_CHECK_GT(max_simulations, 0);
+  SPIEL_CHECK_GT(num_threads, 0);
+  GameType game_type = game.GetType();
+  if (game_type.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("ISMCTS requires sequential games.");
+  }
+  if (!game_type.provides_information_state_string) {
+    SpielFatalError("ISMCTS requires information states.");
+  }
+  for (int t = 0; t < num_threads; ++t) {
+    trees_.push_back(std::make_unique<Tree>(
+        observer, uct_c, evaluator_factory(seed + t), seed + t));
+  }
+}
+
+ISMCTSBot::~ISMCTSBot() = default;
+
+std::vector<ISMCTSEdge> ISMCTSBot::Search(const State& state) {
+  SPIEL_CHECK_FALSE(state.IsTerminal());
+  SPIEL_CHECK_FALSE(state.IsChanceNode());
+  const int num_threads = trees_.size();
+  auto search = [&](int t) {
+    // The simulations left over by the division go to the first threads.
+    const int num_simulations = max_simulations_ / num_threads +
+                                (t < max_simulations_ % num_threads ? 1 : 0);
+    trees_[t]->Search(state, num_simulations);
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int t = 1; t < num_threads; ++t) threads.emplace_back(search, t);
+  search(0);
+  for (std::thread& thread : threads) thread.join();
+
+  const std::vector<Action> legal_actions = state.LegalActions();
+  std::vector<ISMCTSEdge> edges(legal_actions.size());
+  for (int i = 0; i < legal_actions.size(); ++i) {
+    edges[i].action = legal_actions[i];
+  }
+  for (const std::unique_ptr<Tree>& tree : trees_) {
+    const ISMCTSNode* root = tree->root();
+    if (root == nullptr) continue;
+    for (int i = 0; i < root->num_edges; ++i) {
+      const ISMCTSEdge& edge = root->edges[i];
+      auto it = std::find(legal_actions.begin(), legal_actions.end(),
+                          edge.action);
+      SPIEL_CHECK_TRUE(it != legal_actions.end());
+      ISMCTSEdge& total = edges[it - legal_actions.begin()];
+      total.explore_count += edge.explore_count;
+      total.available_count += edge.available_count;
+      total.total_reward += edge.total_reward;
+    }
+  }
+  return edges;
+}
+
+std::pair<ActionsAndProbs, Action> ISMCTSBot::StepWithPolicy(
+    const State& state) {
+  const std::vector<ISMCTSEdge> edges = Search(state);
+  ActionsAndProbs policy;
+  policy.reserve(edges.size());
+  int total_count = 0;
+  const ISMCTSEdge* best = &edges[0];
+  for (const ISMCTSEdge& edge : edges) {
+    total_count += edge.explore_count;
+    if (edge.explore_count > best->explore_count) best = &edge;
+  }
+  for (const ISMCTSEdge& edge : edges) {
+    policy.push_back({edge.action, total_count > 0
+                                       ? edge.explore_count /
+                                             static_cast<double>(total_count)
+                                       : 1.0 / edges.size()});
+  }
+  return {policy, best->action};
+}
+
+Action ISMCTSBot::Step(const State& state) {
+  return StepWithPolicy(state).second;
+}
+
+ActionsAndProbs ISMCTSBot::GetPolicy(const State& state) {
+  return StepWithPolicy(state).first;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,129 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_IS_MCTS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_IS_MCTS_H_
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+
+// Information Set Monte Carlo Tree Search (ISMCTS).
+//
+// MCTSBot searches the tree of the actual state, so in an imperfect
+// information game it plays as if it could see the hidden information. ISMCTS
+// only uses what the searching player knows: each simulation starts from a
+// new determinization, a state sampled with State::ResampleFromInfostate, and
+// the statistics are stored in nodes keyed by information states, so that
+// all the determinizations share them.
+//
+// As the set of legal actions can change between determinizations, an action
+// is scored by UCT over the simulations in which it was legal (its
+// availability) rather than over all the visits of its node.
+//
+// Two variants are implemented:
+// - single observer (SO-ISMCTS): one tree, seen by the searching player. A
+//   node is the player's information state at the root followed by the
+//   actions played since, so the moves of the other players are treated as
+//   if they were observed, and they choose their moves without using their
+//   own private information.
+// - multi observer (MO-ISMCTS): every player chooses its moves in its own
+//   tree, whose nodes are its own information states. Nobody uses what they
+//   cannot observe, which matters in games with hidden moves like phantom
+//   games.
+//
+// The search is parallelized at the root: each thread runs its share of the
+// simulations in its own tree, and the statistics of the root actions are
+// summed at the end. The nodes of each tree are allocated from an arena that
+// is kept from one search to the next.
+//
+// The game must implement ResampleFromInfostate and information state
+// strings (or fingerprints).
+//
+// Some references:
+// - Cowling, Powley and Whitehouse, Information Set Monte Carlo Tree Search,
+//   2012. https://ieeexplore.ieee.org/document/6203567
+// - Chaslot, Winands and van den Herik, Parallel Monte-Carlo Tree Search,
+//   2008.
+
+namespace open_spiel {
+namespace algorithms {
+
+enum class ISMCTSObserver {
+  kSingle,
+  kMulti,
+};
+
+// Creates the evaluator of a search thread, with its own seed. Evaluators are
+// never shared between threads.
+using EvaluatorFactory = std::function<std::unique_ptr<Evaluator>(int seed)>;
+
+// Makes RandomRolloutEvaluators.
+EvaluatorFactory RandomRolloutEvaluatorFactory(int n_rollouts);
+
+// The statistics of an action in a node.
+struct ISMCTSEdge {
+  Action action = 0;
+  int explore_count = 0;    // Number of times the action was chosen.
+  int available_count = 0;  // Number of times the action was legal.
+  double total_reward = 0;  // Total reward of the player of the node.
+};
+
+// A node of the search. Its edges are stored in the arena of its tree, and
+// added the first time their action is legal.
+struct ISMCTSNode {
+  Player player = 0;
+  ISMCTSEdge* edges = nullptr;
+  int num_edges = 0;
+  int capacity = 0;
+};
+
+class ISMCTSBot : public Bot {
+ public:
+  // Runs `max_simulations` simulations per move, split over `num_threads`
+  // threads.
+  ISMCTSBot(const Game& game, EvaluatorFactory evaluator_factory, double uct_c,
+            int max_simulations, ISMCTSObserver observer, int num_threads,
+            int seed);
+  ~ISMCTSBot() override;
+
+  // Plays the most explored action.
+  Action Step(const State& state) override;
+
+  bool ProvidesPolicy() override { return true; }
+  // The fraction of the simulations that chose each legal action.
+  ActionsAndProbs GetPolicy(const State& state) override;
+  std::pair<ActionsAndProbs, Action> StepWithPolicy(
+      const State& state) override;
+
+  // Searches from `state` and returns the statistics of its legal actions,
+  // summed over the threads, in the order of LegalActions().
+  std::vector<ISMCTSEdge> Search(const State& state);
+
+ private:
+  class Tree;
+
+  const int max_simulations_;
+  std::vector<std::unique_ptr<Tree>> trees_;  // One per thread.
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_IS_MCTS_H_
@@ -0,0 +1,124 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/is_mcts.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kUCTc = 2;
+
+std::unique_ptr<Bot> MakeISMCTSBot(const Game& game, ISMCTSObserver observer,
+                                   int max_simulations, int seed) {
+  return std::make_unique<ISMCTSBot>(game, RandomRolloutEvaluatorFactory(1),
+                                     kUCTc, max_simulations, observer,
+                                     /*num_threads=*/4, seed);
+}
+
+void ISMCTSPlaysKuhnFacingABet(ISMCTSObserver observer) {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::unique_ptr<Bot> bot = MakeISMCTSBot(*game, observer, 2000, 1234);
+  for (Action card : {0, 2}) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    state->ApplyAction(1);     // Queen to player 0.
+    state->ApplyAction(card);  // Jack or King to player 1.
+    state->ApplyAction(1);     // Bet.
+    // Fold the Jack, call with the King.
+    SPIEL_CHECK_EQ(bot->Step(*state), card == 0 ? 0 : 1);
+  }
+}
+
+// States that player 0 cannot tell apart get the same search.
+void ISMCTSDoesNotPeek(ISMCTSObserver observer) {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  std::vector<std::vector<ISMCTSEdge>> searches;
+  for (Action opponent_card : {2, 5}) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    state->ApplyAction(0);
+    state->ApplyAction(opponent_card);
+    ISMCTSBot bot(*game, RandomRolloutEvaluatorFactory(1), kUCTc,
+                  /*max_simulations=*/500, observer, /*num_threads=*/2,
+                  /*seed=*/42);
+    searches.push_back(bot.Search(*state));
+  }
+  SPIEL_CHECK_EQ(searches[0].size(), searches[1].size());
+  int num_simulations = 0;
+  for (int i = 0; i < searches[0].size(); ++i) {
+    SPIEL_CHECK_EQ(searches[0][i].action, searches[1][i].action);
+    SPIEL_CHECK_EQ(searches[0][i].explore_count,
+                   searches[1][i].explore_count);
+    SPIEL_CHECK_FLOAT_EQ(searches[0][i].total_reward,
+                         searches[1][i].total_reward);
+    num_simulations += searches[0][i].explore_count;
+  }
+  // All but the first simulation of each thread go through a root action.
+  SPIEL_CHECK_EQ(num_simulations, 500 - 2);
+}
+
+// Returns the average return of an ISMCTS bot against a random one.
+double PlayAgainstRandom(const std::string& game_name,
+                         ISMCTSObserver observer, int num_games) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::mt19937 rng(7);
+  double total_return = 0;
+  for (int i = 0; i < num_games; ++i) {
+    const Player player = i % game->NumPlayers();
+    std::vector<std::unique_ptr<Bot>> bots;
+    for (Player p = 0; p < game->NumPlayers(); ++p) {
+      bots.push_back(p == player ? MakeISMCTSBot(*game, observer, 300, i)
+                                 : MakeUniformRandomBot(p, i));
+    }
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (state->IsChanceNode()) {
+        const double z = std::uniform_real_distribution<double>()(rng);
+        state->ApplyAction(SampleAction(state->ChanceOutcomes(), z).first);
+      } else {
+        state->ApplyAction(bots[state->CurrentPlayer()]->Step(*state));
+      }
+    }
+    total_return += state->Returns()[player];
+  }
+  return total_return / num_games;
+}
+
+void ISMCTSBeatsRandom(ISMCTSObserver observer) {
+  for (const std::string game_name :
+       {"phantom_ttt", "liars_dice", "leduc_poker"}) {
+    SPIEL_CHECK_GT(PlayAgainstRandom(game_name, observer, 40), 0.2);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  for (auto observer : {open_spiel::algorithms::ISMCTSObserver::kSingle,
+                        open_spiel::algorithms::ISMCTSObserver::kMulti}) {
+    open_spiel::algorithms::ISMCTSPlaysKuhnFacingABet(observer);
+    open_spiel::algorithms::ISMCTSDoesNotPeek(observer);
+    open_spiel::algorithms::ISMCTSBeatsRandom(observer);
+  }
+}
@@ -19,6 +19,7 @@
 #include <limits>
 #include <memory>
 #include <random>
+#include <utility>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
@@ -43,7 +44,7 @@ constexpr inline int VectorMemory(const std::vector<T>& vec) {
 std::vector<double> RandomRolloutEvaluator::Evaluate(const State& state) {
   std::vector<double> result;
   for (int i = 0; i < n_rollouts_; ++i) {
-    std::unique_ptr<State> working_state = state.Clone();
+    std::unique_ptr<State> working_state = state_pool_.Clone(state);
     while (!working_state->IsTerminal()) {
       if (working_state->IsChanceNode()) {
         ActionsAndProbs outcomes = working_state->ChanceOutcomes();
@@ -61,6 +62,7 @@ std::vector<double> RandomRolloutEvaluator::Evaluate(const State& state) {
     }
 
     std::vector<double> returns = working_state->Returns();
+    state_pool_.Release(std::move(working_state));
     if (result.empty()) {
       result.swap(returns);
     } else {
@@ -257,7 +259,7 @@ std::unique_ptr<State> MCTSBot::ApplyTreePolicy(
     SearchNode* root, const State& state,
     std::vector<SearchNode*>* visit_path) {
   visit_path->push_back(root);
-  std::unique_ptr<State> working_state = state.Clone();
+  std::unique_ptr<State> working_state = state_pool_.Clone(state);
   SearchNode* current_node = root;
   while (!working_state->IsTerminal() && current_node->explore_count > 0) {
     if (current_node->children.empty()) {
@@ -349,6 +351,7 @@ std::unique_ptr<SearchNode> MCTSBot::MCTSearch(const State& state) {
       returns = evaluator_->Evaluate(*working_state);
       solved = false;
     }
+    state_pool_.Release(std::move(working_state));
 
     // Propagate values back.
     for (auto it = visit_path.rbegin(); it != visit_path.rend(); ++it) {
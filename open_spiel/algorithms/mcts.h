@@ -18,6 +18,7 @@
 #include <memory>
 #include <random>
 
+#include "open_spiel/algorithms/state_pool.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_bots.h"
 
@@ -103,6 +104,7 @@ class RandomRolloutEvaluator : public Evaluator {
  private:
   int n_rollouts_;
   std::mt19937 rng_;
+  StatePool state_pool_;  // Recycles the rollout states.
 };
 
 // A node in the search tree for MCTS
@@ -192,6 +194,7 @@ class MCTSBot : public Bot {
   std::mt19937 rng_;
   const ChildSelectionPolicy child_selection_policy_;
   Evaluator* evaluator_;
+  StatePool state_pool_;  // Recycles the working state of each simulation.
 };
 
 // Returns a vector of noise sampled from a dirichlet distribution. See:
@@ -0,0 +1,147 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/pimc.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>  // NOLINT
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+WorldSolver MCTSWorldSolver(double uct_c, int max_simulations,
+                            int num_rollouts) {
+  return [=](const State& world, int seed) {
+    RandomRolloutEvaluator evaluator(num_rollouts, seed);
+    MCTSBot bot(*world.GetGame(), &evaluator, uct_c, max_simulations,
+                /*max_memory_mb=*/1000, /*solve=*/true, seed,
+                /*verbose=*/false);
+    std::unique_ptr<SearchNode> root = bot.MCTSearch(world);
+    const Player player = world.CurrentPlayer();
+    std::vector<Action> legal_actions = world.LegalActions();
+    std::vector<double> values(legal_actions.size());
+    for (const SearchNode& child : root->children) {
+      const int index =
+          std::find(legal_actions.begin(), legal_actions.end(), child.action) -
+          legal_actions.begin();
+      if (!child.outcome.empty()) {
+        values[index] = child.outcome[player];
+      } else if (child.explore_count > 0) {
+        values[index] = child.total_reward / child.explore_count;
+      }
+    }
+    return values;
+  };
+}
+
+WorldSolverRegisterer::WorldSolverRegisterer(const std::string& short_name,
+                                             WorldSolver solver) {
+  solvers()[short_name] = std::move(solver);
+}
+
+bool WorldSolverRegisterer::IsRegistered(const std::string& short_name) {
+  return solvers().find(short_name) != solvers().end();
+}
+
+WorldSolver WorldSolverRegisterer::Get(const Game& game) {
+  auto iter = solvers().find(game.GetType().short_name);
+  if (iter == solvers().end()) return MCTSWorldSolver();
+  return iter->second;
+}
+
+PIMCBot::PIMCBot(const Game& game, Player player_id, WorldSolver solver,
+                 int num_worlds, double max_time_seconds, int num_threads,
+                 int seed)
+    : player_id_(player_id),
+      solver_(std::move(solver)),
+      num_worlds_(num_worlds),
+      max_time_seconds_(max_time_seconds),
+      num_threads_(num_threads),
+      rng_(seed) {
+  SPIEL_CHECK_GT(num_worlds_, 0);
+  SPIEL_CHECK_GT(num_threads_, 0);
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("PIMC requires a sequential game.");
+  }
+}
+
+Action PIMCBot::Step(const State& state) {
+  SPIEL_CHECK_EQ(state.CurrentPlayer(), player_id_);
+  const std::vector<Action> legal_actions = state.LegalActions();
+  if (legal_actions.size() == 1) return legal_actions[0];
+  const std::vector<double> values = ActionValues(state);
+  return legal_actions[std::max_element(values.begin(), values.end()) -
+                       values.begin()];
+}
+
+std::vector<double> PIMCBot::ActionValues(const State& state) {
+  const int num_actions = state.LegalActions().size();
+  const absl::Time deadline =
+      max_time_seconds_ > 0
+          ? absl::Now() + absl::Seconds(max_time_seconds_)
+          : absl::InfiniteFuture();
+  // Each world has its own seed, so that without a time limit the values do
+  // not depend on the number of threads.
+  const uint32_t seed = rng_();
+  std::vector<std::vector<double>> world_values(num_worlds_);
+  std::atomic<int> next_world{0};
+  auto solve_worlds = [&]() {
+    for (int i = next_world++; i < num_worlds_; i = next_world++) {
+      if (i > 0 && absl::Now() > deadline) break;
+      std::mt19937 rng(seed + i);
+      std::uniform_real_distribution<double> uniform(0.0, 1.0);
+      std::unique_ptr<State> world =
+          state.ResampleFromInfostate(player_id_, [&]() {
+            return uniform(rng);
+          });
+      world_values[i] = solver_(*world, rng());
+      SPIEL_CHECK_EQ(world_values[i].size(), num_actions);
+    }
+  };
+  const int num_threads = std::min(num_threads_, num_worlds_);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int t = 1; t < num_threads; ++t) threads.emplace_back(solve_worlds);
+  solve_worlds();
+  for (std::thread& thread : threads) thread.join();
+
+  std::vector<double> values(num_actions, 0);
+  num_worlds_solved_ = 0;
+  for (const std::vector<double>& world : world_values) {
+    if (world.empty()) continue;
+    ++num_worlds_solved_;
+    for (int a = 0; a < num_actions; ++a) values[a] += world[a];
+  }
+  for (double& value : values) value /= num_worlds_solved_;
+  return values;
+}
+
+std::unique_ptr<Bot> MakePIMCBot(const Game& game, Player player_id,
+                                 int num_worlds, double max_time_seconds,
+                                 int num_threads, int seed) {
+  return std::make_unique<PIMCBot>(game, player_id,
+                                   WorldSolverRegisterer::Get(game),
+                                   num_worlds, max_time_seconds, num_threads,
+                                   seed);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,116 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PIMC_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PIMC_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+
+// Perfect Information Monte Carlo search (PIMC), also called determinized
+// search.
+//
+// To choose a move, the bot samples worlds (full states) consistent with what
+// it has observed, with State::ResampleFromInfostate, solves each world as if
+// all information were public, and plays the action with the best value on
+// average over the worlds. The worlds are independent, so they are solved in
+// parallel.
+//
+// PIMC ignores that the players do not actually know the world (strategy
+// fusion) and cannot reason about hiding or gathering information, but it is
+// a strong baseline in trick-taking card games.
+//
+// Some references:
+// - Ginsberg, GIB: Imperfect Information in a Computationally Challenging
+//   Game, 2001. https://arxiv.org/abs/1106.0669
+// - Long, Sturtevant, Buro and Furtak, Understanding the Success of Perfect
+//   Information Monte Carlo Sampling in Game Tree Search, 2010.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Returns the value to the current player of `world` of each of its legal
+// actions, in the order of LegalActions(). `seed` seeds any randomness. Must
+// be safe to call from several threads at once.
+using WorldSolver =
+    std::function<std::vector<double>(const State& world, int seed)>;
+
+// A WorldSolver running MCTS with random rollouts in the world.
+WorldSolver MCTSWorldSolver(double uct_c = 2, int max_simulations = 1000,
+                            int num_rollouts = 1);
+
+// Games with a fast solver for their worlds register it under their short
+// name, next to the solver. PIMCBot uses it unless given another one.
+#define REGISTER_WORLD_SOLVER(short_name, solver) \
+  open_spiel::algorithms::WorldSolverRegisterer   \
+      CONCAT(world_solver, __COUNTER__)(short_name, solver);
+
+class WorldSolverRegisterer {
+ public:
+  WorldSolverRegisterer(const std::string& short_name, WorldSolver solver);
+
+  static bool IsRegistered(const std::string& short_name);
+  // The solver registered for the game, or MCTSWorldSolver() if none is.
+  static WorldSolver Get(const Game& game);
+
+ private:
+  static std::map<std::string, WorldSolver>& solvers() {
+    static std::map<std::string, WorldSolver> impl;
+    return impl;
+  }
+};
+
+class PIMCBot : public Bot {
+ public:
+  // Solves `num_worlds` worlds per move on `num_threads` threads, stopping
+  // early once `max_time_seconds` have passed if it is positive. At least one
+  // world is always solved.
+  PIMCBot(const Game& game, Player player_id, WorldSolver solver,
+          int num_worlds, double max_time_seconds, int num_threads, int seed);
+
+  Action Step(const State& state) override;
+
+  // The values of the legal actions of `state`, averaged over the worlds, in
+  // the order of LegalActions().
+  std::vector<double> ActionValues(const State& state);
+
+  // The number of worlds solved for the last move.
+  int num_worlds_solved() const { return num_worlds_solved_; }
+
+ private:
+  const Player player_id_;
+  const WorldSolver solver_;
+  const int num_worlds_;
+  const double max_time_seconds_;
+  const int num_threads_;
+  std::mt19937 rng_;
+  int num_worlds_solved_ = 0;
+};
+
+// A PIMCBot using the solver registered for the game.
+std::unique_ptr<Bot> MakePIMCBot(const Game& game, Player player_id,
+                                 int num_worlds, double max_time_seconds,
+                                 int num_threads, int seed);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PIMC_H_
@@ -0,0 +1,119 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/pimc.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/games/skat.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void PIMCCallsWithKingInKuhn() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  PIMCBot bot(*game, /*player_id=*/1, MCTSWorldSolver(), /*num_worlds=*/10,
+              /*max_time_seconds=*/0, /*num_threads=*/2, /*seed=*/1234);
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(0);  // Jack or Queen to player 0, it does not matter.
+  state->ApplyAction(2);  // King to player 1.
+  state->ApplyAction(1);  // Bet.
+  SPIEL_CHECK_EQ(bot.Step(*state), 1);
+  SPIEL_CHECK_EQ(bot.num_worlds_solved(), 10);
+}
+
+// A skat game in the middle of the card play.
+std::unique_ptr<State> SkatPlayState(const Game& game, int seed) {
+  std::mt19937 rng(seed);
+  std::unique_ptr<State> state = game.NewInitialState();
+  while (state->IsChanceNode()) {
+    const double z = std::uniform_real_distribution<double>()(rng);
+    state->ApplyAction(SampleAction(state->ChanceOutcomes(), z).first);
+  }
+  state->ApplyAction(skat::kBiddingActionBase + skat::kGrand);
+  // Discards, then two tricks and a card.
+  for (int i = 0; i < skat::kNumCardsInSkat + 7; ++i) {
+    const std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[rng() % actions.size()]);
+  }
+  return state;
+}
+
+void PIMCValuesDoNotDependOnThreads() {
+  std::shared_ptr<const Game> game = LoadGame("skat");
+  std::unique_ptr<State> state = SkatPlayState(*game, 7);
+  const Player player = state->CurrentPlayer();
+  PIMCBot one_thread(*game, player, WorldSolverRegisterer::Get(*game),
+                     /*num_worlds=*/8, /*max_time_seconds=*/0,
+                     /*num_threads=*/1, /*seed=*/42);
+  PIMCBot four_threads(*game, player, WorldSolverRegisterer::Get(*game),
+                       /*num_worlds=*/8, /*max_time_seconds=*/0,
+                       /*num_threads=*/4, /*seed=*/42);
+  const std::vector<double> values = one_thread.ActionValues(*state);
+  SPIEL_CHECK_EQ(values.size(), state->LegalActions().size());
+  SPIEL_CHECK_EQ(values, four_threads.ActionValues(*state));
+  for (double value : values) {
+    SPIEL_CHECK_GE(value, -1);
+    SPIEL_CHECK_LE(value, 1);
+  }
+}
+
+void PIMCStopsAtTimeLimit() {
+  std::shared_ptr<const Game> game = LoadGame("skat");
+  std::unique_ptr<State> state = SkatPlayState(*game, 11);
+  PIMCBot bot(*game, state->CurrentPlayer(), WorldSolverRegisterer::Get(*game),
+              /*num_worlds=*/1000, /*max_time_seconds=*/1e-6,
+              /*num_threads=*/2, /*seed=*/42);
+  bot.Step(*state);
+  SPIEL_CHECK_GE(bot.num_worlds_solved(), 1);
+  SPIEL_CHECK_LT(bot.num_worlds_solved(), 1000);
+}
+
+void PIMCBotsPlaySkat() {
+  SPIEL_CHECK_TRUE(WorldSolverRegisterer::IsRegistered("skat"));
+  std::shared_ptr<const Game> game = LoadGame("skat");
+  std::vector<std::unique_ptr<Bot>> bots;
+  for (Player p = 0; p < game->NumPlayers(); ++p) {
+    bots.push_back(MakePIMCBot(*game, p, /*num_worlds=*/4,
+                               /*max_time_seconds=*/0, /*num_threads=*/2,
+                               /*seed=*/p));
+  }
+  std::mt19937 rng(5);
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      const double z = std::uniform_real_distribution<double>()(rng);
+      state->ApplyAction(SampleAction(state->ChanceOutcomes(), z).first);
+    } else {
+      state->ApplyAction(bots[state->CurrentPlayer()]->Step(*state));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::PIMCCallsWithKingInKuhn();
+  open_spiel::algorithms::PIMCValuesDoNotDependOnThreads();
+  open_spiel::algorithms::PIMCStopsAtTimeLimit();
+  open_spiel::algorithms::PIMCBotsPlaySkat();
+}
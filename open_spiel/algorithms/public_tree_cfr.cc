@@ -0,0 +1,568 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/public_tree_cfr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Tolerance when checking that probabilities and payoffs which should be
+// identical across deals are.
+constexpr double kTolerance = 1e-9;
+
+bool ApproxEqual(double a, double b) {
+  return std::abs(a - b) <= kTolerance * std::max(1.0, std::abs(a));
+}
+
+uint64_t CardMask(Action card) {
+  SPIEL_CHECK_GE(card, 0);
+  SPIEL_CHECK_LT(card, 64);
+  return uint64_t{1} << card;
+}
+
+}  // namespace
+
+PokerDecompositionRegisterer::PokerDecompositionRegisterer(
+    const std::string& short_name, CreateFunc creator) {
+  factories()[short_name] = creator;
+}
+
+bool PokerDecompositionRegisterer::IsRegistered(const std::string& short_name) {
+  return factories().find(short_name) != factories().end();
+}
+
+PokerDecomposition PokerDecompositionRegisterer::Create(const Game& game) {
+  const std::string& short_name = game.GetType().short_name;
+  auto iter = factories().find(short_name);
+  if (iter == factories().end()) {
+    SpielFatalError(absl::StrCat("No poker decomposition registered for '",
+                                 short_name, "'."));
+  }
+  PokerDecomposition decomposition = iter->second(game);
+  SPIEL_CHECK_GE(decomposition.num_hole_cards, 1);
+  SPIEL_CHECK_TRUE(decomposition.hand_strength != nullptr);
+  return decomposition;
+}
+
+PublicTreeCFRSolverBase::PublicTreeCFRSolverBase(const Game& game,
+                                                 bool alternating_updates,
+                                                 bool linear_averaging,
+                                                 bool regret_matching_plus)
+    : decomposition_(PokerDecompositionRegisterer::Create(game)),
+      regret_matching_plus_(regret_matching_plus),
+      alternating_updates_(alternating_updates),
+      linear_averaging_(linear_averaging) {
+  if (game.NumPlayers() != 2 ||
+      game.GetType().utility != GameType::Utility::kZeroSum) {
+    SpielFatalError("Public-tree CFR requires two-player zero-sum games.");
+  }
+
+  std::unique_ptr<State> root = game.NewInitialState();
+  SPIEL_CHECK_TRUE(root->IsChanceNode());
+  std::vector<Action> cards;
+  for (const auto& outcome : root->ChanceOutcomes()) {
+    deck_ |= CardMask(outcome.first);
+    cards.push_back(outcome.first);
+  }
+
+  // All the private hands, as the card subsets of the right size.
+  const int k = decomposition_.num_hole_cards;
+  SPIEL_CHECK_LE(2 * k, cards.size());
+  std::function<void(int, int, uint64_t)> enumerate_hands =
+      [&](int first, int remaining, uint64_t hand) {
+        if (remaining == 0) {
+          hands_.push_back(hand);
+          return;
+        }
+        for (int i = first; i + remaining <= cards.size(); ++i) {
+          enumerate_hands(i + 1, remaining - 1, hand | CardMask(cards[i]));
+        }
+      };
+  enumerate_hands(0, k, 0);
+  std::sort(hands_.begin(), hands_.end());
+
+  // Non-empty card subsets of the hands, for inclusion-exclusion over the
+  // cards that two hands share.
+  subsets_per_hand_ = (1 << k) - 1;
+  std::unordered_map<uint64_t, int> subset_ids;
+  for (uint64_t hand : hands_) {
+    for (uint64_t subset = hand; subset != 0; subset = (subset - 1) & hand) {
+      auto inserted = subset_ids.emplace(subset, subset_ids.size());
+      hand_subsets_.push_back(inserted.first->second);
+      subset_signs_.push_back(__builtin_popcountll(subset) % 2 ? -1.0 : 1.0);
+    }
+  }
+  num_subsets_ = subset_ids.size();
+
+  std::map<std::pair<int, int>, double> deal_probs;
+  NewNode(/*board=*/0);
+  BuildTree(*root, 0, 0, 0, 1.0, &deal_probs);
+
+  // The solver factors the deal probability out of every terminal, so all
+  // compatible pairs of hands must be equally likely.
+  int num_compatible_pairs = 0;
+  for (uint64_t hand0 : hands_) {
+    for (uint64_t hand1 : hands_) {
+      num_compatible_pairs += (hand0 & hand1) == 0;
+    }
+  }
+  SPIEL_CHECK_EQ(deal_probs.size(), num_compatible_pairs);
+  deal_prob_ = deal_probs.begin()->second;
+  for (const auto& deal : deal_probs) {
+    if (!ApproxEqual(deal.second, deal_prob_)) {
+      SpielFatalError("Public-tree CFR requires uniformly dealt hands.");
+    }
+  }
+
+  FinalizeTree();
+}
+
+int PublicTreeCFRSolverBase::NewNode(uint64_t board) {
+  nodes_.emplace_back();
+  nodes_.back().board = board;
+  return nodes_.size() - 1;
+}
+
+int PublicTreeCFRSolverBase::HandIndex(uint64_t hole) const {
+  auto iter = std::lower_bound(hands_.begin(), hands_.end(), hole);
+  SPIEL_CHECK_TRUE(iter != hands_.end() && *iter == hole);
+  return iter - hands_.begin();
+}
+
+// Deals the private cards. Deals that only differ by the order of the cards
+// lead to the same public tree, so only the first one is walked.
+void PublicTreeCFRSolverBase::BuildTree(
+    const State& state, int num_dealt, uint64_t hole0, uint64_t hole1,
+    double deal_prob, std::map<std::pair<int, int>, double>* deal_probs) {
+  const int k = decomposition_.num_hole_cards;
+  if (num_dealt == 2 * k) {
+    const int hand0 = HandIndex(hole0);
+    const int hand1 = HandIndex(hole1);
+    auto inserted = deal_probs->emplace(std::make_pair(hand0, hand1), 0.0);
+    inserted.first->second += deal_prob;
+    if (inserted.second) AddDeal(state, 0, hand0, hand1);
+    return;
+  }
+
+  if (!state.IsChanceNode()) {
+    SpielFatalError("Public-tree CFR requires the private cards to be dealt "
+                    "before any other move.");
+  }
+  for (const auto& outcome : state.ChanceOutcomes()) {
+    const uint64_t card = CardMask(outcome.first);
+    BuildTree(*state.Child(outcome.first), num_dealt + 1,
+              num_dealt < k ? hole0 | card : hole0,
+              num_dealt < k ? hole1 : hole1 | card,
+              deal_prob * outcome.second, deal_probs);
+  }
+}
+
+// Walks the public tree for one deal, adding the nodes it has not seen yet
+// and checking that the ones it has are consistent with it.
+void PublicTreeCFRSolverBase::AddDeal(const State& state, int node, int hand0,
+                                      int hand1) {
+  const uint64_t board = nodes_[node].board;
+  const bool seen = nodes_[node].seen;
+  nodes_[node].seen = true;
+
+  if (state.IsTerminal()) {
+    if (!seen) nodes_[node].type = NodeType::kFold;
+    SPIEL_CHECK_TRUE(nodes_[node].type == NodeType::kFold);
+    const std::vector<double> returns = state.Returns();
+    SPIEL_CHECK_TRUE(ApproxEqual(returns[0], -returns[1]));
+
+    // The payoff is either the same for all deals (somebody folded), or a
+    // fixed amount won by the stronger hand (a showdown). Both are tracked
+    // until all the deals have been seen.
+    Node& terminal = nodes_[node];
+    const int strength0 = decomposition_.hand_strength(hands_[hand0], board);
+    const int strength1 = decomposition_.hand_strength(hands_[hand1], board);
+    const int sign = (strength0 > strength1) - (strength0 < strength1);
+    if (!seen) terminal.fold_payoff = returns[0];
+    terminal.constant_payoff &= ApproxEqual(returns[0], terminal.fold_payoff);
+    if (sign == 0) {
+      terminal.showdown_payoff &= returns[0] == 0;
+    } else if (terminal.payoff == 0) {
+      terminal.payoff = sign * returns[0];
+      terminal.showdown_payoff &= terminal.payoff > 0;
+    } else {
+      terminal.showdown_payoff &= ApproxEqual(sign * returns[0],
+                                              terminal.payoff);
+    }
+    return;
+  }
+
+  if (state.IsChanceNode()) {
+    if (!seen) nodes_[node].type = NodeType::kChance;
+    SPIEL_CHECK_TRUE(nodes_[node].type == NodeType::kChance);
+    const uint64_t expected =
+        deck_ & ~board & ~hands_[hand0] & ~hands_[hand1];
+    uint64_t dealt = 0;
+    for (const auto& outcome : state.ChanceOutcomes()) {
+      const uint64_t card = CardMask(outcome.first);
+      dealt |= card;
+      const std::vector<Action>& actions = nodes_[node].actions;
+      const int index = std::find(actions.begin(), actions.end(),
+                                  outcome.first) - actions.begin();
+      if (index == actions.size()) {
+        const int child = NewNode(board | card);
+        nodes_[node].actions.push_back(outcome.first);
+        nodes_[node].children.push_back(child);
+        nodes_[node].chance_probs.push_back(outcome.second);
+      } else if (!ApproxEqual(nodes_[node].chance_probs[index],
+                              outcome.second)) {
+        SpielFatalError("Public-tree CFR requires public cards to be dealt "
+                        "uniformly.");
+      }
+      AddDeal(*state.Child(outcome.first), nodes_[node].children[index],
+              hand0, hand1);
+    }
+    if (dealt != expected) {
+      SpielFatalError("Public-tree CFR requires public cards to be dealt from "
+                      "the cards not held by the players.");
+    }
+    return;
+  }
+
+  const Player player = state.CurrentPlayer();
+  const std::vector<Action> legal_actions = state.LegalActions();
+  if (!seen) {
+    nodes_[node].type = NodeType::kDecision;
+    nodes_[node].player = player;
+    nodes_[node].actions = legal_actions;
+    nodes_[node].info_states.resize(hands_.size());
+    for (int i = 0; i < legal_actions.size(); ++i) {
+      const int child = NewNode(board);
+      nodes_[node].children.push_back(child);
+    }
+  }
+  if (nodes_[node].type != NodeType::kDecision ||
+      nodes_[node].player != player ||
+      nodes_[node].actions != legal_actions) {
+    SpielFatalError("Public-tree CFR requires the moves after the deal to "
+                    "not depend on the private cards.");
+  }
+  std::string& info_state =
+      nodes_[node].info_states[player == 0 ? hand0 : hand1];
+  if (info_state.empty()) info_state = state.InformationStateString(player);
+  for (int i = 0; i < legal_actions.size(); ++i) {
+    AddDeal(*state.Child(legal_actions[i]), nodes_[node].children[i], hand0,
+            hand1);
+  }
+}
+
+void PublicTreeCFRSolverBase::FinalizeTree() {
+  int size = 0;
+  for (Node& node : nodes_) {
+    if (node.type == NodeType::kDecision) {
+      node.offset = size;
+      size += hands_.size() * node.actions.size();
+    } else if (node.type == NodeType::kFold && !node.constant_payoff) {
+      if (!node.showdown_payoff) {
+        SpielFatalError("Public-tree CFR found a terminal that is neither a "
+                        "fold nor a showdown.");
+      }
+      node.type = NodeType::kShowdown;
+      auto inserted = ranking_index_.emplace(node.board, rankings_.size());
+      if (inserted.second) {
+        Ranking ranking;
+        std::vector<std::pair<int, int>> strengths;
+        for (int hand = 0; hand < hands_.size(); ++hand) {
+          if (hands_[hand] & node.board) continue;
+          strengths.push_back(
+              {decomposition_.hand_strength(hands_[hand], node.board), hand});
+        }
+        std::sort(strengths.begin(), strengths.end());
+        for (const auto& strength : strengths) {
+          ranking.strengths.push_back(strength.first);
+          ranking.hands.push_back(strength.second);
+        }
+        rankings_.push_back(std::move(ranking));
+      }
+      node.ranking = inserted.first->second;
+    } else if (node.type == NodeType::kFold) {
+      node.payoff = node.fold_payoff;
+    }
+  }
+
+  cumulative_regrets_.assign(size, 0.0);
+  cumulative_policy_.assign(size, 0.0);
+  current_policy_.resize(size);
+  for (const Node& node : nodes_) {
+    if (node.type != NodeType::kDecision) continue;
+    std::fill(current_policy_.begin() + node.offset,
+              current_policy_.begin() + node.offset +
+                  hands_.size() * node.actions.size(),
+              1.0 / node.actions.size());
+  }
+}
+
+void PublicTreeCFRSolverBase::EvaluateAndUpdatePolicy() {
+  ++iteration_;
+  const std::vector<double> root_reach(hands_.size(), 1.0);
+  if (alternating_updates_) {
+    for (Player player = 0; player < 2; ++player) {
+      Traverse(0, player, root_reach, root_reach, 1.0);
+      ApplyRegretMatching(player);
+    }
+  } else {
+    // Both traversals use the current policy of the previous iteration.
+    for (Player player = 0; player < 2; ++player) {
+      Traverse(0, player, root_reach, root_reach, 1.0);
+    }
+    for (Player player = 0; player < 2; ++player) {
+      ApplyRegretMatching(player);
+    }
+  }
+}
+
+std::vector<double> PublicTreeCFRSolverBase::Traverse(
+    int node_index, Player player, const std::vector<double>& own_reach,
+    const std::vector<double>& opp_reach, double chance_reach) {
+  const Node& node = nodes_[node_index];
+  const int num_hands = hands_.size();
+  std::vector<double> values(num_hands, 0.0);
+
+  switch (node.type) {
+    case NodeType::kFold:
+      EvaluateFold(node, player, opp_reach, chance_reach * deal_prob_,
+                   &values);
+      return values;
+
+    case NodeType::kShowdown:
+      EvaluateShowdown(node, opp_reach, chance_reach * deal_prob_, &values);
+      return values;
+
+    case NodeType::kChance: {
+      std::vector<double> child_own_reach(num_hands);
+      std::vector<double> child_opp_reach(num_hands);
+      for (int i = 0; i < node.actions.size(); ++i) {
+        const uint64_t card = CardMask(node.actions[i]);
+        for (int hand = 0; hand < num_hands; ++hand) {
+          const bool blocked = hands_[hand] & card;
+          child_own_reach[hand] = blocked ? 0.0 : own_reach[hand];
+          child_opp_reach[hand] = blocked ? 0.0 : opp_reach[hand];
+        }
+        const std::vector<double> child_values =
+            Traverse(node.children[i], player, child_own_reach,
+                     child_opp_reach, chance_reach * node.chance_probs[i]);
+        for (int hand = 0; hand < num_hands; ++hand) {
+          if (!(hands_[hand] & card)) values[hand] += child_values[hand];
+        }
+      }
+      return values;
+    }
+
+    case NodeType::kDecision:
+      break;
+  }
+
+  const int num_actions = node.actions.size();
+  const double* policy = &current_policy_[node.offset];
+  std::vector<double> child_reach(num_hands);
+
+  if (node.player != player) {
+    for (int a = 0; a < num_actions; ++a) {
+      for (int hand = 0; hand < num_hands; ++hand) {
+        child_reach[hand] = opp_reach[hand] * policy[hand * num_actions + a];
+      }
+      const std::vector<double> child_values = Traverse(
+          node.children[a], player, own_reach, child_reach, chance_reach);
+      for (int hand = 0; hand < num_hands; ++hand) {
+        values[hand] += child_values[hand];
+      }
+    }
+    return values;
+  }
+
+  std::vector<double> action_values(num_hands * num_actions);
+  for (int a = 0; a < num_actions; ++a) {
+    for (int hand = 0; hand < num_hands; ++hand) {
+      child_reach[hand] = own_reach[hand] * policy[hand * num_actions + a];
+    }
+    const std::vector<double> child_values = Traverse(
+        node.children[a], player, child_reach, opp_reach, chance_reach);
+    for (int hand = 0; hand < num_hands; ++hand) {
+      action_values[hand * num_actions + a] = child_values[hand];
+      values[hand] += policy[hand * num_actions + a] * child_values[hand];
+    }
+  }
+
+  // Perform regret and average strategy updates.
+  const double weight = linear_averaging_ ? iteration_ : 1.0;
+  for (int hand = 0; hand < num_hands; ++hand) {
+    for (int a = 0; a < num_actions; ++a) {
+      const int index = hand * num_actions + a;
+      cumulative_regrets_[node.offset + index] +=
+          action_values[index] - values[hand];
+      cumulative_policy_[node.offset + index] +=
+          weight * own_reach[hand] * policy[index];
+    }
+  }
+  return values;
+}
+
+double PublicTreeCFRSolverBase::DisjointReach(
+    int hand, double total, const std::vector<double>& subset_sums) const {
+  const int begin = hand * subsets_per_hand_;
+  for (int i = begin; i < begin + subsets_per_hand_; ++i) {
+    total += subset_signs_[i] * subset_sums[hand_subsets_[i]];
+  }
+  return total;
+}
+
+void PublicTreeCFRSolverBase::AddSubsetReach(
+    int hand, double reach, std::vector<double>* subset_sums) const {
+  const int begin = hand * subsets_per_hand_;
+  for (int i = begin; i < begin + subsets_per_hand_; ++i) {
+    (*subset_sums)[hand_subsets_[i]] += reach;
+  }
+}
+
+void PublicTreeCFRSolverBase::EvaluateFold(
+    const Node& node, Player player, const std::vector<double>& opp_reach,
+    double weight, std::vector<double>* values) const {
+  double total = 0;
+  std::vector<double> subset_sums(num_subsets_, 0.0);
+  for (int hand = 0; hand < hands_.size(); ++hand) {
+    if (opp_reach[hand] == 0) continue;
+    total += opp_reach[hand];
+    AddSubsetReach(hand, opp_reach[hand], &subset_sums);
+  }
+  const double payoff = (player == 0 ? 1 : -1) * node.payoff * weight;
+  for (int hand = 0; hand < hands_.size(); ++hand) {
+    (*values)[hand] = payoff * DisjointReach(hand, total, subset_sums);
+  }
+}
+
+// Sweeps the hands by increasing strength to sum the opponent reach of the
+// weaker hands, then by decreasing strength for the stronger ones. Hands of
+// equal strength are scored before being added, so that ties count for
+// neither.
+void PublicTreeCFRSolverBase::EvaluateShowdown(
+    const Node& node, const std::vector<double>& opp_reach, double weight,
+    std::vector<double>* values) const {
+  const Ranking& ranking = rankings_[node.ranking];
+  const int num_ranked = ranking.hands.size();
+
+  double total = 0;
+  std::vector<double> subset_sums(num_subsets_, 0.0);
+  for (int begin = 0; begin < num_ranked;) {
+    int end = begin;
+    while (end < num_ranked &&
+           ranking.strengths[end] == ranking.strengths[begin]) {
+      ++end;
+    }
+    for (int i = begin; i < end; ++i) {
+      const int hand = ranking.hands[i];
+      (*values)[hand] = DisjointReach(hand, total, subset_sums);
+    }
+    for (int i = begin; i < end; ++i) {
+      const int hand = ranking.hands[i];
+      total += opp_reach[hand];
+      AddSubsetReach(hand, opp_reach[hand], &subset_sums);
+    }
+    begin = end;
+  }
+
+  total = 0;
+  std::fill(subset_sums.begin(), subset_sums.end(), 0.0);
+  for (int end = num_ranked; end > 0;) {
+    int begin = end;
+    while (begin > 0 &&
+           ranking.strengths[begin - 1] == ranking.strengths[end - 1]) {
+      --begin;
+    }
+    for (int i = begin; i < end; ++i) {
+      const int hand = ranking.hands[i];
+      (*values)[hand] -= DisjointReach(hand, total, subset_sums);
+      (*values)[hand] *= node.payoff * weight;
+    }
+    for (int i = begin; i < end; ++i) {
+      const int hand = ranking.hands[i];
+      total += opp_reach[hand];
+      AddSubsetReach(hand, opp_reach[hand], &subset_sums);
+    }
+    end = begin;
+  }
+}
+
+void PublicTreeCFRSolverBase::ApplyRegretMatching(Player player) {
+  for (const Node& node : nodes_) {
+    if (node.type != NodeType::kDecision || node.player != player) continue;
+    const int num_actions = node.actions.size();
+    for (int hand = 0; hand < hands_.size(); ++hand) {
+      double* regrets = &cumulative_regrets_[node.offset + hand * num_actions];
+      double* policy = &current_policy_[node.offset + hand * num_actions];
+      double sum_positive_regrets = 0.0;
+      for (int a = 0; a < num_actions; ++a) {
+        if (regret_matching_plus_ && regrets[a] < 0) regrets[a] = 0;
+        if (regrets[a] > 0) sum_positive_regrets += regrets[a];
+      }
+      for (int a = 0; a < num_actions; ++a) {
+        if (sum_positive_regrets > 0) {
+          policy[a] = regrets[a] > 0 ? regrets[a] / sum_positive_regrets : 0;
+        } else {
+          policy[a] = 1.0 / num_actions;
+        }
+      }
+    }
+  }
+}
+
+TabularPolicy PublicTreeCFRSolverBase::PolicyFromTable(
+    const std::vector<double>& table, bool normalize) const {
+  std::unordered_map<std::string, ActionsAndProbs> policy_table;
+  for (const Node& node : nodes_) {
+    if (node.type != NodeType::kDecision) continue;
+    const int num_actions = node.actions.size();
+    for (int hand = 0; hand < hands_.size(); ++hand) {
+      if (node.info_states[hand].empty()) continue;
+      const double* values = &table[node.offset + hand * num_actions];
+      double sum = 0.0;
+      for (int a = 0; a < num_actions; ++a) sum += values[a];
+      ActionsAndProbs& actions_and_probs =
+          policy_table[node.info_states[hand]];
+      for (int a = 0; a < num_actions; ++a) {
+        double prob = values[a];
+        if (normalize) {
+          prob = sum == 0.0 ? 1.0 / num_actions : values[a] / sum;
+        }
+        actions_and_probs.push_back({node.actions[a], prob});
+      }
+    }
+  }
+  return TabularPolicy(policy_table);
+}
+
+TabularPolicy PublicTreeCFRSolverBase::AveragePolicy() const {
+  return PolicyFromTable(cumulative_policy_, /*normalize=*/true);
+}
+
+TabularPolicy PublicTreeCFRSolverBase::CurrentPolicy() const {
+  return PolicyFromTable(current_policy_, /*normalize=*/false);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,213 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PUBLIC_TREE_CFR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PUBLIC_TREE_CFR_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// CFR over the public tree of a two-player poker game.
+//
+// CFRSolver walks every history, so the betting tree below the deal is
+// traversed once per combination of private cards. Here the game is first
+// flattened into its public tree (the betting actions and public cards), and
+// every public node carries vectors over private hands: the reach of each
+// hand for both players on the way down, and the counterfactual value of
+// each hand on the way up. Fold payoffs do not depend on the hands, and
+// showdowns are evaluated in O(n log n) by sorting the hands by strength, so
+// an iteration costs O(public nodes * hands) instead of O(histories).
+//
+// The updates are the ones of CFRSolverBase, so both produce the same
+// policies up to floating point rounding.
+
+namespace open_spiel {
+namespace algorithms {
+
+// How a poker game splits into private and public information. The game must
+// deal `num_hole_cards` private cards to player 0, then as many to player 1,
+// before any other move, and every later move must be public. Chance
+// outcomes are cards, with ids below 64.
+struct PokerDecomposition {
+  int num_hole_cards = 1;
+
+  // The showdown strength of a hand given the public cards; higher is
+  // better. Both are sets of cards, as bitmasks with bit c set for card c.
+  // It is called at every terminal, including those reached before some or
+  // all of the public cards are dealt, so the board may be empty.
+  std::function<int(uint64_t hole, uint64_t board)> hand_strength;
+};
+
+// Games opt in by registering a decomposition under their short name, next
+// to their REGISTER_SPIEL_GAME. The factory may reject parameters that break
+// the assumptions above.
+#define REGISTER_POKER_DECOMPOSITION(short_name, factory) \
+  open_spiel::algorithms::PokerDecompositionRegisterer    \
+      CONCAT(poker_decomposition, __COUNTER__)(short_name, factory);
+
+class PokerDecompositionRegisterer {
+ public:
+  using CreateFunc = std::function<PokerDecomposition(const Game& game)>;
+
+  PokerDecompositionRegisterer(const std::string& short_name,
+                               CreateFunc creator);
+
+  static bool IsRegistered(const std::string& short_name);
+  static PokerDecomposition Create(const Game& game);
+
+ private:
+  static std::map<std::string, CreateFunc>& factories() {
+    static std::map<std::string, CreateFunc> impl;
+    return impl;
+  }
+};
+
+class PublicTreeCFRSolverBase {
+ public:
+  PublicTreeCFRSolverBase(const Game& game, bool alternating_updates,
+                          bool linear_averaging, bool regret_matching_plus);
+
+  // Performs one step of the CFR algorithm.
+  void EvaluateAndUpdatePolicy();
+
+  // The average and current policies of both players, keyed by the
+  // information state strings of the game.
+  TabularPolicy AveragePolicy() const;
+  TabularPolicy CurrentPolicy() const;
+
+  int NumPublicNodes() const { return nodes_.size(); }
+  int NumHands() const { return hands_.size(); }
+
+ private:
+  enum class NodeType { kDecision, kChance, kFold, kShowdown };
+
+  struct Node {
+    NodeType type;
+    Player player = kInvalidPlayer;
+    uint64_t board = 0;
+    // Legal actions of a decision node, or cards of a chance node, with the
+    // matching children and, for chance nodes, probabilities.
+    std::vector<Action> actions;
+    std::vector<int> children;
+    std::vector<double> chance_probs;
+    // Decision nodes: where the regrets and policies of the acting player's
+    // hands start, hand-major, and the information state of each hand (empty
+    // for hands that cannot reach the node).
+    int offset = 0;
+    std::vector<std::string> info_states;
+    // Terminals: player 0's payoff when the opponent folded, or the amount
+    // won at a showdown; and for showdowns, an index into rankings_.
+    double payoff = 0;
+    int ranking = -1;
+    // Build-time bookkeeping, to tell folds from showdowns.
+    bool seen = false;
+    double fold_payoff = 0;
+    bool constant_payoff = true;
+    bool showdown_payoff = true;
+  };
+
+  // The hands that can go to showdown on some board, sorted by increasing
+  // strength, with their strengths.
+  struct Ranking {
+    std::vector<int> hands;
+    std::vector<int> strengths;
+  };
+
+  void BuildTree(const State& state, int num_dealt, uint64_t hole0,
+                 uint64_t hole1, double deal_prob,
+                 std::map<std::pair<int, int>, double>* deal_probs);
+  void AddDeal(const State& state, int node, int hand0, int hand1);
+  int NewNode(uint64_t board);
+  void FinalizeTree();
+
+  int HandIndex(uint64_t hole) const;
+
+  // Returns the counterfactual values of `player`'s hands at `node`.
+  std::vector<double> Traverse(int node, Player player,
+                               const std::vector<double>& own_reach,
+                               const std::vector<double>& opp_reach,
+                               double chance_reach);
+  void EvaluateFold(const Node& node, Player player,
+                    const std::vector<double>& opp_reach, double weight,
+                    std::vector<double>* values) const;
+  void EvaluateShowdown(const Node& node, const std::vector<double>& opp_reach,
+                        double weight, std::vector<double>* values) const;
+  // Sum of `opp_reach` over the hands that share no card with `hand`, given
+  // the total and the sums over the hands containing each card subset.
+  double DisjointReach(int hand, double total,
+                       const std::vector<double>& subset_sums) const;
+  void AddSubsetReach(int hand, double reach,
+                      std::vector<double>* subset_sums) const;
+
+  void ApplyRegretMatching(Player player);
+  TabularPolicy PolicyFromTable(const std::vector<double>& table,
+                                bool normalize) const;
+
+  const PokerDecomposition decomposition_;
+  const bool regret_matching_plus_;
+  const bool alternating_updates_;
+  const bool linear_averaging_;
+  int iteration_ = 0;
+
+  // All private hands, as bitmasks of cards, sorted.
+  std::vector<uint64_t> hands_;
+  uint64_t deck_ = 0;
+  // Probability of each compatible pair of private hands.
+  double deal_prob_ = 0;
+  // For each hand, the ids of its non-empty card subsets and the
+  // inclusion-exclusion sign of each.
+  int subsets_per_hand_ = 0;
+  int num_subsets_ = 0;
+  std::vector<int> hand_subsets_;
+  std::vector<double> subset_signs_;
+
+  std::vector<Node> nodes_;
+  std::vector<Ranking> rankings_;
+  std::map<uint64_t, int> ranking_index_;
+
+  // Per decision node and hand, hand-major.
+  std::vector<double> cumulative_regrets_;
+  std::vector<double> cumulative_policy_;
+  std::vector<double> current_policy_;
+};
+
+class PublicTreeCFRSolver : public PublicTreeCFRSolverBase {
+ public:
+  explicit PublicTreeCFRSolver(const Game& game)
+      : PublicTreeCFRSolverBase(game,
+                                /*alternating_updates=*/true,
+                                /*linear_averaging=*/false,
+                                /*regret_matching_plus=*/false) {}
+};
+
+class PublicTreeCFRPlusSolver : public PublicTreeCFRSolverBase {
+ public:
+  explicit PublicTreeCFRPlusSolver(const Game& game)
+      : PublicTreeCFRSolverBase(game,
+                                /*alternating_updates=*/true,
+                                /*linear_averaging=*/true,
+                                /*regret_matching_plus=*/true) {}
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PUBLIC_TREE_CFR_H_
@@ -0,0 +1,104 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/public_tree_cfr.h"
+
+#include <memory>
+#include <string>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Both solvers perform the same updates, so their policies must agree on
+// every information state.
+void CheckSamePolicies(const TabularPolicy& policy, const Policy& expected,
+                       int expected_num_info_states) {
+  SPIEL_CHECK_EQ(policy.PolicyTable().size(), expected_num_info_states);
+  for (const auto& entry : policy.PolicyTable()) {
+    const ActionsAndProbs expected_probs = expected.GetStatePolicy(entry.first);
+    SPIEL_CHECK_EQ(entry.second.size(), expected_probs.size());
+    for (int i = 0; i < expected_probs.size(); ++i) {
+      SPIEL_CHECK_EQ(entry.second[i].first, expected_probs[i].first);
+      SPIEL_CHECK_FLOAT_NEAR(entry.second[i].second, expected_probs[i].second,
+                             1e-9);
+    }
+  }
+}
+
+void MatchesCFRSolver(const std::string& game_name, int num_iterations,
+                      bool alternating_updates, bool linear_averaging,
+                      bool regret_matching_plus) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  CFRSolverBase solver(*game, alternating_updates, linear_averaging,
+                       regret_matching_plus);
+  PublicTreeCFRSolverBase public_solver(*game, alternating_updates,
+                                       linear_averaging, regret_matching_plus);
+  const int num_info_states = TabularPolicy(*game).PolicyTable().size();
+  for (int i = 0; i < num_iterations; ++i) {
+    solver.EvaluateAndUpdatePolicy();
+    public_solver.EvaluateAndUpdatePolicy();
+  }
+  CheckSamePolicies(public_solver.AveragePolicy(), *solver.AveragePolicy(),
+                    num_info_states);
+  CheckSamePolicies(public_solver.CurrentPolicy(), *solver.CurrentPolicy(),
+                    num_info_states);
+}
+
+void PublicTreeMatchesCFRSolver() {
+  for (const std::string game_name : {"kuhn_poker", "leduc_poker"}) {
+    MatchesCFRSolver(game_name, 20, /*alternating_updates=*/true,
+                     /*linear_averaging=*/false,
+                     /*regret_matching_plus=*/false);
+    MatchesCFRSolver(game_name, 20, /*alternating_updates=*/false,
+                     /*linear_averaging=*/false,
+                     /*regret_matching_plus=*/false);
+    MatchesCFRSolver(game_name, 20, /*alternating_updates=*/true,
+                     /*linear_averaging=*/true,
+                     /*regret_matching_plus=*/true);
+  }
+}
+
+void PublicTreeBuildsSmallTree() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  PublicTreeCFRSolver solver(*game);
+  SPIEL_CHECK_EQ(solver.NumHands(), 6);
+  // One public tree instead of the 30 deals of the game tree.
+  SPIEL_CHECK_LT(solver.NumPublicNodes(), 1000);
+}
+
+void PublicTreeCFRPlusSolvesLeduc() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  PublicTreeCFRPlusSolver solver(*game);
+  for (int i = 0; i < 200; ++i) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, solver.AveragePolicy()), 0.01);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::PublicTreeMatchesCFRSolver();
+  open_spiel::algorithms::PublicTreeBuildsSmallTree();
+  open_spiel::algorithms::PublicTreeCFRPlusSolvesLeduc();
+}
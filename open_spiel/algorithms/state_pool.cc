@@ -0,0 +1,50 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/state_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+std::unique_ptr<State> StatePool::Clone(const State& state) {
+  while (!free_states_.empty()) {
+    std::unique_ptr<State> recycled = std::move(free_states_.back());
+    free_states_.pop_back();
+    if (state.CloneInto(recycled.get())) return recycled;
+    // The game does not support CloneInto, or the released state was of
+    // another game: the pooled states are of no use.
+    free_states_.clear();
+  }
+  return state.Clone();
+}
+
+std::unique_ptr<State> StatePool::Child(const State& state, Action action) {
+  std::unique_ptr<State> child = Clone(state);
+  child->ApplyAction(action);
+  return child;
+}
+
+void StatePool::Release(std::unique_ptr<State> state) {
+  if (state != nullptr && free_states_.size() < max_size_) {
+    free_states_.push_back(std::move(state));
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,66 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_STATE_POOL_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_STATE_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// Recycles state objects for algorithms that clone a state, play it forward
+// and throw it away many times, such as rollouts and tree search. States
+// handed back with Release are overwritten in place by later calls to Clone
+// (see State::CloneInto), so that a steady-state search does no heap
+// allocation for its working states.
+//
+// For games that do not implement CloneInto, this falls back to State::Clone.
+// A pool is not thread-safe; use one per thread.
+//
+//   StatePool pool;
+//   for (...) {
+//     std::unique_ptr<State> working_state = pool.Clone(state);
+//     ...
+//     pool.Release(std::move(working_state));
+//   }
+class StatePool {
+ public:
+  // At most `max_size` released states are kept.
+  explicit StatePool(int max_size = 64) : max_size_(max_size) {}
+
+  // Returns a copy of `state`, reusing a released state when possible.
+  std::unique_ptr<State> Clone(const State& state);
+
+  // Returns a copy of `state` with `action` applied, like State::Child.
+  std::unique_ptr<State> Child(const State& state, Action action);
+
+  // Hands back a state that is no longer needed. It may be of any game.
+  void Release(std::unique_ptr<State> state);
+
+  // The number of released states currently held.
+  int size() const { return free_states_.size(); }
+
+ private:
+  int max_size_;
+  std::vector<std::unique_ptr<State>> free_states_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_STATE_POOL_H_
@@ -0,0 +1,75 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/state_pool.h"
+
+#include <memory>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void StatePoolReusesStates() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(4);
+
+  StatePool pool;
+  std::unique_ptr<State> child = pool.Child(*state, 0);
+  SPIEL_CHECK_EQ(child->History(), std::vector<Action>({4, 0}));
+  const State* address = child.get();
+  pool.Release(std::move(child));
+  SPIEL_CHECK_EQ(pool.size(), 1);
+
+  std::unique_ptr<State> copy = pool.Clone(*state);
+  SPIEL_CHECK_EQ(copy.get(), address);
+  SPIEL_CHECK_EQ(pool.size(), 0);
+  SPIEL_CHECK_EQ(copy->ToString(), state->ToString());
+  SPIEL_CHECK_EQ(copy->History(), state->History());
+}
+
+void StatePoolHandlesOtherGames() {
+  std::shared_ptr<const Game> tic_tac_toe = LoadGame("tic_tac_toe");
+  std::shared_ptr<const Game> kuhn = LoadGame("kuhn_poker");
+  StatePool pool;
+  pool.Release(tic_tac_toe->NewInitialState());
+  std::unique_ptr<State> state = kuhn->NewInitialState();
+  std::unique_ptr<State> copy = pool.Clone(*state);
+  SPIEL_CHECK_EQ(copy->ToString(), state->ToString());
+  SPIEL_CHECK_EQ(copy->GetGame(), kuhn);
+  SPIEL_CHECK_EQ(pool.size(), 0);
+}
+
+void StatePoolFallsBackToClone() {
+  // Goofspiel does not implement CloneInto.
+  std::shared_ptr<const Game> game = LoadGame("goofspiel");
+  StatePool pool;
+  std::unique_ptr<State> state = game->NewInitialState();
+  pool.Release(state->Clone());
+  std::unique_ptr<State> copy = pool.Clone(*state);
+  SPIEL_CHECK_EQ(copy->ToString(), state->ToString());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::StatePoolReusesStates();
+  open_spiel::algorithms::StatePoolHandlesOtherGames();
+  open_spiel::algorithms::StatePoolFallsBackToClone();
+}
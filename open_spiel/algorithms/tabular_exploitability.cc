@@ -54,7 +54,8 @@ double Exploitability(
   return Exploitability(game, tabular_policy);
 }
 
-double NashConv(const Game& game, const Policy& policy) {
+double NashConv(const Game& game, const Policy& policy,
+                bool use_state_get_policy) {
   GameType game_type = game.GetType();
   if (game_type.dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
@@ -66,7 +67,8 @@ double NashConv(const Game& game, const Policy& policy) {
     TabularBestResponse best_response(game, p, &policy);
     best_response_values[p] = best_response.Value(root->ToString());
   }
-  std::vector<double> on_policy_values = ExpectedReturns(*root, policy, -1);
+  std::vector<double> on_policy_values =
+      ExpectedReturns(*root, policy, -1, !use_state_get_policy);
   SPIEL_CHECK_EQ(best_response_values.size(), on_policy_values.size());
   double nash_conv = 0;
   for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
@@ -46,7 +46,10 @@ double Exploitability(
 // maintains their current strategy (which for a Nash equilibrium, this value
 // is 0). This function only works for sequential games. Note: in zero-sum and
 // constant-sum games, exploitability is equal to NashConv / (num. of players).
-double NashConv(const Game& game, const Policy& policy);
+// Set `use_state_get_policy` for policies that only implement
+// GetStatePolicy(const State&), such as CFRFingerprintAveragePolicy.
+double NashConv(const Game& game, const Policy& policy,
+                bool use_state_get_policy = false);
 
 // Same function provided for easy Python compatibility.
 double NashConv(const Game& game,
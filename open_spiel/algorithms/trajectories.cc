@@ -18,10 +18,13 @@
 #include <chrono>  // NOLINT
 #include <cstdint>
 #include <random>
+#include <thread>  // NOLINT
+#include <utility>
 #include <unordered_map>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -232,5 +235,115 @@ BatchedTrajectory RecordTrajectory(
                           include_full_observations, rng_ptr);
 }
 
+FlatTrajectoryRecorder::FlatTrajectoryRecorder(
+    std::shared_ptr<const Game> game, int seed, int num_threads,
+    bool use_observation, int max_length)
+    : game_(std::move(game)),
+      rng_(seed),
+      num_threads_(num_threads),
+      use_observation_(use_observation),
+      max_length_(max_length > 0 ? max_length : game_->MaxGameLength()) {
+  SPIEL_CHECK_GT(num_threads_, 0);
+  if (game_->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("FlatTrajectoryRecorder requires a sequential game.");
+  }
+  if (use_observation_) {
+    SPIEL_CHECK_TRUE(game_->GetType().provides_observation_tensor);
+  } else {
+    SPIEL_CHECK_TRUE(game_->GetType().provides_information_state_tensor);
+  }
+}
+
+void FlatTrajectoryRecorder::RecordBatch(
+    const std::vector<const Policy*>& policies, int batch_size,
+    FlatTrajectoryBatch* batch) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_EQ(policies.size(), game_->NumPlayers());
+  batch->batch_size = batch_size;
+  batch->max_length = max_length_;
+  batch->tensor_size = use_observation_ ? game_->ObservationTensorSize()
+                                        : game_->InformationStateTensorSize();
+  batch->num_actions = game_->NumDistinctActions();
+  batch->num_players = game_->NumPlayers();
+  const int64_t steps = static_cast<int64_t>(batch_size) * max_length_;
+  // assign() keeps the capacity, so recording batches of the same shape does
+  // not allocate.
+  batch->observations.assign(steps * batch->tensor_size, 0);
+  batch->legal_mask.assign(steps * batch->num_actions, 0);
+  batch->policies.assign(steps * batch->num_actions, 0);
+  batch->actions.assign(steps, 0);
+  batch->player_ids.assign(steps, 0);
+  batch->valid.assign(steps, 0);
+  batch->next_is_terminal.assign(steps, 0);
+  batch->rewards.assign(batch_size * batch->num_players, 0);
+  batch->lengths.assign(batch_size, 0);
+
+  std::vector<uint32_t> seeds(batch_size);
+  for (uint32_t& seed : seeds) seed = rng_();
+
+  // Episodes are dealt to the threads round-robin. They write to disjoint
+  // rows of the buffers.
+  const int num_threads = std::min(num_threads_, batch_size);
+  auto record_episodes = [&](int first) {
+    for (int b = first; b < batch_size; b += num_threads) {
+      RecordEpisode(policies, b, seeds[b], batch);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int t = 1; t < num_threads; ++t) threads.emplace_back(record_episodes, t);
+  record_episodes(0);
+  for (std::thread& thread : threads) thread.join();
+}
+
+void FlatTrajectoryRecorder::RecordEpisode(
+    const std::vector<const Policy*>& policies, int index, uint32_t seed,
+    FlatTrajectoryBatch* batch) const {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  const int tensor_size = batch->tensor_size;
+  const int num_actions = batch->num_actions;
+  std::unique_ptr<State> state = game_->NewInitialState();
+  int t = 0;
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(SampleAction(state->ChanceOutcomes(), uniform(rng))
+                             .first);
+      continue;
+    }
+    if (t == max_length_) {
+      SpielFatalError(absl::StrCat("Episode is longer than max_length ",
+                                   max_length_, "."));
+    }
+    const int64_t step = static_cast<int64_t>(index) * max_length_ + t;
+    const Player player = state->CurrentPlayer();
+    absl::Span<float> observation(
+        &batch->observations[step * tensor_size], tensor_size);
+    if (use_observation_) {
+      state->ObservationTensor(player, observation);
+    } else {
+      state->InformationStateTensor(player, observation);
+    }
+    state->LegalActionsMask(
+        player, absl::Span<uint8_t>(&batch->legal_mask[step * num_actions],
+                                    num_actions));
+    ActionsAndProbs policy = policies[player]->GetStatePolicy(*state);
+    for (const auto& [action, prob] : policy) {
+      batch->policies[step * num_actions + action] = prob;
+    }
+    const Action action = SampleAction(policy, uniform(rng)).first;
+    batch->actions[step] = action;
+    batch->player_ids[step] = player;
+    batch->valid[step] = 1;
+    state->ApplyAction(action);
+    ++t;
+  }
+  batch->lengths[index] = t;
+  if (t > 0) batch->next_is_terminal[index * max_length_ + t - 1] = 1;
+  std::vector<double> returns = state->Returns();
+  std::copy(returns.begin(), returns.end(),
+            batch->rewards.begin() + index * batch->num_players);
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -15,7 +15,9 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORIES_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORIES_H_
 
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <random>
 #include <unordered_map>
 #include <vector>
@@ -137,6 +139,80 @@ class TrajectoryRecorder {
   std::mt19937 rng_;
 };
 
+// A batch of trajectories in flat, row-major buffers of fixed shape, so that
+// they can be handed to a learner (or exposed to numpy) without reshaping:
+//   observations      [B, T, tensor_size]
+//   legal_mask        [B, T, num_distinct_actions]
+//   policies          [B, T, num_distinct_actions]
+//   actions           [B, T]
+//   player_ids        [B, T]
+//   valid             [B, T]  1 for steps that were played, 0 for padding
+//   next_is_terminal  [B, T]  1 for the last step of each episode
+//   rewards           [B, num_players]  the returns at the end of the episode
+//   lengths           [B]
+// Only decision nodes are recorded. Padding steps are all zeros.
+struct FlatTrajectoryBatch {
+  int batch_size = 0;
+  int max_length = 0;
+  int tensor_size = 0;
+  int num_actions = 0;
+  int num_players = 0;
+
+  std::vector<float> observations;
+  std::vector<uint8_t> legal_mask;
+  std::vector<float> policies;
+  std::vector<int64_t> actions;
+  std::vector<int> player_ids;
+  std::vector<uint8_t> valid;
+  std::vector<uint8_t> next_is_terminal;
+  std::vector<double> rewards;
+  std::vector<int> lengths;
+};
+
+// Records batches of episodes straight into a FlatTrajectoryBatch, playing
+// the episodes in parallel on `num_threads` threads. Each player acts
+// according to its Policy, queried with GetStatePolicy(const State&), and
+// the policies must therefore be safe to call from several threads at once,
+// which is the case for the policies in policy.h.
+//
+// Every episode draws its randomness from its own seed, taken from the
+// recorder's generator before the batch is played, so the recorded batch
+// does not depend on the number of threads.
+class FlatTrajectoryRecorder {
+ public:
+  // If use_observation is true, observations hold ObservationTensor,
+  // otherwise InformationStateTensor. Episodes longer than `max_length`
+  // decision steps are a fatal error; by default it is the game's
+  // MaxGameLength.
+  FlatTrajectoryRecorder(std::shared_ptr<const Game> game, int seed,
+                         int num_threads = 1, bool use_observation = false,
+                         int max_length = -1);
+
+  // Plays `batch_size` episodes and writes them to `batch`, whose buffers
+  // are only reallocated when the shape changes. Pointers into them are
+  // therefore invalidated by a batch of another shape.
+  void RecordBatch(const std::vector<const Policy*>& policies, int batch_size,
+                   FlatTrajectoryBatch* batch);
+
+  FlatTrajectoryBatch RecordBatch(const std::vector<const Policy*>& policies,
+                                  int batch_size) {
+    FlatTrajectoryBatch batch;
+    RecordBatch(policies, batch_size, &batch);
+    return batch;
+  }
+
+ private:
+  // Plays episode `index` of `batch`, seeding its generator with `seed`.
+  void RecordEpisode(const std::vector<const Policy*>& policies, int index,
+                     uint32_t seed, FlatTrajectoryBatch* batch) const;
+
+  std::shared_ptr<const Game> game_;
+  std::mt19937 rng_;
+  const int num_threads_;
+  const bool use_observation_;
+  const int max_length_;
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
@@ -253,6 +253,53 @@ void BatchedTrajectoryResizesCorrectly(const std::string& game_name) {
   }
 }
 
+void FlatTrajectoryIsConsistent(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  TabularPolicy policy = GetUniformPolicy(*game);
+  FlatTrajectoryRecorder recorder(game, /*seed=*/0, /*num_threads=*/4);
+  FlatTrajectoryBatch batch = recorder.RecordBatch(
+      std::vector<const Policy*>(game->NumPlayers(), &policy), kBatchSize);
+  SPIEL_CHECK_EQ(batch.max_length, game->MaxGameLength());
+  SPIEL_CHECK_EQ(batch.actions.size(), kBatchSize * batch.max_length);
+  SPIEL_CHECK_EQ(batch.observations.size(),
+                 batch.actions.size() * game->InformationStateTensorSize());
+  for (int b = 0; b < kBatchSize; ++b) {
+    const int length = batch.lengths[b];
+    SPIEL_CHECK_GT(length, 0);
+    double reward_sum = 0;
+    for (Player p = 0; p < game->NumPlayers(); ++p) {
+      reward_sum += batch.rewards[b * game->NumPlayers() + p];
+    }
+    SPIEL_CHECK_FLOAT_EQ(reward_sum, 0);
+    for (int t = 0; t < batch.max_length; ++t) {
+      const int step = b * batch.max_length + t;
+      SPIEL_CHECK_EQ(batch.valid[step], t < length);
+      SPIEL_CHECK_EQ(batch.next_is_terminal[step], t == length - 1);
+      if (t >= length) continue;
+      const Action action = batch.actions[step];
+      SPIEL_CHECK_EQ(batch.legal_mask[step * batch.num_actions + action], 1);
+      SPIEL_CHECK_GT(batch.policies[step * batch.num_actions + action], 0);
+    }
+  }
+}
+
+void FlatTrajectoryDoesNotDependOnThreads(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  TabularPolicy policy = GetUniformPolicy(*game);
+  std::vector<const Policy*> policies(game->NumPlayers(), &policy);
+  FlatTrajectoryRecorder serial(game, /*seed=*/7, /*num_threads=*/1);
+  FlatTrajectoryRecorder parallel(game, /*seed=*/7, /*num_threads=*/3);
+  FlatTrajectoryBatch expected;
+  FlatTrajectoryBatch actual;
+  for (int i = 0; i < 2; ++i) {
+    serial.RecordBatch(policies, kBatchSize, &expected);
+    parallel.RecordBatch(policies, kBatchSize, &actual);
+    SPIEL_CHECK_EQ(expected.actions, actual.actions);
+    SPIEL_CHECK_EQ(expected.observations, actual.observations);
+    SPIEL_CHECK_EQ(expected.rewards, actual.rewards);
+  }
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -276,5 +323,7 @@ int main() {
     alg::RecordBatchedTrajectoryPlayerIdsIsCorrect(game_name);
     alg::RecordBatchedTrajectoryNextIsTerminalIsCorrect(game_name);
     alg::BatchedTrajectoryResizesCorrectly(game_name);
+    alg::FlatTrajectoryIsConsistent(game_name);
+    alg::FlatTrajectoryDoesNotDependOnThreads(game_name);
   }
 }
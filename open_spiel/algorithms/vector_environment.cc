@@ -0,0 +1,124 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/vector_environment.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+VectorEnvironment::VectorEnvironment(std::shared_ptr<const Game> game,
+                                     int num_envs, int seed,
+                                     bool use_observation)
+    : game_(game),
+      num_envs_(num_envs),
+      use_observation_(use_observation),
+      tensor_size_(use_observation ? game->ObservationTensorSize()
+                                   : game->InformationStateTensorSize()),
+      num_actions_(game->NumDistinctActions()),
+      num_players_(game->NumPlayers()),
+      rng_(seed) {
+  SPIEL_CHECK_GT(num_envs, 0);
+  if (game->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("VectorEnvironment only supports sequential games.");
+  }
+  states_.resize(num_envs_);
+  last_returns_.resize(num_envs_ * num_players_, 0);
+  observations_.resize(num_envs_ * tensor_size_, 0);
+  legal_mask_.resize(num_envs_ * num_actions_, 0);
+  current_player_.resize(num_envs_, kInvalidPlayer);
+  rewards_.resize(num_envs_ * num_players_, 0);
+  dones_.resize(num_envs_, 0);
+  Reset();
+}
+
+void VectorEnvironment::Reset() {
+  for (int env = 0; env < num_envs_; ++env) {
+    ResetEnv(env);
+    WriteEnv(env);
+  }
+  std::fill(rewards_.begin(), rewards_.end(), 0);
+  std::fill(dones_.begin(), dones_.end(), 0);
+}
+
+void VectorEnvironment::Step(const Action* actions) {
+  for (int env = 0; env < num_envs_; ++env) {
+    State* state = states_[env].get();
+    state->ApplyAction(actions[env]);
+    ResolveChance(env);
+
+    std::vector<double> returns = state->Returns();
+    double* rewards = &rewards_[env * num_players_];
+    double* last_returns = &last_returns_[env * num_players_];
+    for (Player p = 0; p < num_players_; ++p) {
+      rewards[p] = returns[p] - last_returns[p];
+      last_returns[p] = returns[p];
+    }
+
+    dones_[env] = state->IsTerminal();
+    if (dones_[env]) {
+      ++num_episodes_;
+      ResetEnv(env);
+    }
+    WriteEnv(env);
+  }
+}
+
+void VectorEnvironment::ResetEnv(int env) {
+  states_[env] = game_->NewInitialState();
+  ResolveChance(env);
+  // Games with a single chance node and no decisions would never yield an
+  // observation.
+  SPIEL_CHECK_FALSE(states_[env]->IsTerminal());
+  std::vector<double> returns = states_[env]->Returns();
+  std::copy(returns.begin(), returns.end(),
+            last_returns_.begin() + env * num_players_);
+}
+
+void VectorEnvironment::ResolveChance(int env) {
+  State* state = states_[env].get();
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  while (state->IsChanceNode()) {
+    state->ApplyAction(SampleAction(state->ChanceOutcomes(), dist(rng_)).first);
+  }
+}
+
+void VectorEnvironment::WriteEnv(int env) {
+  const State& state = *states_[env];
+  Player player = state.CurrentPlayer();
+  current_player_[env] = player;
+
+  absl::Span<float> tensor =
+      absl::MakeSpan(observations_).subspan(env * tensor_size_, tensor_size_);
+  if (use_observation_) {
+    state.ObservationTensor(player, tensor);
+  } else {
+    state.InformationStateTensor(player, tensor);
+  }
+
+  absl::Span<uint8_t> mask =
+      absl::MakeSpan(legal_mask_).subspan(env * num_actions_, num_actions_);
+  state.LegalActionsMask(player, mask);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,106 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_ENVIRONMENT_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_ENVIRONMENT_H_
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A batch of independent episodes of a sequential game, stepped together. This
+// is the C++ counterpart of python/rl_environment.py for training loops where
+// stepping one state at a time from Python is the bottleneck.
+//
+// Each environment always sits at a decision node: chance nodes are sampled
+// internally and finished episodes are restarted automatically. After every
+// call to Reset or Step, the per-environment results are available in flat
+// row-major buffers that are allocated once and never reallocated, so they can
+// be exposed to Python without copies:
+//   observations   [num_envs, tensor_size]  for the player to move
+//   legal_mask     [num_envs, num_distinct_actions]
+//   current_player [num_envs]
+//   rewards        [num_envs, num_players]  accumulated over the last step
+//   dones          [num_envs]  1 if the last step finished an episode
+//
+// When an episode finishes, its rewards include the terminal rewards and the
+// observation, mask and player already belong to the next episode.
+class VectorEnvironment {
+ public:
+  // If use_observation is true, the buffers hold ObservationTensor, otherwise
+  // InformationStateTensor.
+  VectorEnvironment(std::shared_ptr<const Game> game, int num_envs, int seed,
+                    bool use_observation = false);
+
+  // Starts a new episode in every environment.
+  void Reset();
+
+  // Applies actions[i] to environment i. Actions must be legal.
+  void Step(const std::vector<Action>& actions) { Step(actions.data()); }
+  void Step(const Action* actions);
+
+  int NumEnvs() const { return num_envs_; }
+  int TensorSize() const { return tensor_size_; }
+  int NumDistinctActions() const { return num_actions_; }
+  int NumPlayers() const { return num_players_; }
+  const State& GetState(int env) const { return *states_[env]; }
+
+  const std::vector<float>& Observations() const { return observations_; }
+  const std::vector<uint8_t>& LegalMask() const { return legal_mask_; }
+  const std::vector<int>& CurrentPlayers() const { return current_player_; }
+  const std::vector<double>& Rewards() const { return rewards_; }
+  const std::vector<int>& Dones() const { return dones_; }
+
+  // Number of episodes finished since construction.
+  int64_t NumEpisodes() const { return num_episodes_; }
+
+ private:
+  // Restarts environment `env` and moves it to its first decision node.
+  void ResetEnv(int env);
+  // Samples chance outcomes until `env` is at a decision or terminal node.
+  void ResolveChance(int env);
+  // Writes the observation, mask and current player of `env`.
+  void WriteEnv(int env);
+
+  std::shared_ptr<const Game> game_;
+  const int num_envs_;
+  const bool use_observation_;
+  const int tensor_size_;
+  const int num_actions_;
+  const int num_players_;
+  std::mt19937 rng_;
+  int64_t num_episodes_ = 0;
+
+  std::vector<std::unique_ptr<State>> states_;
+  // Returns of each state at the start of the current step.
+  std::vector<double> last_returns_;
+
+  std::vector<float> observations_;
+  std::vector<uint8_t> legal_mask_;
+  std::vector<int> current_player_;
+  std::vector<double> rewards_;
+  std::vector<int> dones_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_ENVIRONMENT_H_
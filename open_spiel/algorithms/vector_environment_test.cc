@@ -0,0 +1,109 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/vector_environment.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr int kNumEnvs = 16;
+
+// Picks a uniformly random legal action for each environment from its mask.
+std::vector<Action> RandomActions(const VectorEnvironment& env,
+                                  std::mt19937* rng) {
+  std::vector<Action> actions(env.NumEnvs());
+  for (int i = 0; i < env.NumEnvs(); ++i) {
+    std::vector<Action> legal;
+    for (Action a = 0; a < env.NumDistinctActions(); ++a) {
+      if (env.LegalMask()[i * env.NumDistinctActions() + a]) legal.push_back(a);
+    }
+    SPIEL_CHECK_FALSE(legal.empty());
+    std::uniform_int_distribution<int> dist(0, legal.size() - 1);
+    actions[i] = legal[dist(*rng)];
+  }
+  return actions;
+}
+
+// Playing the first legal action, X wins tic-tac-toe on the anti-diagonal on
+// the 7th move, and every environment restarts in lockstep.
+void TicTacToeFirstActionTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  VectorEnvironment env(game, kNumEnvs, /*seed=*/0, /*use_observation=*/true);
+  for (int episode = 0; episode < 3; ++episode) {
+    for (int move = 0; move < 7; ++move) {
+      std::vector<Action> actions(kNumEnvs);
+      for (int i = 0; i < kNumEnvs; ++i) {
+        SPIEL_CHECK_EQ(env.CurrentPlayers()[i], move % 2);
+        const uint8_t* mask = &env.LegalMask()[i * env.NumDistinctActions()];
+        actions[i] = std::find(mask, mask + env.NumDistinctActions(), 1) - mask;
+      }
+      env.Step(actions);
+      for (int i = 0; i < kNumEnvs; ++i) {
+        SPIEL_CHECK_EQ(env.Dones()[i], move == 6);
+        SPIEL_CHECK_EQ(env.Rewards()[i * 2], move == 6 ? 1 : 0);
+        SPIEL_CHECK_EQ(env.Rewards()[i * 2 + 1], move == 6 ? -1 : 0);
+      }
+    }
+  }
+  SPIEL_CHECK_EQ(env.NumEpisodes(), 3 * kNumEnvs);
+}
+
+// The buffers must always match the underlying states, chance nodes must be
+// resolved, and the rewards of each episode must add up to its returns.
+void RandomPlayConsistencyTest(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  VectorEnvironment env(game, kNumEnvs, /*seed=*/1234);
+  std::mt19937 rng(42);
+  int num_players = env.NumPlayers();
+  std::vector<double> episode_sum(kNumEnvs, 0);
+  for (int step = 0; step < 200; ++step) {
+    env.Step(RandomActions(env, &rng));
+    for (int i = 0; i < kNumEnvs; ++i) {
+      const double* rewards = &env.Rewards()[i * num_players];
+      episode_sum[i] += std::accumulate(rewards, rewards + num_players, 0.0);
+      if (env.Dones()[i]) {
+        SPIEL_CHECK_FLOAT_EQ(episode_sum[i], game->UtilitySum());
+        episode_sum[i] = 0;
+      }
+      const State& state = env.GetState(i);
+      SPIEL_CHECK_FALSE(state.IsChanceNode());
+      SPIEL_CHECK_FALSE(state.IsTerminal());
+      SPIEL_CHECK_EQ(env.CurrentPlayers()[i], state.CurrentPlayer());
+      std::vector<double> tensor = state.InformationStateTensor();
+      SPIEL_CHECK_TRUE(std::equal(
+          tensor.begin(), tensor.end(),
+          env.Observations().begin() + i * env.TensorSize()));
+    }
+  }
+  SPIEL_CHECK_GT(env.NumEpisodes(), 0);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::TicTacToeFirstActionTest();
+  open_spiel::algorithms::RandomPlayConsistencyTest("kuhn_poker");
+  open_spiel::algorithms::RandomPlayConsistencyTest("leduc_poker");
+}
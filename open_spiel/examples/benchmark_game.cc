@@ -37,16 +37,20 @@ int RandomSimulation(std::mt19937* rng, const Game& game, bool verbose) {
               << state->ToString() << std::endl;
   }
 
-  std::vector<double> obs;
   bool provides_info_state = game.GetType().provides_information_state_tensor;
   bool provides_observations = game.GetType().provides_observation_tensor;
+  std::vector<float> obs(provides_observations ? game.ObservationTensorSize()
+                         : provides_info_state
+                             ? game.InformationStateTensorSize()
+                             : 0);
 
   int game_length = 0;
   while (!state->IsTerminal()) {
     if (provides_observations && state->CurrentPlayer() >= 0) {
-      state->ObservationTensor(state->CurrentPlayer(), &obs);
+      state->ObservationTensor(state->CurrentPlayer(), absl::MakeSpan(obs));
     } else if (provides_info_state && state->CurrentPlayer() >= 0) {
-      state->InformationStateTensor(state->CurrentPlayer(), &obs);
+      state->InformationStateTensor(state->CurrentPlayer(),
+                                    absl::MakeSpan(obs));
     }
     ++game_length;
     if (state->IsChanceNode()) {
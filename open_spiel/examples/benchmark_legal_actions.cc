@@ -0,0 +1,98 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/spiel.h"
+
+ABSL_FLAG(std::string, game, "backgammon", "The name of the game to use.");
+ABSL_FLAG(int, positions, 1000, "How many random positions to sample.");
+ABSL_FLAG(int, calls, 100, "How many LegalActions calls per position.");
+ABSL_FLAG(int, attempts, 5, "How many times to run the benchmark.");
+
+namespace open_spiel {
+
+// Samples decision states by playing uniformly random games. Each state
+// visited has the same probability of being kept.
+std::vector<std::unique_ptr<State>> SampleDecisionStates(std::mt19937* rng,
+                                                         const Game& game,
+                                                         int num_states) {
+  std::vector<std::unique_ptr<State>> states;
+  std::uniform_real_distribution<double> keep_dist(0.0, 1.0);
+  while (states.size() < num_states) {
+    std::unique_ptr<State> state = game.NewInitialState();
+    while (!state->IsTerminal() && states.size() < num_states) {
+      if (state->IsChanceNode()) {
+        state->ApplyAction(
+            SampleAction(state->ChanceOutcomes(), keep_dist(*rng)).first);
+        continue;
+      }
+      SPIEL_CHECK_FALSE(state->IsSimultaneousNode());
+      std::vector<Action> actions = state->LegalActions();
+      if (keep_dist(*rng) < 0.1) states.push_back(state->Clone());
+      std::uniform_int_distribution<int> dis(0, actions.size() - 1);
+      state->ApplyAction(actions[dis(*rng)]);
+    }
+  }
+  return states;
+}
+
+// Times repeated LegalActions calls on random positions of a sequential game.
+void LegalActionsBenchmark(const std::string& game_def, int num_positions,
+                           int num_calls, std::mt19937* rng) {
+  std::cout << absl::StrFormat(
+      "Benchmark: game: %s, positions: %d, calls per position: %d. ",
+      game_def, num_positions, num_calls);
+
+  auto game = LoadGame(game_def);
+  std::vector<std::unique_ptr<State>> states =
+      SampleDecisionStates(rng, *game, num_positions);
+
+  absl::Time start = absl::Now();
+  int64_t num_actions = 0;
+  for (const auto& state : states) {
+    for (int i = 0; i < num_calls; ++i) {
+      num_actions += state->LegalActions().size();
+    }
+  }
+  absl::Time end = absl::Now();
+  double seconds = absl::ToDoubleSeconds(end - start);
+  double total_calls = static_cast<double>(num_positions) * num_calls;
+
+  std::cout << absl::StrFormat(
+                   "Finished %.0f calls in %.1f ms: %.1f calls/s, "
+                   "%.1f actions/call",
+                   total_calls, seconds * 1000, total_calls / seconds,
+                   num_actions / total_calls)
+            << std::endl;
+}
+
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+
+  std::mt19937 rng;
+  for (int i = 0; i < absl::GetFlag(FLAGS_attempts); ++i) {
+    open_spiel::LegalActionsBenchmark(
+        absl::GetFlag(FLAGS_game), absl::GetFlag(FLAGS_positions),
+        absl::GetFlag(FLAGS_calls), &rng);
+  }
+}
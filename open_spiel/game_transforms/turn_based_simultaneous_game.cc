@@ -169,33 +169,23 @@ std::string TurnBasedSimultaneousState::InformationStateString(
 }
 
 void TurnBasedSimultaneousState::InformationStateTensor(
-    Player player, std::vector<double>* values) const {
+    Player player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->clear();
-  values->reserve(game_->InformationStateTensorSize());
+  int offset = 0;
 
   // First, get the 2 * num_players bits to encode whose turn it is and who
   // the observer is.
   for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == current_player_ ? 1 : 0);
+    values[offset++] = p == current_player_ ? 1 : 0;
   }
   for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == player ? 1 : 0);
+    values[offset++] = p == player ? 1 : 0;
   }
 
-  // Then get the underlying info set
-  std::vector<double> infoset;
-  state_->InformationStateTensor(player, &infoset);
-
-  int offset = values->size();
-  values->resize(values->size() + infoset.size());
-
-  // Now copy it over.
-  for (int i = 0; i < infoset.size(); i++) {
-    (*values)[offset + i] = infoset[i];
-  }
+  // Then write the underlying info set into the rest of the buffer.
+  state_->InformationStateTensor(player, values.subspan(offset));
 }
 
 std::string TurnBasedSimultaneousState::ObservationString(Player player) const {
@@ -218,33 +208,23 @@ std::string TurnBasedSimultaneousState::ObservationString(Player player) const {
 }
 
 void TurnBasedSimultaneousState::ObservationTensor(
-    Player player, std::vector<double>* values) const {
+    Player player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->clear();
-  values->reserve(game_->ObservationTensorSize());
+  int offset = 0;
 
   // First, get the 2 * num_players bits to encode whose turn it is and who
   // the observer is.
   for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == current_player_ ? 1 : 0);
+    values[offset++] = p == current_player_ ? 1 : 0;
   }
   for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == player ? 1 : 0);
+    values[offset++] = p == player ? 1 : 0;
   }
 
-  // Then get the underlying observation
-  std::vector<double> observation;
-  state_->ObservationTensor(player, &observation);
-
-  int offset = values->size();
-  values->resize(values->size() + observation.size());
-
-  // Now copy it over.
-  for (int i = 0; i < observation.size(); i++) {
-    (*values)[offset + i] = observation[i];
-  }
+  // Then write the underlying observation into the rest of the buffer.
+  state_->ObservationTensor(player, values.subspan(offset));
 }
 
 TurnBasedSimultaneousState::TurnBasedSimultaneousState(
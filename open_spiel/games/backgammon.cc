@@ -15,8 +15,10 @@
 #include "open_spiel/games/backgammon.h"
 
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <cstdlib>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -24,6 +26,7 @@
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/varint.h"
 
 namespace open_spiel {
 namespace backgammon {
@@ -260,36 +263,35 @@ std::string BackgammonState::ObservationString(Player player) const {
 }
 
 void BackgammonState::ObservationTensor(Player player,
-                                        std::vector<double>* values) const {
+                                        absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LE(player, 1);
   int opponent = Opponent(player);
-  values->clear();
-  values->reserve(game_->ObservationTensorSize());
+  int offset = 0;
   // The format of this vector is described in Section 3.4 of "G. Tesauro,
   // Practical issues in temporal-difference learning, 1994."
   // https://link.springer.com/article/10.1007/BF00992697
   for (int count : board_[player]) {
-    values->push_back((count == 1) ? 1 : 0);
-    values->push_back((count == 2) ? 1 : 0);
-    values->push_back((count == 3) ? 1 : 0);
-    values->push_back((count > 3) ? (count - 3) : 0);
+    values[offset++] = (count == 1) ? 1 : 0;
+    values[offset++] = (count == 2) ? 1 : 0;
+    values[offset++] = (count == 3) ? 1 : 0;
+    values[offset++] = (count > 3) ? (count - 3) : 0;
   }
   for (int count : board_[opponent]) {
-    values->push_back((count == 1) ? 1 : 0);
-    values->push_back((count == 2) ? 1 : 0);
-    values->push_back((count == 3) ? 1 : 0);
-    values->push_back((count > 3) ? (count - 3) : 0);
+    values[offset++] = (count == 1) ? 1 : 0;
+    values[offset++] = (count == 2) ? 1 : 0;
+    values[offset++] = (count == 3) ? 1 : 0;
+    values[offset++] = (count > 3) ? (count - 3) : 0;
   }
-  values->push_back(bar_[player]);
-  values->push_back(scores_[player]);
-  values->push_back((cur_player_ == player) ? 1 : 0);
+  values[offset++] = bar_[player];
+  values[offset++] = scores_[player];
+  values[offset++] = (cur_player_ == player) ? 1 : 0;
 
-  values->push_back(bar_[opponent]);
-  values->push_back(scores_[opponent]);
-  values->push_back((cur_player_ == opponent) ? 1 : 0);
+  values[offset++] = bar_[opponent];
+  values[offset++] = scores_[opponent];
+  values[offset++] = (cur_player_ == opponent) ? 1 : 0;
 
-  SPIEL_CHECK_EQ(kStateEncodingSize, values->size());
+  SPIEL_CHECK_EQ(offset, kStateEncodingSize);
 }
 
 BackgammonState::BackgammonState(std::shared_ptr<const Game> game,
@@ -320,6 +322,59 @@ BackgammonState::BackgammonState(std::shared_ptr<const Game> game,
   board_[kOPlayerId][5] = 5;
 }
 
+BackgammonState::BackgammonState(std::shared_ptr<const Game> game,
+                                 ScoringType scoring_type,
+                                 absl::string_view snapshot)
+    : BackgammonState(game, scoring_type) {
+  // The fields are read in the order SerializeSnapshot writes them.
+  auto read_int = [&snapshot]() {
+    return static_cast<int>(ReadSignedVarint(&snapshot));
+  };
+  // Sizes are bounded by the bytes left, as each element takes at least one.
+  auto read_size = [&snapshot]() {
+    const uint64_t size = ReadVarint(&snapshot);
+    SPIEL_CHECK_LE(size, snapshot.size());
+    return static_cast<int>(size);
+  };
+  auto read_ints = [&read_size, &read_int](std::vector<int>* values) {
+    values->resize(read_size());
+    for (int& value : *values) value = read_int();
+  };
+  history_.resize(read_size());
+  for (Action& action : history_) action = ReadSignedVarint(&snapshot);
+  cur_player_ = read_int();
+  prev_player_ = read_int();
+  turns_ = read_int();
+  x_turns_ = read_int();
+  o_turns_ = read_int();
+  double_turn_ = read_int();
+  read_ints(&dice_);
+  read_ints(&bar_);
+  SPIEL_CHECK_EQ(bar_.size(), kNumPlayers);
+  read_ints(&scores_);
+  SPIEL_CHECK_EQ(scores_.size(), kNumPlayers);
+  for (std::vector<int>& points : board_) {
+    read_ints(&points);
+    SPIEL_CHECK_EQ(points.size(), kNumPoints);
+  }
+  const int num_turns = read_size();
+  turn_history_info_.clear();
+  turn_history_info_.reserve(num_turns);
+  for (int i = 0; i < num_turns; ++i) {
+    const int player = read_int();
+    const int prev_player = read_int();
+    std::vector<int> dice;
+    read_ints(&dice);
+    const Action action = ReadSignedVarint(&snapshot);
+    const int flags = read_int();
+    turn_history_info_.emplace_back(player, prev_player, dice, action,
+                                    flags & 1, flags & 2, flags & 4);
+  }
+  SPIEL_CHECK_TRUE(snapshot.empty());
+  SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
+  SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
+}
+
 int BackgammonState::board(int player, int pos) const {
   if (pos == kBarPos) {
     return bar_[player];
@@ -522,31 +577,34 @@ Action BackgammonState::EncodedPassMove() const { return 25; }
 Action BackgammonState::CheckerMovesToSpielMove(
     const std::vector<CheckerMove>& moves) const {
   SPIEL_CHECK_LE(moves.size(), 2);
+  return CheckerMovesToSpielMove(
+      moves.empty() ? CheckerMove() : moves[0],
+      moves.size() > 1 ? moves[1] : CheckerMove());
+}
+
+Action BackgammonState::CheckerMovesToSpielMove(
+    const CheckerMove& first, const CheckerMove& second) const {
   int dig0 = EncodedPassMove();
   int dig1 = EncodedPassMove();
   bool high_roll_first = false;
   int high_roll = DiceValue(0) >= DiceValue(1) ? DiceValue(0) : DiceValue(1);
 
-  if (!moves.empty()) {
-    int pos1 = moves[0].pos;
-    if (pos1 == kBarPos) {
-      pos1 = EncodedBarMove();
-    }
-    if (pos1 != kPassPos) {
-      int num1 = moves[0].num;
-      dig0 = pos1;
-      high_roll_first = num1 == high_roll;
-    }
+  int pos1 = first.pos;
+  if (pos1 == kBarPos) {
+    pos1 = EncodedBarMove();
+  }
+  if (pos1 != kPassPos) {
+    int num1 = first.num;
+    dig0 = pos1;
+    high_roll_first = num1 == high_roll;
   }
 
-  if (moves.size() > 1) {
-    int pos2 = moves[1].pos;
-    if (pos2 == kBarPos) {
-      pos2 = EncodedBarMove();
-    }
-    if (pos2 != kPassPos) {
-      dig1 = pos2;
-    }
+  int pos2 = second.pos;
+  if (pos2 == kBarPos) {
+    pos2 = EncodedBarMove();
+  }
+  if (pos2 != kPassPos) {
+    dig1 = pos2;
   }
 
   Action move = dig1 * 26 + dig0;
@@ -615,29 +673,6 @@ int BackgammonState::CheckersInHome(int player) const {
   return c;
 }
 
-bool BackgammonState::AllInHome(int player) const {
-  if (bar_[player] > 0) {
-    return false;
-  }
-
-  SPIEL_CHECK_GE(player, 0);
-  SPIEL_CHECK_LE(player, 1);
-
-  // Looking for any checkers outside home.
-  // --> XPlayer scans 0-17.
-  // --> OPlayer scans 6-23.
-  int scan_start = (player == kXPlayerId ? 0 : 6);
-  int scan_end = (player == kXPlayerId ? 17 : 23);
-
-  for (int i = scan_start; i <= scan_end; ++i) {
-    if (board_[player][i] > 0) {
-      return false;
-    }
-  }
-
-  return true;
-}
-
 int BackgammonState::HighestUsableDiceOutcome() const {
   if (UsableDiceOutcome(dice_[1])) {
     return dice_[1];
@@ -648,29 +683,6 @@ int BackgammonState::HighestUsableDiceOutcome() const {
   }
 }
 
-int BackgammonState::FurthestCheckerInHome(int player) const {
-  // Looking for any checkers in home.
-  // --> XPlayer scans 23 -> 18
-  // --> OPlayer scans  0 -> 5
-  int scan_start = (player == kXPlayerId ? 23 : 0);
-  int scan_end = (player == kXPlayerId ? 17 : 6);
-  int inc = (player == kXPlayerId ? -1 : 1);
-
-  int furthest = (player == kXPlayerId ? 24 : -1);
-
-  for (int i = scan_start; i != scan_end; i += inc) {
-    if (board_[player][i] > 0) {
-      furthest = i;
-    }
-  }
-
-  if (furthest == 24 || furthest == -1) {
-    return -1;
-  } else {
-    return furthest;
-  }
-}
-
 bool BackgammonState::UsableDiceOutcome(int outcome) const {
   return (outcome >= 1 && outcome <= 6);
 }
@@ -857,56 +869,113 @@ int BackgammonState::IsBackgammoned(int player) const {
   return false;
 }
 
-std::set<CheckerMove> BackgammonState::LegalCheckerMoves(int player) const {
-  std::set<CheckerMove> moves;
+struct BackgammonState::MovePosition {
+  std::array<std::array<int, kNumPoints>, kNumPlayers> board;
+  std::array<int, kNumPlayers> bar;
+  std::array<int, kNumPlayers> scores;
+  std::array<int, 2> dice;
+};
 
-  if (bar_[player] > 0) {
+int BackgammonState::LegalCheckerMoves(const MovePosition& position,
+                                       int player, CheckerMove* moves) const {
+  const std::array<int, kNumPoints>& my_board = position.board[player];
+  const std::array<int, kNumPoints>& opp_board =
+      position.board[Opponent(player)];
+  int num_moves = 0;
+
+  // With doubles both dice allow the same moves, so only one is considered.
+  int num_dice = (position.dice[0] == position.dice[1] ? 1 : 2);
+
+  if (position.bar[player] > 0) {
     // If there are any checkers are the bar, must move them out first.
-    for (int outcome : dice_) {
+    for (int d = 0; d < num_dice; ++d) {
+      int outcome = position.dice[d];
       if (UsableDiceOutcome(outcome)) {
         int pos = PositionFromBar(player, outcome);
-        if (NumOppCheckers(player, pos) <= 1) {
-          bool hit = NumOppCheckers(player, pos) == 1;
-          moves.insert(CheckerMove(kBarPos, outcome, hit));
+        if (opp_board[pos] <= 1) {
+          bool hit = opp_board[pos] == 1;
+          moves[num_moves++] = CheckerMove(kBarPos, outcome, hit);
         }
       }
     }
-    return moves;
+    return num_moves;
+  }
+
+  // Looking for any checkers outside home, and for the furthest one at home.
+  // --> XPlayer is home on 18-23, and 18 is the furthest point.
+  // --> OPlayer is home on 0-5, and 5 is the furthest point.
+  bool all_in_home = true;
+  int furthest_in_home = -1;
+  for (int i = 0; i < kNumPoints; ++i) {
+    int pos = (player == kXPlayerId ? i : kNumPoints - 1 - i);
+    if (my_board[pos] == 0) continue;
+    if (i < 18) {
+      all_in_home = false;
+      break;
+    }
+    if (furthest_in_home == -1) furthest_in_home = pos;
   }
 
   // Regular board moves.
-  bool all_in_home = AllInHome(player);
   for (int i = 0; i < kNumPoints; ++i) {
-    if (board_[player][i] > 0) {
-      for (int outcome : dice_) {
-        if (UsableDiceOutcome(outcome)) {
-          int pos = PositionFrom(player, i, outcome);
-          if (pos == kScorePos && all_in_home) {
-            // Check whether a bear off move is legal.
-
-            // It is ok to bear off if all the checkers are at home and the
-            // point being used to move from exactly matches the distance from
-            // just stepping off the board.
-            if ((player == kXPlayerId && i + outcome == 24) ||
-                (player == kOPlayerId && i - outcome == -1)) {
-              moves.insert(CheckerMove(i, outcome, false));
-            } else {
-              // Otherwise, a die can only be used to move a checker off if
-              // there are no checkers further than it in the player's home.
-              if (i == FurthestCheckerInHome(player)) {
-                moves.insert(CheckerMove(i, outcome, false));
-              }
-            }
-          } else if (pos != kScorePos && NumOppCheckers(player, pos) <= 1) {
-            // Regular move.
-            bool hit = NumOppCheckers(player, pos) == 1;
-            moves.insert(CheckerMove(i, outcome, hit));
-          }
+    if (my_board[i] == 0) continue;
+    for (int d = 0; d < num_dice; ++d) {
+      int outcome = position.dice[d];
+      if (!UsableDiceOutcome(outcome)) continue;
+      int pos = PositionFrom(player, i, outcome);
+      if (pos == kScorePos && all_in_home) {
+        // Check whether a bear off move is legal.
+
+        // It is ok to bear off if all the checkers are at home and the
+        // point being used to move from exactly matches the distance from
+        // just stepping off the board. Otherwise, a die can only be used to
+        // move a checker off if there are no checkers further than it in the
+        // player's home.
+        if ((player == kXPlayerId && i + outcome == 24) ||
+            (player == kOPlayerId && i - outcome == -1) ||
+            i == furthest_in_home) {
+          moves[num_moves++] = CheckerMove(i, outcome, false);
         }
+      } else if (pos != kScorePos && opp_board[pos] <= 1) {
+        // Regular move.
+        moves[num_moves++] = CheckerMove(i, outcome, opp_board[pos] == 1);
       }
     }
   }
-  return moves;
+  return num_moves;
+}
+
+void BackgammonState::ApplyCheckerMove(MovePosition* position, int player,
+                                       const CheckerMove& move) const {
+  // Same as the in-place version below, except that `move.hit` is known to be
+  // set, since the move comes from LegalCheckerMoves.
+  int next_pos = -1;
+  if (move.pos == kBarPos) {
+    position->bar[player]--;
+    next_pos = PositionFromBar(player, move.num);
+  } else {
+    position->board[player][move.pos]--;
+    next_pos = PositionFrom(player, move.pos, move.num);
+  }
+
+  // Mark the die as used.
+  for (int i = 0; i < 2; ++i) {
+    if (position->dice[i] == move.num) {
+      position->dice[i] += 6;
+      break;
+    }
+  }
+
+  if (next_pos == kScorePos) {
+    position->scores[player]++;
+  } else {
+    position->board[player][next_pos]++;
+  }
+
+  if (move.hit) {
+    position->board[Opponent(player)][next_pos]--;
+    position->bar[Opponent(player)]++;
+  }
 }
 
 bool BackgammonState::ApplyCheckerMove(int player, const CheckerMove& move) {
@@ -1001,44 +1070,32 @@ void BackgammonState::UndoCheckerMove(int player, const CheckerMove& move) {
   }
 }
 
-// Returns the maximum move size (2, 1, or 0)
-int BackgammonState::RecLegalMoves(
-    std::vector<CheckerMove> moveseq,
-    std::set<std::vector<CheckerMove>>* movelist) {
-  if (moveseq.size() == 2) {
-    movelist->insert(moveseq);
-    return moveseq.size();
-  }
-
-  std::set<CheckerMove> moves_here = LegalCheckerMoves(cur_player_);
-
-  if (moves_here.empty()) {
-    movelist->insert(moveseq);
-    return moveseq.size();
-  }
-
-  int max_moves = -1;
-  for (const auto& move : moves_here) {
-    moveseq.push_back(move);
-    ApplyCheckerMove(cur_player_, move);
-    int child_max = RecLegalMoves(moveseq, movelist);
-    UndoCheckerMove(cur_player_, move);
-    max_moves = std::max(child_max, max_moves);
-    moveseq.pop_back();
-  }
-
-  return max_moves;
-}
+std::vector<Action> BackgammonState::LegalActions() const {
+  if (IsChanceNode()) return LegalChanceOutcomes();
+  if (IsTerminal()) return {};
 
-std::vector<Action> BackgammonState::ProcessLegalMoves(
-    int max_moves, const std::set<std::vector<CheckerMove>>& movelist) const {
-  if (max_moves == 0) {
-    SPIEL_CHECK_EQ(movelist.size(), 1);
-    SPIEL_CHECK_TRUE(movelist.begin()->empty());
+  SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
+  SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
 
+  // Enumerate all sequences of (up to) two checker moves on a copy of the
+  // position on the stack. Different sequences can encode to the same action,
+  // so the actions already added are tracked in a bitmask.
+  MovePosition position;
+  for (int p = 0; p < kNumPlayers; ++p) {
+    std::copy(board_[p].begin(), board_[p].end(), position.board[p].begin());
+    position.bar[p] = bar_[p];
+    position.scores[p] = scores_[p];
+  }
+  SPIEL_CHECK_EQ(dice_.size(), 2);
+  position.dice = {dice_[0], dice_[1]};
+
+  std::array<CheckerMove, kMaxSingleCheckerMoves> first_moves;
+  std::array<CheckerMove, kMaxSingleCheckerMoves> second_moves;
+  int num_first_moves =
+      LegalCheckerMoves(position, cur_player_, first_moves.data());
+  if (num_first_moves == 0) {
     // Passing is always a legal move!
-    return {CheckerMovesToSpielMove(
-        {{kPassPos, -1, false}, {kPassPos, -1, false}})};
+    return {CheckerMovesToSpielMove(CheckerMove(), CheckerMove())};
   }
 
   // Rule 2 in Movement of Checkers:
@@ -1049,46 +1106,42 @@ std::vector<Action> BackgammonState::ProcessLegalMoves(
   // the player loses his turn. In the case of doubles, when all four numbers
   // cannot be played, the player must play as many numbers as he can.
   std::vector<Action> legal_actions;
+  std::bitset<kNumDistinctActions> added;
+  bool can_play_both = false;
   int max_roll = -1;
-  for (const auto& move : movelist) {
-    if (max_moves == 2) {
-      // Only add moves that are size 2.
-      if (move.size() == 2) {
-        legal_actions.push_back(CheckerMovesToSpielMove(move));
+  for (int i = 0; i < num_first_moves; ++i) {
+    MovePosition next_position = position;
+    ApplyCheckerMove(&next_position, cur_player_, first_moves[i]);
+    int num_second_moves =
+        LegalCheckerMoves(next_position, cur_player_, second_moves.data());
+    if (num_second_moves == 0) {
+      max_roll = std::max(max_roll, first_moves[i].num);
+      continue;
+    }
+    can_play_both = true;
+    for (int j = 0; j < num_second_moves; ++j) {
+      Action action = CheckerMovesToSpielMove(first_moves[i], second_moves[j]);
+      if (!added[action]) {
+        added[action] = true;
+        legal_actions.push_back(action);
       }
-    } else if (max_moves == 1) {
-      // We are just finding the maximum roll.
-      max_roll = std::max(max_roll, move[0].num);
     }
   }
 
-  if (max_moves == 1) {
-    // Another round to add those that have the max die roll.
-    for (const auto& move : movelist) {
-      if (move[0].num == max_roll) {
-        legal_actions.push_back(CheckerMovesToSpielMove(move));
+  if (!can_play_both) {
+    // Only one die can be played: add those that use the max die roll.
+    for (int i = 0; i < num_first_moves; ++i) {
+      if (first_moves[i].num == max_roll) {
+        Action action = CheckerMovesToSpielMove(first_moves[i], CheckerMove());
+        if (!added[action]) {
+          added[action] = true;
+          legal_actions.push_back(action);
+        }
       }
     }
   }
 
   SPIEL_CHECK_FALSE(legal_actions.empty());
-  return legal_actions;
-}
-
-std::vector<Action> BackgammonState::LegalActions() const {
-  if (IsChanceNode()) return LegalChanceOutcomes();
-  if (IsTerminal()) return {};
-
-  SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
-  SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
-
-  std::unique_ptr<State> cstate = this->Clone();
-  BackgammonState* state = dynamic_cast<BackgammonState*>(cstate.get());
-  std::set<std::vector<CheckerMove>> movelist;
-  int max_moves = state->RecLegalMoves({}, &movelist);
-  SPIEL_CHECK_GE(max_moves, 0);
-  SPIEL_CHECK_LE(max_moves, 2);
-  std::vector<Action> legal_actions = ProcessLegalMoves(max_moves, movelist);
   std::sort(legal_actions.begin(), legal_actions.end());
   return legal_actions;
 }
@@ -1208,6 +1261,38 @@ std::unique_ptr<State> BackgammonState::Clone() const {
   return std::unique_ptr<State>(new BackgammonState(*this));
 }
 
+bool BackgammonState::CloneInto(State* dst) const {
+  return CopyStateInto(*this, dst);
+}
+
+bool BackgammonState::SerializeSnapshot(std::string* out) const {
+  auto append_ints = [out](const std::vector<int>& values) {
+    AppendVarint(values.size(), out);
+    for (int value : values) AppendSignedVarint(value, out);
+  };
+  AppendVarint(history_.size(), out);
+  for (Action action : history_) AppendSignedVarint(action, out);
+  for (int value : {cur_player_, prev_player_, turns_, x_turns_, o_turns_,
+                    static_cast<int>(double_turn_)}) {
+    AppendSignedVarint(value, out);
+  }
+  append_ints(dice_);
+  append_ints(bar_);
+  append_ints(scores_);
+  for (const std::vector<int>& points : board_) append_ints(points);
+  AppendVarint(turn_history_info_.size(), out);
+  for (const TurnHistoryInfo& info : turn_history_info_) {
+    AppendSignedVarint(info.player, out);
+    AppendSignedVarint(info.prev_player, out);
+    append_ints(info.dice);
+    AppendSignedVarint(info.action, out);
+    AppendSignedVarint(info.double_turn | info.first_move_hit << 1 |
+                           info.second_move_hit << 2,
+                       out);
+  }
+  return true;
+}
+
 void BackgammonState::SetState(int cur_player, bool double_turn,
                                const std::vector<int>& dice,
                                const std::vector<int>& bar,
@@ -17,10 +17,10 @@
 
 #include <array>
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/spiel.h"
 
 // An implementation of the classic: https://en.wikipedia.org/wiki/Backgammon
@@ -60,6 +60,10 @@ inline constexpr const int kScorePos = 101;
 // number is encoded as a 2-digit number in base 26.
 inline constexpr const int kNumDistinctActions = 1352;
 
+// Upper bound on the number of single checker moves in a position: one per
+// point for each of the two dice.
+inline constexpr const int kMaxSingleCheckerMoves = 2 * kNumPoints;
+
 // See ObservationTensorShape for details.
 inline constexpr const int kBoardEncodingSize = 4 * kNumPoints * kNumPlayers;
 inline constexpr const int kStateEncodingSize =
@@ -79,6 +83,7 @@ struct CheckerMove {
   int pos;  // 0-24  (0-23 for locations on the board and kBarPos)
   int num;  // 1-6
   bool hit;
+  CheckerMove() : pos(kPassPos), num(-1), hit(false) {}
   CheckerMove(int _pos, int _num, bool _hit)
       : pos(_pos), num(_num), hit(_hit) {}
   bool operator<(const CheckerMove& rhs) const {
@@ -113,6 +118,9 @@ class BackgammonState : public State {
  public:
   BackgammonState(const BackgammonState&) = default;
   BackgammonState(std::shared_ptr<const Game>, ScoringType scoring_type);
+  // Restores a state written by SerializeSnapshot.
+  BackgammonState(std::shared_ptr<const Game>, ScoringType scoring_type,
+                  absl::string_view snapshot);
 
   Player CurrentPlayer() const override;
   void UndoAction(Player player, Action action) override;
@@ -124,8 +132,10 @@ class BackgammonState : public State {
   std::vector<double> Returns() const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CloneInto(State* dst) const override;
+  bool SerializeSnapshot(std::string* out) const override;
 
   // Setter function used for debugging and tests. Note: this does not set the
   // historical information properly, so Undo likely will not work on states
@@ -178,6 +188,8 @@ class BackgammonState : public State {
 
   // Action encoding / decoding functions.
   Action CheckerMovesToSpielMove(const std::vector<CheckerMove>& moves) const;
+  Action CheckerMovesToSpielMove(const CheckerMove& first,
+                                 const CheckerMove& second) const;
   std::vector<CheckerMove> SpielMoveToCheckerMoves(int player,
                                                    Action spiel_move) const;
   Action TranslateAction(int from1, int from2, bool use_high_die_first) const;
@@ -186,9 +198,12 @@ class BackgammonState : public State {
   void DoApplyAction(Action move_id) override;
 
  private:
+  // The parts of a position that change during legal move generation. See
+  // LegalActions.
+  struct MovePosition;
+
   void RollDice(int outcome);
   bool IsPosInHome(int player, int pos) const;
-  bool AllInHome(int player) const;
   int CheckersInHome(int player) const;
   bool UsableDiceOutcome(int outcome) const;
   int PositionFromBar(int player, int spaces) const;
@@ -207,17 +222,17 @@ class BackgammonState : public State {
   // and compute whether the move goes off the board.
   int AugmentCheckerMove(CheckerMove* cmove, int player, int start) const;
 
-  // Returns the position of the furthest checker in the home of this player.
-  // Returns -1 if none found.
-  int FurthestCheckerInHome(int player) const;
-
   bool ApplyCheckerMove(int player, const CheckerMove& move);
   void UndoCheckerMove(int player, const CheckerMove& move);
-  std::set<CheckerMove> LegalCheckerMoves(int player) const;
-  int RecLegalMoves(std::vector<CheckerMove> moveseq,
-                    std::set<std::vector<CheckerMove>>* movelist);
-  std::vector<Action> ProcessLegalMoves(
-      int max_moves, const std::set<std::vector<CheckerMove>>& movelist) const;
+
+  // Legal move generation helpers. They work on a MovePosition rather than on
+  // the state itself, so that LegalActions does not need to clone the state.
+  // LegalCheckerMoves writes at most kMaxSingleCheckerMoves moves to `moves`
+  // and returns how many it wrote.
+  int LegalCheckerMoves(const MovePosition& position, int player,
+                        CheckerMove* moves) const;
+  void ApplyCheckerMove(MovePosition* position, int player,
+                        const CheckerMove& move) const;
 
   ScoringType scoring_type_;  // Which rules apply when scoring the game.
 
@@ -245,6 +260,12 @@ class BackgammonGame : public Game {
         new BackgammonState(shared_from_this(), scoring_type_));
   }
 
+  std::unique_ptr<State> DeserializeSnapshot(
+      absl::string_view snapshot) const override {
+    return std::unique_ptr<State>(
+        new BackgammonState(shared_from_this(), scoring_type_, snapshot));
+  }
+
   int MaxChanceOutcomes() const override { return kNumChanceOutcomes; }
 
   // There is arbitrarily chosen number to ensure the game is finite.
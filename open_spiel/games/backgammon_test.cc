@@ -15,7 +15,10 @@
 #include "open_spiel/games/backgammon.h"
 
 #include <algorithm>
+#include <array>
 #include <random>
+#include <set>
+#include <vector>
 
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -31,6 +34,220 @@ bool ActionsContains(const std::vector<Action>& legal_actions, Action action) {
          legal_actions.end();
 }
 
+// The legal move generator that LegalActions used before it worked on a
+// MovePosition, kept as a reference for the current one. It collects every
+// sequence of checker moves into a std::set, applying and undoing the moves
+// on its own copy of the position.
+class ReferenceMoveGenerator {
+ public:
+  explicit ReferenceMoveGenerator(const BackgammonState& state)
+      : state_(state), player_(state.CurrentPlayer()) {
+    for (int p = 0; p < kNumPlayers; ++p) {
+      for (int pos = 0; pos < kNumPoints; ++pos) {
+        board_[p][pos] = state.board(p, pos);
+      }
+      bar_[p] = state.bar(p);
+      scores_[p] = state.score(p);
+    }
+    dice_ = {state.dice(0), state.dice(1)};
+  }
+
+  std::vector<Action> LegalActions() {
+    std::set<std::vector<CheckerMove>> movelist;
+    int max_moves = RecLegalMoves({}, &movelist);
+    SPIEL_CHECK_GE(max_moves, 0);
+    SPIEL_CHECK_LE(max_moves, 2);
+    if (max_moves == 0) {
+      return {state_.CheckerMovesToSpielMove(
+          {{kPassPos, -1, false}, {kPassPos, -1, false}})};
+    }
+
+    std::vector<Action> legal_actions;
+    int max_roll = -1;
+    for (const auto& move : movelist) {
+      if (max_moves == 2) {
+        if (move.size() == 2) {
+          legal_actions.push_back(state_.CheckerMovesToSpielMove(move));
+        }
+      } else {
+        max_roll = std::max(max_roll, move[0].num);
+      }
+    }
+    if (max_moves == 1) {
+      for (const auto& move : movelist) {
+        if (move[0].num == max_roll) {
+          legal_actions.push_back(state_.CheckerMovesToSpielMove(move));
+        }
+      }
+    }
+    std::sort(legal_actions.begin(), legal_actions.end());
+    return legal_actions;
+  }
+
+  // Whether a checker could be entered from the bar or borne off.
+  bool entered_from_bar() const { return entered_from_bar_; }
+  bool bore_off() const { return bore_off_; }
+
+ private:
+  int PositionFrom(int pos, int spaces) const {
+    if (pos == kBarPos) {
+      return player_ == kXPlayerId ? -1 + spaces : 24 - spaces;
+    }
+    int new_pos = player_ == kXPlayerId ? pos + spaces : pos - spaces;
+    return (new_pos < 0 || new_pos > 23) ? kScorePos : new_pos;
+  }
+
+  bool AllInHome() const {
+    if (bar_[player_] > 0) return false;
+    int scan_start = (player_ == kXPlayerId ? 0 : 6);
+    int scan_end = (player_ == kXPlayerId ? 17 : 23);
+    for (int i = scan_start; i <= scan_end; ++i) {
+      if (board_[player_][i] > 0) return false;
+    }
+    return true;
+  }
+
+  int FurthestCheckerInHome() const {
+    int scan_start = (player_ == kXPlayerId ? 23 : 0);
+    int scan_end = (player_ == kXPlayerId ? 17 : 6);
+    int inc = (player_ == kXPlayerId ? -1 : 1);
+    int furthest = -1;
+    for (int i = scan_start; i != scan_end; i += inc) {
+      if (board_[player_][i] > 0) furthest = i;
+    }
+    return furthest;
+  }
+
+  std::set<CheckerMove> LegalCheckerMoves() {
+    const int opponent = 1 - player_;
+    std::set<CheckerMove> moves;
+    if (bar_[player_] > 0) {
+      for (int outcome : dice_) {
+        if (outcome >= 1 && outcome <= 6) {
+          int pos = PositionFrom(kBarPos, outcome);
+          if (board_[opponent][pos] <= 1) {
+            moves.insert(
+                CheckerMove(kBarPos, outcome, board_[opponent][pos] == 1));
+            entered_from_bar_ = true;
+          }
+        }
+      }
+      return moves;
+    }
+
+    bool all_in_home = AllInHome();
+    for (int i = 0; i < kNumPoints; ++i) {
+      if (board_[player_][i] == 0) continue;
+      for (int outcome : dice_) {
+        if (outcome < 1 || outcome > 6) continue;
+        int pos = PositionFrom(i, outcome);
+        if (pos == kScorePos && all_in_home) {
+          if ((player_ == kXPlayerId && i + outcome == 24) ||
+              (player_ == kOPlayerId && i - outcome == -1) ||
+              i == FurthestCheckerInHome()) {
+            moves.insert(CheckerMove(i, outcome, false));
+            bore_off_ = true;
+          }
+        } else if (pos != kScorePos && board_[opponent][pos] <= 1) {
+          moves.insert(CheckerMove(i, outcome, board_[opponent][pos] == 1));
+        }
+      }
+    }
+    return moves;
+  }
+
+  void ApplyCheckerMove(const CheckerMove& move, int sign) {
+    const int opponent = 1 - player_;
+    int next_pos = PositionFrom(move.pos, move.num);
+    if (move.pos == kBarPos) {
+      bar_[player_] -= sign;
+    } else {
+      board_[player_][move.pos] -= sign;
+    }
+    for (int i = 0; i < 2; ++i) {
+      if (dice_[i] == (sign > 0 ? move.num : move.num + 6)) {
+        dice_[i] += 6 * sign;
+        break;
+      }
+    }
+    if (next_pos == kScorePos) {
+      scores_[player_] += sign;
+    } else {
+      board_[player_][next_pos] += sign;
+    }
+    if (move.hit) {
+      board_[opponent][next_pos] -= sign;
+      bar_[opponent] += sign;
+    }
+  }
+
+  // Returns the maximum move size (2, 1, or 0).
+  int RecLegalMoves(std::vector<CheckerMove> moveseq,
+                    std::set<std::vector<CheckerMove>>* movelist) {
+    if (moveseq.size() == 2) {
+      movelist->insert(moveseq);
+      return moveseq.size();
+    }
+    std::set<CheckerMove> moves_here = LegalCheckerMoves();
+    if (moves_here.empty()) {
+      movelist->insert(moveseq);
+      return moveseq.size();
+    }
+    int max_moves = -1;
+    for (const auto& move : moves_here) {
+      moveseq.push_back(move);
+      ApplyCheckerMove(move, 1);
+      max_moves = std::max(RecLegalMoves(moveseq, movelist), max_moves);
+      ApplyCheckerMove(move, -1);
+      moveseq.pop_back();
+    }
+    return max_moves;
+  }
+
+  const BackgammonState& state_;
+  const int player_;
+  std::array<std::array<int, kNumPoints>, kNumPlayers> board_;
+  std::array<int, kNumPlayers> bar_;
+  std::array<int, kNumPlayers> scores_;
+  std::array<int, 2> dice_;
+  bool entered_from_bar_ = false;
+  bool bore_off_ = false;
+};
+
+// Compares LegalActions with the reference generator on every decision of
+// random games, which must go through bar entries, bear-offs and doubles.
+void LegalActionsMatchReferenceTest() {
+  std::mt19937 rng(29);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::shared_ptr<const Game> game = LoadGame("backgammon");
+  int num_bar_entries = 0;
+  int num_bear_offs = 0;
+  int num_doubles = 0;
+  for (int i = 0; i < 100; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (state->IsChanceNode()) {
+        state->ApplyAction(
+            SampleAction(state->ChanceOutcomes(), uniform(rng)).first);
+        continue;
+      }
+      const auto& bstate = static_cast<const BackgammonState&>(*state);
+      ReferenceMoveGenerator reference(bstate);
+      std::vector<Action> legal_actions = bstate.LegalActions();
+      SPIEL_CHECK_EQ(legal_actions, reference.LegalActions());
+      num_bar_entries += reference.entered_from_bar();
+      num_bear_offs += reference.bore_off();
+      num_doubles += bstate.dice(0) == bstate.dice(1);
+      state->ApplyAction(
+          legal_actions[std::uniform_int_distribution<int>(
+              0, legal_actions.size() - 1)(rng)]);
+    }
+  }
+  SPIEL_CHECK_GT(num_bar_entries, 0);
+  SPIEL_CHECK_GT(num_bear_offs, 0);
+  SPIEL_CHECK_GT(num_doubles, 0);
+}
+
 void BasicBackgammonTestsVaryScoring() {
   for (std::string scoring :
        {"winloss_scoring", "enable_gammons", "full_scoring"}) {
@@ -536,4 +753,5 @@ int main(int argc, char** argv) {
   open_spiel::backgammon::DoublesBearOffOutsideHome();
   open_spiel::backgammon::BasicBackgammonTestsVaryScoring();
   open_spiel::backgammon::HumanReadableNotation();
+  open_spiel::backgammon::LegalActionsMatchReferenceTest();
 }
@@ -214,9 +214,8 @@ std::string BreakthroughState::ActionToString(Player player,
   return action_string;
 }
 
-std::vector<Action> BreakthroughState::LegalActions() const {
-  std::vector<Action> movelist;
-  if (IsTerminal()) return movelist;
+template <typename Yield>
+void BreakthroughState::GenerateLegalActions(Yield&& yield) const {
   const Player player = CurrentPlayer();
   CellState mystate = PlayerToState(player);
   std::vector<int> action_bases = {rows_, cols_, kNumDirections, 2};
@@ -237,24 +236,37 @@ std::vector<Action> BreakthroughState::LegalActions() const {
             if (board(rp, cp) == CellState::kEmpty) {
               // Regular move.
               action_values[3] = 0;
-              movelist.push_back(
-                  RankActionMixedBase(action_bases, action_values));
+              yield(RankActionMixedBase(action_bases, action_values));
             } else if ((o == 0 || o == 2) &&
                        board(rp, cp) == OpponentState(mystate)) {
               // Capture move (can only capture diagonally)
               action_values[3] = 1;
-              movelist.push_back(
-                  RankActionMixedBase(action_bases, action_values));
+              yield(RankActionMixedBase(action_bases, action_values));
             }
           }
         }
       }
     }
   }
+}
 
+std::vector<Action> BreakthroughState::LegalActions() const {
+  std::vector<Action> movelist;
+  if (IsTerminal()) return movelist;
+  GenerateLegalActions([&movelist](Action action) {
+    movelist.push_back(action);
+  });
   return movelist;
 }
 
+void BreakthroughState::LegalActionsMask(Player player,
+                                         absl::Span<uint8_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0);
+  if (IsTerminal() || player != CurrentPlayer()) return;
+  GenerateLegalActions([mask](Action action) { mask[action] = 1; });
+}
+
 bool BreakthroughState::InBounds(int r, int c) const {
   return (r >= 0 && r < rows_ && c >= 0 && c < cols_);
 }
@@ -324,7 +336,7 @@ std::string BreakthroughState::ObservationString(Player player) const {
 }
 
 void BreakthroughState::ObservationTensor(Player player,
-                                          std::vector<double>* values) const {
+                                          absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -377,6 +389,10 @@ std::unique_ptr<State> BreakthroughState::Clone() const {
   return std::unique_ptr<State>(new BreakthroughState(*this));
 }
 
+bool BreakthroughState::CloneInto(State* dst) const {
+  return CopyStateInto(*this, dst);
+}
+
 BreakthroughGame::BreakthroughGame(const GameParameters& params)
     : Game(kGameType, params),
       rows_(ParameterValue<int>("rows")),
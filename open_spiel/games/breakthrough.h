@@ -59,8 +59,9 @@ class BreakthroughState : public State {
   std::vector<double> Returns() const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CloneInto(State* dst) const override;
   void UndoAction(Player player, Action action) override;
 
   bool InBounds(int r, int c) const;
@@ -71,6 +72,8 @@ class BreakthroughState : public State {
   int rows() const { return rows_; }
   int cols() const { return cols_; }
   std::vector<Action> LegalActions() const override;
+  void LegalActionsMask(Player player,
+                        absl::Span<uint8_t> mask) const override;
   std::string Serialize() const override;
 
  protected:
@@ -78,6 +81,10 @@ class BreakthroughState : public State {
 
  private:
   int observation_plane(int r, int c) const;
+  // Calls `yield` with each legal action of the player to move, in ascending
+  // order. Defined in breakthrough.cc, which is its only user.
+  template <typename Yield>
+  void GenerateLegalActions(Yield&& yield) const;
 
   // Fields sets to bad/invalid values. Use Game::NewInitialState().
   Player cur_player_ = kInvalidPlayer;
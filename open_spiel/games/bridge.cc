@@ -19,20 +19,11 @@
 
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/string_view.h"
-#include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
-// Our preferred version of the double_dummy_solver defines a DDS_EXTERNAL
-// macro to add a prefix to the exported symbols to avoid name clashes.
-// In order to compile with versions of the double_dummy_solver which do not
-// do this, we define DDS_EXTERNAL as an identity if it isn't already defined.
-#ifndef DDS_EXTERNAL
-#define DDS_EXTERNAL(x) x
-#endif
-
 namespace open_spiel {
 namespace bridge {
 namespace {
@@ -61,6 +52,10 @@ const GameType kGameType{/*short_name=*/"bridge",
                              {"dealer_vul", GameParameter(false)},
                              // If true, the non-dealer's side is vulnerable.
                              {"non_dealer_vul", GameParameter(false)},
+                             // If set, a file of precomputed double-dummy
+                             // tables, in the format of
+                             // DoubleDummyCache::Save, to preload.
+                             {"dd_tables_file", GameParameter(std::string(""))},
                          }};
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
@@ -118,7 +113,12 @@ int Partnership(Player player) { return player & 1; }
 }  // namespace
 
 BridgeGame::BridgeGame(const GameParameters& params)
-    : Game(kGameType, params) {}
+    : Game(kGameType, params) {
+  InitDoubleDummySolver();
+  const std::string dd_tables_file =
+      ParameterValue<std::string>("dd_tables_file");
+  if (!dd_tables_file.empty()) PreloadDoubleDummyTables(dd_tables_file);
+}
 
 BridgeState::BridgeState(std::shared_ptr<const Game> game,
                          bool use_double_dummy_result,
@@ -213,8 +213,8 @@ std::string BridgeState::ToString() const {
 std::string BridgeState::ObservationString(Player player) const {
   // We construct the ObservationString from the ObservationTensor to give
   // some indication that the tensor representation is correct & complete.
-  std::vector<double> tensor(game_->ObservationTensorSize());
-  ObservationTensor(player, &tensor);
+  std::vector<float> tensor(game_->ObservationTensorSize());
+  ObservationTensor(player, absl::MakeSpan(tensor));
   std::string rv;
   if (tensor[0] || tensor[1]) {
     if (tensor[1]) rv = "Lead ";
@@ -303,12 +303,12 @@ std::string BridgeState::ObservationString(Player player) const {
 }
 
 void BridgeState::ObservationTensor(Player player,
-                                    std::vector<double>* values) const {
-  std::fill(values->begin(), values->end(), 0.0);
-  values->resize(game_->ObservationTensorSize());
+                                    absl::Span<float> values) const {
+  SPIEL_CHECK_EQ(values.size(), game_->ObservationTensorSize());
+  std::fill(values.begin(), values.end(), 0.0);
   if (phase_ == Phase::kGameOver || phase_ == Phase::kDeal) return;
   int partnership = Partnership(player);
-  auto ptr = values->begin();
+  auto ptr = values.begin();
   if (num_cards_played_ > 0) {
     // Observation for play phase
     if (phase_ == Phase::kPlay) ptr[2] = 1;
@@ -352,9 +352,9 @@ void BridgeState::ObservationTensor(Player player,
     ptr += kNumTricks;
     ptr[num_cards_played_ / 4 - num_declarer_tricks_] = 1;
     ptr += kNumTricks;
-    SPIEL_CHECK_EQ(std::distance(values->begin(), ptr),
+    SPIEL_CHECK_EQ(std::distance(values.begin(), ptr),
                    kPlayTensorSize + kNumObservationTypes);
-    SPIEL_CHECK_LE(std::distance(values->begin(), ptr), values->size());
+    SPIEL_CHECK_LE(std::distance(values.begin(), ptr), values.size());
   } else {
     // Observation for auction or opening lead.
     ptr[phase_ == Phase::kPlay ? 1 : 0] = 1;
@@ -384,13 +384,13 @@ void BridgeState::ObservationTensor(Player player,
     for (int i = 0; i < kNumCards; ++i)
       if (holder_[i] == player) ptr[i] = 1;
     ptr += kNumCards;
-    SPIEL_CHECK_EQ(std::distance(values->begin(), ptr),
+    SPIEL_CHECK_EQ(std::distance(values.begin(), ptr),
                    kAuctionTensorSize + kNumObservationTypes);
-    SPIEL_CHECK_LE(std::distance(values->begin(), ptr), values->size());
+    SPIEL_CHECK_LE(std::distance(values.begin(), ptr), values.size());
   }
 }
 
-void BridgeState::ComputeDoubleDummyTricks() {
+ddTableDeal BridgeState::DoubleDummyDeal() const {
   ddTableDeal dd_table_deal{};
   for (int suit = 0; suit < kNumSuits; ++suit) {
     for (int rank = 0; rank < kNumCardsPerSuit; ++rank) {
@@ -398,13 +398,31 @@ void BridgeState::ComputeDoubleDummyTricks() {
       dd_table_deal.cards[player][suit] += 1 << (2 + rank);
     }
   }
-  DDS_EXTERNAL(SetMaxThreads)(0);
-  const int return_code =
-      DDS_EXTERNAL(CalcDDtable)(dd_table_deal, &double_dummy_results_);
-  if (return_code != RETURN_NO_FAULT) {
-    char error_message[80];
-    DDS_EXTERNAL(ErrorMessage)(return_code, error_message);
-    SpielFatalError(absl::StrCat("double_dummy_solver:", error_message));
+  return dd_table_deal;
+}
+
+void BridgeState::ComputeDoubleDummyTricks() {
+  if (double_dummy_results_.has_value()) return;
+  double_dummy_results_ = GlobalDoubleDummyCache()->Solve(DoubleDummyDeal());
+}
+
+void BatchComputeDoubleDummyTricks(absl::Span<State* const> states) {
+  std::vector<BridgeState*> unsolved;
+  std::vector<ddTableDeal> deals;
+  for (State* state : states) {
+    SPIEL_CHECK_EQ(state->GetGame()->GetType().short_name,
+                   kGameType.short_name);
+    auto* bridge_state = static_cast<BridgeState*>(state);
+    SPIEL_CHECK_TRUE(bridge_state->phase_ != BridgeState::Phase::kDeal);
+    if (bridge_state->double_dummy_results_.has_value()) continue;
+    unsolved.push_back(bridge_state);
+    deals.push_back(bridge_state->DoubleDummyDeal());
+  }
+  if (unsolved.empty()) return;
+  const std::vector<ddTableResults> results =
+      GlobalDoubleDummyCache()->Solve(deals);
+  for (int i = 0; i < unsolved.size(); ++i) {
+    unsolved[i]->double_dummy_results_ = results[i];
   }
 }
 
@@ -500,7 +518,6 @@ void BridgeState::DoApplyAction(Action action) {
 void BridgeState::ApplyDealAction(int card) {
   holder_[card] = (history_.size() % kNumPlayers);
   if (history_.size() == kNumCards - 1) {
-    ComputeDoubleDummyTricks();
     phase_ = Phase::kAuction;
     current_player_ = kFirstPlayer;
   }
@@ -529,9 +546,10 @@ void BridgeState::ApplyBiddingAction(int call) {
       // After there has been a bid, three consecutive passes end the auction.
       if (use_double_dummy_result_) {
         phase_ = Phase::kGameOver;
+        ComputeDoubleDummyTricks();
         num_declarer_tricks_ =
             double_dummy_results_
-                .resTable[contract_.trumps][contract_.declarer];
+                ->resTable[contract_.trumps][contract_.declarer];
         ScoreUp();
       } else {
         phase_ = Phase::kPlay;
@@ -577,7 +595,9 @@ void BridgeState::ApplyPlayAction(int card) {
 }
 
 Player BridgeState::CurrentPlayer() const {
-  if (phase_ == Phase::kDeal) {
+  if (IsTerminal()) {
+    return kTerminalPlayerId;
+  } else if (phase_ == Phase::kDeal) {
     return kChancePlayerId;
   } else if (phase_ == Phase::kPlay &&
              Partnership(current_player_) == Partnership(contract_.declarer)) {
@@ -43,10 +43,13 @@
 // partner). There will thus be 26 turns for declarer, and 13 turns for each
 // of the defenders during the play.
 
+#include <memory>
 #include <optional>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
+#include "open_spiel/games/bridge/double_dummy.h"
 #include "open_spiel/spiel.h"
 
 namespace open_spiel {
@@ -131,17 +134,23 @@ class BridgeState : public State {
   std::vector<double> Returns() const override { return returns_; }
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override {
     return std::unique_ptr<State>(new BridgeState(*this));
   }
   std::vector<Action> LegalActions() const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
 
+  // The deal in the format of the double-dummy solver. Only valid once all
+  // the cards have been dealt.
+  ddTableDeal DoubleDummyDeal() const;
+
  protected:
   void DoApplyAction(Action action) override;
 
  private:
+  friend void BatchComputeDoubleDummyTricks(absl::Span<State* const> states);
+
   enum class Phase { kDeal, kAuction, kPlay, kGameOver };
 
   std::vector<Action> DealLegalActions() const;
@@ -172,7 +181,8 @@ class BridgeState : public State {
   std::array<Trick, kNumTricks> tricks_{};
   std::vector<double> returns_ = std::vector<double>(kNumPlayers);
   std::array<std::optional<Player>, kNumCards> holder_{};
-  ddTableResults double_dummy_results_{};
+  // Computed when the auction ends, unless it was computed in a batch before.
+  std::optional<ddTableResults> double_dummy_results_{};
 };
 
 class BridgeGame : public Game {
@@ -212,6 +222,12 @@ class BridgeGame : public Game {
   }
 };
 
+// Solves the deals of many bridge states at once, spreading them over the
+// solver's threads, so that ending their auctions needs no further solving.
+// The states must all be dealt. This is much faster than letting each state
+// solve its own deal when generating many deals, e.g. for training data.
+void BatchComputeDoubleDummyTricks(absl::Span<State* const> states);
+
 }  // namespace bridge
 }  // namespace open_spiel
 
@@ -0,0 +1,265 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/bridge/double_dummy.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <set>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel_utils.h"
+
+// Our preferred version of the double_dummy_solver defines a DDS_EXTERNAL
+// macro to add a prefix to the exported symbols to avoid name clashes.
+// In order to compile with versions of the double_dummy_solver which do not
+// do this, we define DDS_EXTERNAL as an identity if it isn't already defined.
+#ifndef DDS_EXTERNAL
+#define DDS_EXTERNAL(x) x
+#endif
+
+namespace open_spiel {
+namespace bridge {
+namespace {
+
+constexpr int kNumCards = 52;
+constexpr int kNumRanks = 13;
+constexpr int kNumTricks = kNumCards / DDS_HANDS;
+
+// Passed as the mode of CalcAllTables to skip the par calculation.
+constexpr int kNoPar = -1;
+
+// Two bits for each card's holder.
+constexpr int kKeyBytes = 13;
+constexpr int kRecordBytes = kKeyBytes + DDS_STRAINS * DDS_HANDS;
+
+}  // namespace
+
+void InitDoubleDummySolver() {
+  static std::once_flag once;
+  // Zero lets the solver pick the number of threads from the machine.
+  std::call_once(once, [] { DDS_EXTERNAL(SetMaxThreads)(0); });
+}
+
+std::vector<ddTableResults> SolveDoubleDummy(
+    absl::Span<const ddTableDeal> deals) {
+  InitDoubleDummySolver();
+  std::vector<ddTableResults> results(deals.size());
+  // These hold up to MAXNOOFTABLES deals, too much for the stack.
+  auto batch = std::make_unique<ddTableDeals>();
+  auto batch_results = std::make_unique<ddTablesRes>();
+  auto par_results = std::make_unique<allParResults>();
+  // The batched call follows the documented CalcAllTables interface: a zero
+  // in trump_filter solves that denomination, and kNoPar skips the par
+  // calculation. It has only been run against a stand-in for the solver, not
+  // against the real double_dummy_solver.
+  int trump_filter[DDS_STRAINS] = {0, 0, 0, 0, 0};  // All denominations.
+  for (int begin = 0; begin < deals.size(); begin += MAXNOOFTABLES) {
+    const int num_tables =
+        std::min<int>(MAXNOOFTABLES, deals.size() - begin);
+    batch->noOfTables = num_tables;
+    std::copy(deals.begin() + begin, deals.begin() + begin + num_tables,
+              batch->deals);
+    const int return_code = DDS_EXTERNAL(CalcAllTables)(
+        batch.get(), kNoPar, trump_filter, batch_results.get(),
+        par_results.get());
+    if (return_code != RETURN_NO_FAULT) {
+      char error_message[80];
+      DDS_EXTERNAL(ErrorMessage)(return_code, error_message);
+      SpielFatalError(absl::StrCat("double_dummy_solver:", error_message));
+    }
+    std::copy(batch_results->results, batch_results->results + num_tables,
+              results.begin() + begin);
+  }
+  return results;
+}
+
+absl::uint128 DoubleDummyDealKey(const ddTableDeal& deal) {
+  absl::uint128 key = 0;
+  int num_cards = 0;
+  for (int hand = 0; hand < DDS_HANDS; ++hand) {
+    for (int suit = 0; suit < DDS_SUITS; ++suit) {
+      // Ranks are stored from bit 2 up.
+      for (unsigned int ranks = deal.cards[hand][suit] >> 2; ranks != 0;
+           ranks &= ranks - 1) {
+        const int card = suit * kNumRanks + __builtin_ctz(ranks);
+        key |= absl::uint128(hand) << (2 * card);
+        ++num_cards;
+      }
+    }
+  }
+  SPIEL_CHECK_EQ(num_cards, kNumCards);
+  return key;
+}
+
+DoubleDummyCache::DoubleDummyCache(int capacity) : capacity_(capacity) {
+  SPIEL_CHECK_GT(capacity, 0);
+}
+
+std::vector<ddTableResults> DoubleDummyCache::Solve(
+    absl::Span<const ddTableDeal> deals) {
+  std::vector<ddTableResults> results(deals.size());
+  // The deals to solve, each with the indices of the deals it answers.
+  std::vector<ddTableDeal> missing;
+  std::unordered_map<absl::uint128, std::vector<int>, KeyHash> missing_indices;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < deals.size(); ++i) {
+      const absl::uint128 key = DoubleDummyDealKey(deals[i]);
+      auto it = index_.find(key);
+      if (it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        results[i] = it->second->second;
+        continue;
+      }
+      std::vector<int>& indices = missing_indices[key];
+      if (indices.empty()) missing.push_back(deals[i]);
+      indices.push_back(i);
+    }
+  }
+  if (missing.empty()) return results;
+
+  // The lock is not held while solving, which takes much longer than any
+  // lookup.
+  const std::vector<ddTableResults> solved = SolveDoubleDummy(missing);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int j = 0; j < missing.size(); ++j) {
+    const absl::uint128 key = DoubleDummyDealKey(missing[j]);
+    for (int i : missing_indices[key]) results[i] = solved[j];
+    Insert(key, solved[j]);
+  }
+  Evict();
+  return results;
+}
+
+void DoubleDummyCache::Insert(absl::uint128 key,
+                              const ddTableResults& results) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    // Another thread solved the same deal in the meantime.
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+  entries_.emplace_front(key, results);
+  index_.emplace(key, entries_.begin());
+}
+
+void DoubleDummyCache::Evict() {
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+int DoubleDummyCache::Load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Could not open double-dummy file: ", path));
+  }
+  std::vector<Entry> loaded;
+  unsigned char record[kRecordBytes];
+  while (file.read(reinterpret_cast<char*>(record), kRecordBytes)) {
+    Entry entry;
+    entry.first = 0;
+    for (int i = kKeyBytes - 1; i >= 0; --i) {
+      entry.first = (entry.first << 8) | record[i];
+    }
+    std::array<int, DDS_HANDS> hand_sizes{};
+    for (int card = 0; card < kNumCards; ++card) {
+      ++hand_sizes[(record[card / 4] >> (2 * (card % 4))) & 3];
+    }
+    bool valid = std::all_of(hand_sizes.begin(), hand_sizes.end(),
+                             [](int size) { return size == kNumTricks; });
+    for (int strain = 0; strain < DDS_STRAINS; ++strain) {
+      for (int hand = 0; hand < DDS_HANDS; ++hand) {
+        const int tricks = record[kKeyBytes + strain * DDS_HANDS + hand];
+        valid &= tricks <= kNumTricks;
+        entry.second.resTable[strain][hand] = tricks;
+      }
+    }
+    if (!valid) {
+      SpielFatalError(absl::StrCat("Double-dummy file ", path,
+                                   " holds an invalid record at byte ",
+                                   loaded.size() * kRecordBytes, "."));
+    }
+    loaded.push_back(entry);
+  }
+  if (file.gcount() != 0) {
+    SpielFatalError(absl::StrCat("Double-dummy file ", path,
+                                 " ends with a partial record."));
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const Entry& entry : loaded) Insert(entry.first, entry.second);
+  Evict();
+  return loaded.size();
+}
+
+void DoubleDummyCache::Save(const std::string& path) const {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot write double-dummy file: ", path));
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  unsigned char record[kRecordBytes];
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    absl::uint128 key = it->first;
+    for (int i = 0; i < kKeyBytes; ++i) {
+      record[i] = absl::Uint128Low64(key) & 0xff;
+      key >>= 8;
+    }
+    for (int strain = 0; strain < DDS_STRAINS; ++strain) {
+      for (int hand = 0; hand < DDS_HANDS; ++hand) {
+        record[kKeyBytes + strain * DDS_HANDS + hand] =
+            it->second.resTable[strain][hand];
+      }
+    }
+    file.write(reinterpret_cast<const char*>(record), kRecordBytes);
+  }
+  if (!file) SpielFatalError(absl::StrCat("Failed writing ", path));
+}
+
+void DoubleDummyCache::SetCapacity(int capacity) {
+  SPIEL_CHECK_GT(capacity, 0);
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  Evict();
+}
+
+int DoubleDummyCache::capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+int DoubleDummyCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+DoubleDummyCache* GlobalDoubleDummyCache() {
+  static DoubleDummyCache* cache = new DoubleDummyCache();
+  return cache;
+}
+
+void PreloadDoubleDummyTables(const std::string& path) {
+  static std::mutex* mutex = new std::mutex();
+  static std::set<std::string>* loaded_paths = new std::set<std::string>();
+  std::lock_guard<std::mutex> lock(*mutex);
+  if (loaded_paths->insert(path).second) GlobalDoubleDummyCache()->Load(path);
+}
+
+}  // namespace bridge
+}  // namespace open_spiel
@@ -0,0 +1,115 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_DOUBLE_DUMMY_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_DOUBLE_DUMMY_H_
+
+// Double-dummy analysis of full bridge deals, shared by the bridge games.
+//
+// The solver is configured once per process, and deals are solved in batches
+// through its multi-table entry point, which spreads the tables over all its
+// threads. A DoubleDummyCache remembers the tables it has computed, so that a
+// deal seen again is not solved again. One cache is shared by all the bridge
+// games of the process, so evaluating many bidding policies on a fixed set
+// of deals solves each deal once; it can be preloaded from a file of
+// precomputed tables.
+
+#include <list>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
+
+namespace open_spiel {
+namespace bridge {
+
+// Configures the solver threads. Called when the bridge games are loaded;
+// only the first call has an effect.
+void InitDoubleDummySolver();
+
+// Solves the deals, which must have all 52 cards dealt, and returns their
+// tables in the same order: results[i].resTable[denomination][declarer] is
+// the number of tricks the declarer takes.
+std::vector<ddTableResults> SolveDoubleDummy(
+    absl::Span<const ddTableDeal> deals);
+
+// The holder of each card, two bits per card. Only defined for full deals.
+absl::uint128 DoubleDummyDealKey(const ddTableDeal& deal);
+
+// The default capacity of a DoubleDummyCache, about 50MB of tables.
+inline constexpr int kDefaultDoubleDummyCacheSize = 1 << 18;
+
+// A thread-safe map from deals to their double-dummy tables, holding at most
+// `capacity` tables. When full, the least recently used table is dropped.
+class DoubleDummyCache {
+ public:
+  explicit DoubleDummyCache(int capacity = kDefaultDoubleDummyCacheSize);
+
+  // Like SolveDoubleDummy, but only the deals that are not in the cache are
+  // solved, in one batch.
+  std::vector<ddTableResults> Solve(absl::Span<const ddTableDeal> deals);
+  ddTableResults Solve(const ddTableDeal& deal) {
+    return Solve(absl::MakeConstSpan(&deal, 1)).front();
+  }
+
+  // Adds the tables of a file written by Save and returns how many it held.
+  // The file is a sequence of fixed-size records: the 13 bytes of the deal
+  // key, least significant first, then the 20 trick counts of the table, one
+  // byte each, in resTable order. Fails on a record whose hands do not all
+  // hold 13 cards, or with more than 13 tricks.
+  int Load(const std::string& path);
+  // Writes all the tables in the cache, least recently used first.
+  void Save(const std::string& path) const;
+
+  void SetCapacity(int capacity);
+  int capacity() const;
+  int size() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(absl::uint128 key) const {
+      return absl::Uint128Low64(key) * 0x9e3779b97f4a7c15ULL ^
+             absl::Uint128High64(key);
+    }
+  };
+  using Entry = std::pair<absl::uint128, ddTableResults>;
+
+  // Both require mutex_ to be held.
+  void Insert(absl::uint128 key, const ddTableResults& results);
+  void Evict();
+
+  mutable std::mutex mutex_;
+  int capacity_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<absl::uint128, std::list<Entry>::iterator, KeyHash>
+      index_;
+};
+
+// The cache shared by the bridge games.
+DoubleDummyCache* GlobalDoubleDummyCache();
+
+// Loads the file into the global cache, unless it was already loaded by this
+// process. Used for the `dd_tables_file` parameter of the bridge games.
+void PreloadDoubleDummyTables(const std::string& path);
+
+}  // namespace bridge
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_DOUBLE_DUMMY_H_
@@ -12,7 +12,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/games/bridge.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
+#include "open_spiel/games/bridge/double_dummy.h"
 #include "open_spiel/games/bridge_uncontested_bidding.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -35,6 +48,125 @@ void BasicGameTests() {
   testing::RandomSimTest(*LoadGame("bridge_uncontested_bidding"), 3);
 }
 
+void BridgeGameTests() {
+  testing::LoadGameTest("bridge");
+  testing::RandomSimTest(*LoadGame("bridge"), 3);
+  testing::RandomSimTest(
+      *LoadGame("bridge", {{"use_double_dummy_result", GameParameter(false)}}),
+      3);
+}
+
+bool SameTables(const ddTableResults& a, const ddTableResults& b) {
+  return std::memcmp(a.resTable, b.resTable, sizeof(a.resTable)) == 0;
+}
+
+void BatchDoubleDummyTest() {
+  std::shared_ptr<const Game> game = LoadGame("bridge");
+  DoubleDummyCache* cache = GlobalDoubleDummyCache();
+  const int initial_cache_size = cache->size();
+
+  std::mt19937 rng(17);
+  std::vector<std::unique_ptr<State>> states;
+  std::vector<State*> state_ptrs;
+  for (int i = 0; i < 50; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (state->IsChanceNode()) {
+      const double z = std::uniform_real_distribution<double>()(rng);
+      state->ApplyAction(SampleAction(state->ChanceOutcomes(), z).first);
+    }
+    state_ptrs.push_back(state.get());
+    states.push_back(std::move(state));
+  }
+  // The same deal twice is only solved once.
+  std::unique_ptr<State> repeated = states[0]->Clone();
+  state_ptrs.push_back(repeated.get());
+  BatchComputeDoubleDummyTricks(state_ptrs);
+  SPIEL_CHECK_EQ(cache->size(), initial_cache_size + 50);
+
+  // The batch gives the same tables as solving each deal on its own. This
+  // test has not yet been run with the real double_dummy_solver.
+  for (const auto& state : states) {
+    const ddTableDeal deal =
+        static_cast<const BridgeState*>(state.get())->DoubleDummyDeal();
+    SPIEL_CHECK_TRUE(SameTables(cache->Solve(deal),
+                                SolveDoubleDummy({deal}).front()));
+  }
+
+  // Ending the auction uses the batched tables.
+  BridgeState* state = static_cast<BridgeState*>(states[1].get());
+  state->ApplyAction(state->LegalActions()[3]);  // The lowest bid.
+  for (int i = 0; i < 3; ++i) state->ApplyAction(kBiddingActionBase);
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  SPIEL_CHECK_EQ(cache->size(), initial_cache_size + 50);
+}
+
+void DoubleDummyDealKeyTest() {
+  ddTableDeal deal{};
+  for (int card = 0; card < kNumCards; ++card) {
+    deal.cards[card % kNumPlayers][card / kNumCardsPerSuit] +=
+        1 << (2 + card % kNumCardsPerSuit);
+  }
+  ddTableDeal swapped = deal;
+  // Swap the deuces of clubs and diamonds between the first two hands.
+  swapped.cards[0][0] -= 1 << 2;
+  swapped.cards[0][1] += 1 << 2;
+  swapped.cards[1][1] -= 1 << 2;
+  swapped.cards[1][0] += 1 << 2;
+  SPIEL_CHECK_EQ(DoubleDummyDealKey(deal), DoubleDummyDealKey(deal));
+  SPIEL_CHECK_NE(DoubleDummyDealKey(deal), DoubleDummyDealKey(swapped));
+}
+
+ddTableDeal RandomDeal(std::mt19937* rng) {
+  std::vector<int> cards(kNumCards);
+  std::iota(cards.begin(), cards.end(), 0);
+  std::shuffle(cards.begin(), cards.end(), *rng);
+  ddTableDeal deal{};
+  for (int i = 0; i < kNumCards; ++i) {
+    deal.cards[i % kNumPlayers][cards[i] / kNumCardsPerSuit] +=
+        1 << (2 + cards[i] % kNumCardsPerSuit);
+  }
+  return deal;
+}
+
+void DoubleDummyCacheTest() {
+  std::mt19937 rng(23);
+  std::vector<ddTableDeal> deals;
+  for (int i = 0; i < 4; ++i) deals.push_back(RandomDeal(&rng));
+
+  // Solving deals[0] again makes deals[1] the least recently used.
+  DoubleDummyCache cache(/*capacity=*/3);
+  cache.Solve(absl::MakeConstSpan(deals).subspan(0, 3));
+  cache.Solve(deals[0]);
+  cache.Solve(deals[3]);
+  SPIEL_CHECK_EQ(cache.size(), 3);
+
+  char dir_template[] = "/tmp/bridge_test_XXXXXX";
+  const std::string dir = mkdtemp(dir_template);
+  const std::string path = absl::StrCat(dir, "/dd_tables.bin");
+  cache.Save(path);
+  DoubleDummyCache loaded;
+  SPIEL_CHECK_EQ(loaded.Load(path), 3);
+  for (int i : {0, 2, 3}) {
+    SPIEL_CHECK_TRUE(
+        SameTables(loaded.Solve(deals[i]), SolveDoubleDummy({deals[i]})[0]));
+  }
+  SPIEL_CHECK_EQ(loaded.size(), 3);
+  loaded.Solve(deals[1]);
+  SPIEL_CHECK_EQ(loaded.size(), 4);
+  loaded.SetCapacity(2);
+  SPIEL_CHECK_EQ(loaded.size(), 2);
+
+  // Both bridge games preload the shared cache, once per file.
+  const int global_size = GlobalDoubleDummyCache()->size();
+  LoadGame("bridge", {{"dd_tables_file", GameParameter(path)}});
+  SPIEL_CHECK_EQ(GlobalDoubleDummyCache()->size(), global_size + 3);
+  LoadGame("bridge_uncontested_bidding",
+           {{"dd_tables_file", GameParameter(path)}});
+  SPIEL_CHECK_EQ(GlobalDoubleDummyCache()->size(), global_size + 3);
+  std::remove(path.c_str());
+  std::remove(dir.c_str());
+}
+
 void DeserializeStateTest() {
   auto game = LoadGame("bridge_uncontested_bidding");
   auto state = game->DeserializeState("AKQJ.543.QJ8.T92 97532.A2.9.QJ853");
@@ -49,4 +181,8 @@ int main(int argc, char** argv) {
   open_spiel::bridge::DeserializeStateTest();
   open_spiel::bridge::ScoringTests();
   open_spiel::bridge::BasicGameTests();
+  open_spiel::bridge::BridgeGameTests();
+  open_spiel::bridge::DoubleDummyDealKeyTest();
+  open_spiel::bridge::BatchDoubleDummyTest();
+  open_spiel::bridge::DoubleDummyCacheTest();
 }
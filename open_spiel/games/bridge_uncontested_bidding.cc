@@ -17,17 +17,12 @@
 #include <cstring>
 #include <memory>
 
-#include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
+#include "open_spiel/games/bridge/double_dummy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
-
-// For compatibility with versions of the double dummy solver code which
-// don't amend exported names.
-#ifndef DDS_EXTERNAL
-#define DDS_EXTERNAL(x) x
-#endif
+#include "open_spiel/utils/fingerprint.h"
 
 namespace open_spiel {
 namespace bridge_uncontested_bidding {
@@ -62,6 +57,9 @@ const GameType kGameType{
         {"subgame", GameParameter(static_cast<std::string>(""))},
         {"rng_seed", GameParameter(0)},
         {"relative_scoring", GameParameter(false)},
+        // If set, a file of precomputed double-dummy tables, in the format of
+        // bridge::DoubleDummyCache::Save, to preload.
+        {"dd_tables_file", GameParameter(static_cast<std::string>(""))},
     }};
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
@@ -185,11 +183,24 @@ std::string UncontestedBiddingState::InformationStateString(
                       AuctionString());
 }
 
+absl::uint128 UncontestedBiddingState::InformationStateFingerprint(
+    Player player) const {
+  Fingerprinter fingerprinter;
+  if (!dealt_) return fingerprinter.Fingerprint();
+  uint64_t hand = 0;
+  for (int i = player * 13; i < (player + 1) * 13; ++i) {
+    hand |= uint64_t{1} << deal_.Card(i);
+  }
+  fingerprinter.Add(hand);
+  for (const auto action : actions_) fingerprinter.Add(action);
+  return fingerprinter.Fingerprint();
+}
+
 void UncontestedBiddingState::InformationStateTensor(
-    Player player, std::vector<double>* values) const {
-  values->resize(kStateSize);
-  std::fill(values->begin(), values->end(), 0.);
-  auto ptr = values->begin();
+    Player player, absl::Span<float> values) const {
+  SPIEL_CHECK_EQ(values.size(), kStateSize);
+  std::fill(values.begin(), values.end(), 0.);
+  auto ptr = values.begin();
 
   for (int i = kNumCardsPerHand * player; i < kNumCardsPerHand * (1 + player);
        ++i) {
@@ -259,33 +270,23 @@ void UncontestedBiddingState::ScoreDeal() {
   reference_scores_.resize(reference_contracts_.size());
   std::fill(reference_scores_.begin(), reference_scores_.end(), 0);
 
-  // For each redeal
+  // Redeal North-South cards, then analyze all the deals in one batch.
+  std::vector<ddTableDeal> deals(kNumRedeals, dd_table_deal);
   for (int ideal = 0; ideal < kNumRedeals; ++ideal) {
     if (ideal > 0) deal_.Shuffle(&rng_, kNumCardsPerHand * 2, kNumCards);
-
-    // Populate (reshuffled) North-South cards
     for (int opponent = 0; opponent < kNumPlayers; ++opponent) {
-      std::fill(dd_table_deal.cards[1 + opponent * 2],
-                dd_table_deal.cards[1 + opponent * 2] + 4, 0);
       for (int i = kNumCardsPerHand * (2 + opponent);
            i < kNumCardsPerHand * (3 + opponent); ++i) {
-        dd_table_deal.cards[1 + opponent * 2][deal_.Suit(i)] +=
+        deals[ideal].cards[1 + opponent * 2][deal_.Suit(i)] +=
             1 << (2 + deal_.Rank(i));
       }
     }
+  }
+  const std::vector<ddTableResults> all_results =
+      bridge::GlobalDoubleDummyCache()->Solve(deals);
 
-    // Analyze the deal.
-    DDS_EXTERNAL(SetMaxThreads)(0);
-    struct ddTableResults results;
-    const int return_code = DDS_EXTERNAL(CalcDDtable)(dd_table_deal, &results);
-
-    // Check for errors.
-    if (return_code != RETURN_NO_FAULT) {
-      char error_message[80];
-      DDS_EXTERNAL(ErrorMessage)(return_code, error_message);
-      SpielFatalError(absl::StrCat("double_dummy_solver:", error_message));
-    }
-
+  // For each redeal
+  for (const ddTableResults& results : all_results) {
     // Compute the score and update the total.
     if (!passed_out) {
       const int declarer_tricks =
@@ -329,6 +330,10 @@ UncontestedBiddingGame::UncontestedBiddingGame(const GameParameters& params)
       forced_actions_{},
       deal_filter_{NoFilter},
       rng_seed_(ParameterValue<int>("rng_seed")) {
+  bridge::InitDoubleDummySolver();
+  const std::string dd_tables_file =
+      ParameterValue<std::string>("dd_tables_file");
+  if (!dd_tables_file.empty()) bridge::PreloadDoubleDummyTables(dd_tables_file);
   std::string subgame = ParameterValue<std::string>("subgame");
   if (subgame == "2NT") {
     deal_filter_ = Is2NTDeal;
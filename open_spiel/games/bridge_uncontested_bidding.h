@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_UNCONTESTED_BIDDING_H_
 
 #include <array>
+#include <atomic>
 
 // Uncontested bridge bidding. A two-player purely cooperative game.
 //
@@ -172,8 +173,9 @@ class UncontestedBiddingState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationStateString(Player player) const override;
+  absl::uint128 InformationStateFingerprint(Player player) const override;
   void InformationStateTensor(Player player,
-                              std::vector<double>* values) const override;
+                              absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
   std::vector<Action> LegalActions() const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
@@ -204,6 +206,12 @@ class UncontestedBiddingState : public State {
 class UncontestedBiddingGame : public Game {
  public:
   explicit UncontestedBiddingGame(const GameParameters& params);
+  UncontestedBiddingGame(const UncontestedBiddingGame& other)
+      : Game(other),
+        reference_contracts_(other.reference_contracts_),
+        forced_actions_(other.forced_actions_),
+        deal_filter_(other.deal_filter_),
+        rng_seed_(other.rng_seed_.load()) {}
   int NumDistinctActions() const override { return kNumActions; }
   std::unique_ptr<State> NewInitialState() const override {
     return std::unique_ptr<State>(new UncontestedBiddingState(
@@ -231,7 +239,9 @@ class UncontestedBiddingGame : public Game {
   std::vector<Contract> reference_contracts_;
   std::vector<Action> forced_actions_;
   std::function<bool(const Deal&)> deal_filter_;
-  mutable int rng_seed_;
+  // The seed of the next state. Atomic, as states may be created by several
+  // threads sharing the game.
+  mutable std::atomic<int> rng_seed_;
 };
 
 }  // namespace bridge_uncontested_bidding
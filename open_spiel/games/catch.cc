@@ -158,7 +158,7 @@ std::string CatchState::ObservationString(Player player) const {
 }
 
 void CatchState::ObservationTensor(Player player,
-                                   std::vector<double>* values) const {
+                                   absl::Span<float> values) const {
   SPIEL_CHECK_EQ(player, 0);
 
   TensorView<2> view(values, {num_rows_, num_columns_}, true);
@@ -169,16 +169,16 @@ void CatchState::ObservationTensor(Player player,
 }
 
 void CatchState::InformationStateTensor(Player player,
-                                        std::vector<double>* values) const {
+                                        absl::Span<float> values) const {
   SPIEL_CHECK_EQ(player, 0);
 
-  values->resize(num_columns_ + kNumActions * num_rows_);
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), num_columns_ + kNumActions * num_rows_);
+  std::fill(values.begin(), values.end(), 0.);
   if (initialized_) {
-    (*values)[ball_col_] = 1;
+    values[ball_col_] = 1;
     int offset = history_.size() - ball_row_ - 1;
     for (int i = 0; i < ball_row_; i++) {
-      (*values)[num_columns_ + i * kNumActions + history_[offset + i]] = 1;
+      values[num_columns_ + i * kNumActions + history_[offset + i]] = 1;
     }
   }
 }
@@ -14,6 +14,7 @@
 
 #include "open_spiel/games/chess.h"
 
+#include <algorithm>
 #include <optional>
 
 #include "open_spiel/games/chess/chess_board.h"
@@ -51,31 +52,36 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
 // Adds a plane to the information state vector corresponding to the presence
-// and absence of the given piece type and colour at each square.
+// and absence of the given piece type and colour at each square. Planes are
+// written at `*offset`, which is advanced past them.
 void AddPieceTypePlane(Color color, PieceType piece_type,
                        const StandardChessBoard& board,
-                       std::vector<double>* values) {
+                       absl::Span<float> values, int* offset) {
   for (int8_t y = 0; y < BoardSize(); ++y) {
     for (int8_t x = 0; x < BoardSize(); ++x) {
       Piece piece_on_board = board.at(Square{x, y});
-      values->push_back(piece_on_board.color == color &&
-                                piece_on_board.type == piece_type
-                            ? 1.0
-                            : 0.0);
+      values[(*offset)++] =
+          piece_on_board.color == color && piece_on_board.type == piece_type
+              ? 1.0
+              : 0.0;
     }
   }
 }
 
 // Adds a uniform scalar plane scaled with min and max.
 template <typename T>
-void AddScalarPlane(T val, T min, T max, std::vector<double>* values) {
+void AddScalarPlane(T val, T min, T max, absl::Span<float> values,
+                    int* offset) {
   double normalized_val = static_cast<double>(val - min) / (max - min);
-  values->insert(values->end(), BoardSize() * BoardSize(), normalized_val);
+  int plane_size = BoardSize() * BoardSize();
+  std::fill(values.begin() + *offset, values.begin() + *offset + plane_size,
+            normalized_val);
+  *offset += plane_size;
 }
 
 // Adds a binary scalar plane.
-void AddBinaryPlane(bool val, std::vector<double>* values) {
-  AddScalarPlane<int>(val ? 1 : 0, 0, 1, values);
+void AddBinaryPlane(bool val, absl::Span<float> values, int* offset) {
+  AddScalarPlane<int>(val ? 1 : 0, 0, 1, values, offset);
 }
 }  // namespace
 
@@ -113,6 +119,17 @@ std::vector<Action> ChessState::LegalActions() const {
   return actions;
 }
 
+void ChessState::LegalActionsMask(Player player,
+                                  absl::Span<uint8_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0);
+  if (IsTerminal() || player != CurrentPlayer()) return;
+  Board().GenerateLegalMoves([mask](const Move& move) -> bool {
+    mask[MoveToAction(move)] = 1;
+    return true;
+  });
+}
+
 std::string ChessState::ActionToString(Player player, Action action) const {
   Move move = ActionToMove(action);
   return move.ToSAN(Board());
@@ -134,51 +151,59 @@ std::string ChessState::ObservationString(Player player) const {
 }
 
 void ChessState::ObservationTensor(Player player,
-                                   std::vector<double>* values) const {
+                                   absl::Span<float> values) const {
   SPIEL_CHECK_NE(player, kChancePlayerId);
 
-  values->clear();
-  values->reserve(game_->ObservationTensorSize());
+  int offset = 0;
 
   // Piece cconfiguration.
   for (const auto& piece_type : kPieceTypes) {
-    AddPieceTypePlane(Color::kWhite, piece_type, Board(), values);
-    AddPieceTypePlane(Color::kBlack, piece_type, Board(), values);
+    AddPieceTypePlane(Color::kWhite, piece_type, Board(), values, &offset);
+    AddPieceTypePlane(Color::kBlack, piece_type, Board(), values, &offset);
   }
 
-  AddPieceTypePlane(Color::kEmpty, PieceType::kEmpty, Board(), values);
+  AddPieceTypePlane(Color::kEmpty, PieceType::kEmpty, Board(), values,
+                    &offset);
 
   const auto entry = repetitions_.find(Board().HashValue());
   SPIEL_CHECK_FALSE(entry == repetitions_.end());
   int repetitions = entry->second;
 
   // Num repetitions for the current board.
-  AddScalarPlane(repetitions, 1, 3, values);
+  AddScalarPlane(repetitions, 1, 3, values, &offset);
 
   // Side to play.
-  AddScalarPlane(ColorToPlayer(Board().ToPlay()), 0, 1, values);
+  AddScalarPlane(ColorToPlayer(Board().ToPlay()), 0, 1, values, &offset);
 
   // Irreversible move counter.
-  AddScalarPlane(Board().IrreversibleMoveCounter(), 0, 101, values);
+  AddScalarPlane(Board().IrreversibleMoveCounter(), 0, 101, values, &offset);
 
   // Castling rights.
   AddBinaryPlane(Board().CastlingRight(Color::kWhite, CastlingDirection::kLeft),
-                 values);
+                 values, &offset);
 
   AddBinaryPlane(
-      Board().CastlingRight(Color::kWhite, CastlingDirection::kRight), values);
+      Board().CastlingRight(Color::kWhite, CastlingDirection::kRight), values,
+      &offset);
 
   AddBinaryPlane(Board().CastlingRight(Color::kBlack, CastlingDirection::kLeft),
-                 values);
+                 values, &offset);
 
   AddBinaryPlane(
-      Board().CastlingRight(Color::kBlack, CastlingDirection::kRight), values);
+      Board().CastlingRight(Color::kBlack, CastlingDirection::kRight), values,
+      &offset);
+
+  SPIEL_CHECK_EQ(offset, values.size());
 }
 
 std::unique_ptr<State> ChessState::Clone() const {
   return std::unique_ptr<State>(new ChessState(*this));
 }
 
+bool ChessState::CloneInto(State* dst) const {
+  return CopyStateInto(*this, dst);
+}
+
 void ChessState::UndoAction(Player player, Action action) {
   // TODO: Make this fast by storing undo info in another stack.
   SPIEL_CHECK_GE(moves_history_.size(), 1);
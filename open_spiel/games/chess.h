@@ -182,6 +182,8 @@ class ChessState : public State {
     return IsTerminal() ? kTerminalPlayerId : ColorToPlayer(Board().ToPlay());
   }
   std::vector<Action> LegalActions() const override;
+  void LegalActionsMask(Player player,
+                        absl::Span<uint8_t> mask) const override;
   std::string ActionToString(Player player, Action action) const override;
   std::string ToString() const override;
 
@@ -193,8 +195,9 @@ class ChessState : public State {
 
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CloneInto(State* dst) const override;
   void UndoAction(Player player, Action action) override;
 
   // Current board.
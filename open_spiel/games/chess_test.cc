@@ -111,12 +111,12 @@ void UndoTests() {
             "rnbqkbnr/pppp1p1p/6P1/4p3/8/8/PPPPP1PP/RNBQKBNR b KQkq - 0 2");
 }
 
-double ValueAt(const std::vector<double>& v, const std::vector<int>& shape,
+double ValueAt(const std::vector<float>& v, const std::vector<int>& shape,
                int plane, int x, int y) {
   return v[plane * shape[1] * shape[2] + y * shape[2] + x];
 }
 
-double ValueAt(const std::vector<double>& v, const std::vector<int>& shape,
+double ValueAt(const std::vector<float>& v, const std::vector<int>& shape,
                int plane, const std::string& square) {
   Square sq = *SquareFromString(square);
   return ValueAt(v, shape, plane, sq.x, sq.y);
@@ -126,8 +126,9 @@ void ObservationTensorTests() {
   std::shared_ptr<const Game> game = LoadGame("chess");
   ChessState initial_state(game);
   auto shape = game->ObservationTensorShape();
-  std::vector<double> v;
-  initial_state.ObservationTensor(initial_state.CurrentPlayer(), &v);
+  std::vector<float> v(game->ObservationTensorSize());
+  initial_state.ObservationTensor(initial_state.CurrentPlayer(),
+                                  absl::MakeSpan(v));
 
   // For each piece type, check one square that's supposed to be occupied, and
   // one that isn't.
@@ -190,7 +191,8 @@ void ObservationTensorTests() {
   ApplySANMove("e5", &initial_state);
   ApplySANMove("Ke2", &initial_state);
 
-  initial_state.ObservationTensor(initial_state.CurrentPlayer(), &v);
+  initial_state.ObservationTensor(initial_state.CurrentPlayer(),
+                                  absl::MakeSpan(v));
   SPIEL_CHECK_EQ(v.size(), game->ObservationTensorSize());
 
   // Now it's black to move.
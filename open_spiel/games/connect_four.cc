@@ -115,6 +115,16 @@ std::vector<Action> ConnectFourState::LegalActions() const {
   return moves;
 }
 
+void ConnectFourState::LegalActionsMask(Player player,
+                                        absl::Span<uint8_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0);
+  if (IsTerminal() || player != CurrentPlayer()) return;
+  for (int col = 0; col < kCols; ++col) {
+    mask[col] = CellAt(kRows - 1, col) == CellState::kEmpty;
+  }
+}
+
 std::string ConnectFourState::ActionToString(Player player,
                                              Action action_id) const {
   return absl::StrCat(StateToString(PlayerToState(player)), action_id);
@@ -203,7 +213,7 @@ int PlayerRelative(CellState state, Player current) {
 }
 
 void ConnectFourState::ObservationTensor(Player player,
-                                         std::vector<double>* values) const {
+                                         absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -218,6 +228,10 @@ std::unique_ptr<State> ConnectFourState::Clone() const {
   return std::unique_ptr<State>(new ConnectFourState(*this));
 }
 
+bool ConnectFourState::CloneInto(State* dst) const {
+  return CopyStateInto(*this, dst);
+}
+
 std::string ConnectFourState::Serialize() const { return ToString(); }
 
 ConnectFourGame::ConnectFourGame(const GameParameters& params)
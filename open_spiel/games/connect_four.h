@@ -67,14 +67,17 @@ class ConnectFourState : public State {
 
   Player CurrentPlayer() const override;
   std::vector<Action> LegalActions() const override;
+  void LegalActionsMask(Player player,
+                        absl::Span<uint8_t> mask) const override;
   std::string ActionToString(Player player, Action action_id) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CloneInto(State* dst) const override;
   std::string Serialize() const override;
 
  protected:
@@ -507,7 +507,7 @@ int CoopBoxPushingState::ObservationPlane(std::pair<int, int> coord,
 }
 
 void CoopBoxPushingState::ObservationTensor(Player player,
-                                            std::vector<double>* values) const {
+                                            absl::Span<float> values) const {
   if (fully_observable_) {
     TensorView<3> view(values, {kCellStates, kRows, kCols}, true);
 
@@ -519,10 +519,10 @@ void CoopBoxPushingState::ObservationTensor(Player player,
       }
     }
   } else {
-    values->resize(kNumObservations);
-    std::fill(values->begin(), values->end(), 0);
+    SPIEL_CHECK_EQ(values.size(), kNumObservations);
+    std::fill(values.begin(), values.end(), 0);
     ObservationType obs = PartialObservation(player);
-    (*values)[obs] = 1;
+    values[obs] = 1;
   }
 }
 
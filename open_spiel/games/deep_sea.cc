@@ -144,22 +144,22 @@ std::string DeepSeaState::ObservationString(Player player) const {
 }
 
 void DeepSeaState::ObservationTensor(Player player,
-                                     std::vector<double>* values) const {
+                                     absl::Span<float> values) const {
   SPIEL_CHECK_EQ(player, 0);
-  std::fill(values->begin(), values->end(), 0.);
-  values->resize(size_ * size_);
+  SPIEL_CHECK_EQ(values.size(), size_ * size_);
+  std::fill(values.begin(), values.end(), 0.);
   if (player_row_ < size_ && player_col_ < size_)
-    (*values)[player_row_ * size_ + player_col_] = 1.0;
+    values[player_row_ * size_ + player_col_] = 1.0;
 }
 
 void DeepSeaState::InformationStateTensor(Player player,
-                                          std::vector<double>* values) const {
+                                          absl::Span<float> values) const {
   SPIEL_CHECK_EQ(player, 0);
-  values->resize(2 * size_);
-  std::fill(values->begin(), values->end(), -1);
+  SPIEL_CHECK_EQ(values.size(), 2 * size_);
+  std::fill(values.begin(), values.end(), -1);
   for (int i = 0; i < player_row_; i++) {
-    (*values)[2 * i] = history_[i];
-    (*values)[2 * i + 1] = direction_history_[i];
+    values[2 * i] = history_[i];
+    values[2 * i + 1] = direction_history_[i];
   }
 }
 
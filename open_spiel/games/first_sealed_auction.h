@@ -57,10 +57,10 @@ class FPSBAState : public State {
   std::unique_ptr<State> Clone() const override;
   std::string InformationStateString(Player player) const override;
   void InformationStateTensor(Player player,
-                              std::vector<double>* values) const override;
+                              absl::Span<float> values) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   ActionsAndProbs ChanceOutcomes() const override;
 
  protected:
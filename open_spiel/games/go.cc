@@ -14,6 +14,7 @@
 
 #include "open_spiel/games/go.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "open_spiel/game_parameters.h"
@@ -93,25 +94,25 @@ std::string GoState::InformationStateString(int player) const {
 
 std::string GoState::ObservationString(int player) const { return ToString(); }
 
-void GoState::ObservationTensor(int player, std::vector<double>* values) const {
+void GoState::ObservationTensor(int player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
   int num_cells = board_.board_size() * board_.board_size();
-  values->resize(num_cells * (CellStates() + 1));
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), num_cells * (CellStates() + 1));
+  std::fill(values.begin(), values.end(), 0.);
 
   // Add planes: black, white, empty.
   int cell = 0;
   for (GoPoint p : BoardPoints(board_.board_size())) {
     int color_val = static_cast<int>(board_.PointColor(p));
-    (*values)[num_cells * color_val + cell] = 1.0;
+    values[num_cells * color_val + cell] = 1.0;
     ++cell;
   }
   SPIEL_CHECK_EQ(cell, num_cells);
 
   // Add a fourth binary plane for komi (whether white is to play).
-  std::fill(values->begin() + (CellStates() * num_cells), values->end(),
+  std::fill(values.begin() + (CellStates() * num_cells), values.end(),
             (to_play_ == GoColor::kWhite ? 1.0 : 0.0));
 }
 
@@ -127,6 +128,16 @@ std::vector<Action> GoState::LegalActions() const {
   return actions;
 }
 
+void GoState::LegalActionsMask(Player player, absl::Span<uint8_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0);
+  if (IsTerminal() || player != CurrentPlayer()) return;
+  for (GoPoint p : BoardPoints(board_.board_size())) {
+    mask[p] = board_.IsLegalMove(p, to_play_);
+  }
+  mask[kPass] = 1;
+}
+
 std::string GoState::ActionToString(Player player, Action action) const {
   return absl::StrCat(GoColorToString(static_cast<GoColor>(player)), " ",
                       GoPointToString(action));
@@ -69,6 +69,8 @@ class GoState : public State {
     return IsTerminal() ? kTerminalPlayerId : ColorToPlayer(to_play_);
   }
   std::vector<Action> LegalActions() const override;
+  void LegalActionsMask(Player player,
+                        absl::Span<uint8_t> mask) const override;
   std::string ActionToString(Player player, Action action) const override;
   std::string ToString() const override;
 
@@ -80,7 +82,7 @@ class GoState : public State {
   // Four planes: black, white, empty, and a bias plane of bits indicating komi
   // (whether white is to play).
   void ObservationTensor(int player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
 
   std::vector<double> Returns() const override;
 
@@ -438,12 +438,11 @@ void GoofspielState::NextPlayer(int* count, Player* player) const {
 }
 
 void GoofspielState::InformationStateTensor(Player player,
-                                            std::vector<double>* values) const {
+                                            absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->clear();
-  values->reserve(game_->InformationStateTensorSize());
+  int offset = 0;
 
   // Point totals: one-hot vector encoding points, per player.
   Player p = player;
@@ -451,45 +450,45 @@ void GoofspielState::InformationStateTensor(Player player,
     // Cards numbered 1 .. K
     int max_points_slots = (num_cards_ * (num_cards_ + 1)) / 2 + 1;
     for (int i = 0; i < max_points_slots; ++i) {
-      values->push_back(i == points_[p] ? 1 : 0);
+      values[offset++] = i == points_[p] ? 1 : 0;
     }
   }
 
   if (impinfo_) {
     // Bit vector of observing player's hand.
     for (int c = 0; c < num_cards_; ++c) {
-      values->push_back(player_hands_[player][c] ? 1 : 0);
+      values[offset++] = player_hands_[player][c] ? 1 : 0;
     }
 
     // Sequence of who won each trick.
     for (int i = 0; i < win_sequence_.size(); ++i) {
       for (auto p = Player{0}; p < num_players_; ++p) {
-        values->push_back(win_sequence_[i] == p ? 1 : 0);
+        values[offset++] = win_sequence_[i] == p ? 1 : 0;
       }
     }
 
     // Padding for future tricks
     int future_tricks = num_cards_ - win_sequence_.size();
-    for (int i = 0; i < future_tricks * num_players_; ++i) values->push_back(0);
+    for (int i = 0; i < future_tricks * num_players_; ++i) values[offset++] = 0;
 
     // Point card sequence.
     for (int i = 0; i < point_card_sequence_.size(); ++i) {
       for (int j = 0; j < num_cards_; ++j) {
-        values->push_back(point_card_sequence_[i] == (j + 1) ? 1 : 0);
+        values[offset++] = point_card_sequence_[i] == (j + 1) ? 1 : 0;
       }
     }
 
     // Padding for future tricks
     future_tricks = num_cards_ - point_card_sequence_.size();
-    for (int i = 0; i < future_tricks * num_cards_; ++i) values->push_back(0);
+    for (int i = 0; i < future_tricks * num_cards_; ++i) values[offset++] = 0;
 
     // The observing player's action sequence.
     for (int i = 0; i < num_cards_; ++i) {
       for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(i < actions_history_.size() &&
-                                  actions_history_[i][player] == c
-                              ? 1
-                              : 0);
+        values[offset++] =
+            i < actions_history_.size() && actions_history_[i][player] == c
+                ? 1
+                : 0;
       }
     }
 
@@ -497,33 +496,32 @@ void GoofspielState::InformationStateTensor(Player player,
     // Point card sequence.
     for (int i = 0; i < point_card_sequence_.size(); ++i) {
       for (int j = 0; j < num_cards_; ++j) {
-        values->push_back(point_card_sequence_[i] == (j + 1) ? 1 : 0);
+        values[offset++] = point_card_sequence_[i] == (j + 1) ? 1 : 0;
       }
     }
 
     // Padding for future tricks
     int future_tricks = num_cards_ - point_card_sequence_.size();
-    for (int i = 0; i < future_tricks * num_cards_; ++i) values->push_back(0);
+    for (int i = 0; i < future_tricks * num_cards_; ++i) values[offset++] = 0;
 
     // Bit vectors encoding all players' hands.
     p = player;
     for (int n = 0; n < num_players_; NextPlayer(&n, &p)) {
       for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(player_hands_[p][c] ? 1 : 0);
+        values[offset++] = player_hands_[p][c] ? 1 : 0;
       }
     }
   }
 
-  SPIEL_CHECK_EQ(values->size(), game_->InformationStateTensorSize());
+  SPIEL_CHECK_EQ(offset, values.size());
 }
 
 void GoofspielState::ObservationTensor(Player player,
-                                       std::vector<double>* values) const {
+                                       absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->clear();
-  values->reserve(game_->ObservationTensorSize());
+  int offset = 0;
 
   // Perfect info case, show:
   //   - one-hot encoding the current point card
@@ -537,7 +535,7 @@ void GoofspielState::ObservationTensor(Player player,
 
   // Current point card.
   for (int i = 0; i < num_cards_; ++i) {
-    values->push_back(i == point_card_index_ ? 1.0 : 0.0);
+    values[offset++] = i == point_card_index_ ? 1.0 : 0.0;
   }
 
   // Point totals: one-hot vector encoding points, per player.
@@ -546,37 +544,37 @@ void GoofspielState::ObservationTensor(Player player,
     // Cards numbered 1 .. K
     int max_points_slots = (num_cards_ * (num_cards_ + 1)) / 2 + 1;
     for (int i = 0; i < max_points_slots; ++i) {
-      values->push_back(i == points_[p] ? 1 : 0);
+      values[offset++] = i == points_[p] ? 1 : 0;
     }
   }
 
   if (impinfo_) {
     // Bit vector of observing player's hand.
     for (int c = 0; c < num_cards_; ++c) {
-      values->push_back(player_hands_[player][c] ? 1 : 0);
+      values[offset++] = player_hands_[player][c] ? 1 : 0;
     }
 
     // Sequence of who won each trick.
     for (int i = 0; i < win_sequence_.size(); ++i) {
       for (auto p = Player{0}; p < num_players_; ++p) {
-        values->push_back(win_sequence_[i] == p ? 1 : 0);
+        values[offset++] = win_sequence_[i] == p ? 1 : 0;
       }
     }
 
     // Padding for future tricks
     int future_tricks = num_cards_ - win_sequence_.size();
-    for (int i = 0; i < future_tricks * num_players_; ++i) values->push_back(0);
+    for (int i = 0; i < future_tricks * num_players_; ++i) values[offset++] = 0;
   } else {
     // Bit vectors encoding all players' hands.
     p = player;
     for (int n = 0; n < num_players_; NextPlayer(&n, &p)) {
       for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(player_hands_[p][c] ? 1 : 0);
+        values[offset++] = player_hands_[p][c] ? 1 : 0;
       }
     }
   }
 
-  SPIEL_CHECK_EQ(values->size(), game_->ObservationTensorSize());
+  SPIEL_CHECK_EQ(offset, values.size());
 }
 
 std::unique_ptr<State> GoofspielState::Clone() const {
@@ -201,11 +201,11 @@ std::string OpenSpielHanabiState::ObservationString(Player player) const {
 }
 
 void OpenSpielHanabiState::ObservationTensor(
-    Player player, std::vector<double>* values) const {
+    Player player, absl::Span<float> values) const {
   auto obs = game_->Encoder().Encode(
       hanabi_learning_env::HanabiObservation(state_, player));
-  values->resize(obs.size());
-  for (int i = 0; i < obs.size(); ++i) values->at(i) = obs[i];
+  SPIEL_CHECK_EQ(values.size(), obs.size());
+  for (int i = 0; i < obs.size(); ++i) values.at(i) = obs[i];
 }
 
 std::unique_ptr<State> OpenSpielHanabiState::Clone() const {
@@ -296,7 +296,7 @@ int PlayerRelative(HavannahPlayer state, Player current) {
 }
 
 void HavannahState::ObservationTensor(Player player,
-                                      std::vector<double>* values) const {
+                                      absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
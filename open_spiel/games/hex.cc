@@ -195,6 +195,15 @@ std::vector<Action> HexState::LegalActions() const {
   return moves;
 }
 
+void HexState::LegalActionsMask(Player player, absl::Span<uint8_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0);
+  if (IsTerminal() || player != CurrentPlayer()) return;
+  for (int cell = 0; cell < board_.size(); ++cell) {
+    mask[cell] = board_[cell] == CellState::kEmpty;
+  }
+}
+
 std::string HexState::ActionToString(Player player, Action action_id) const {
   // This does not comply with the Hex Text Protocol
   // TODO(author8): Make compliant with HTP
@@ -262,7 +271,7 @@ std::string HexState::ObservationString(Player player) const {
 }
 
 void HexState::ObservationTensor(Player player,
-                                 std::vector<double>* values) const {
+                                 absl::Span<float> values) const {
   // TODO(author8): Make an option to not expose connection info
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
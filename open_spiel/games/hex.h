@@ -77,9 +77,11 @@ class HexState : public State {
   std::string InformationStateString(Player player) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
   std::vector<Action> LegalActions() const override;
+  void LegalActionsMask(Player player,
+                        absl::Span<uint8_t> mask) const override;
   CellState BoardAt(int cell) const { return board_[cell]; }
 
  protected:
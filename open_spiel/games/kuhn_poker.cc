@@ -19,8 +19,10 @@
 #include <string>
 #include <utility>
 
+#include "open_spiel/algorithms/public_tree_cfr.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/fingerprint.h"
 
 namespace open_spiel {
 namespace kuhn_poker {
@@ -52,6 +54,17 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 }
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
+
+// Each player holds one card and there is no board: the card is the hand.
+algorithms::PokerDecomposition Decomposition(const Game& game) {
+  algorithms::PokerDecomposition decomposition;
+  decomposition.hand_strength = [](uint64_t hole, uint64_t board) {
+    return __builtin_ctzll(hole);
+  };
+  return decomposition;
+}
+
+REGISTER_POKER_DECOMPOSITION(kGameType.short_name, Decomposition);
 }  // namespace
 
 KuhnState::KuhnState(std::shared_ptr<const Game> game)
@@ -179,6 +192,19 @@ std::string KuhnState::InformationStateString(Player player) const {
   return str;
 }
 
+absl::uint128 KuhnState::InformationStateFingerprint(Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  Fingerprinter fingerprinter;
+  if (history_.size() <= player) return fingerprinter.Fingerprint();
+  fingerprinter.Add(history_[player]);
+  for (int i = num_players_; i < history_.size(); ++i) {
+    fingerprinter.Add(history_[i]);
+  }
+  return fingerprinter.Fingerprint();
+}
+
 // Observation is card then contributions to the pot, e.g. 111
 std::string KuhnState::ObservationString(Player player) const {
   SPIEL_CHECK_GE(player, 0);
@@ -196,28 +222,28 @@ std::string KuhnState::ObservationString(Player player) const {
 }
 
 void KuhnState::InformationStateTensor(Player player,
-                                       std::vector<double>* values) const {
+                                       absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
   // Initialize the vector with zeroes.
-  values->resize(6 * num_players_ - 1);
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), 6 * num_players_ - 1);
+  std::fill(values.begin(), values.end(), 0.);
 
   // The current player
-  (*values)[player] = 1;
+  values[player] = 1;
 
   // The player's card, if one has been dealt.
-  if (history_.size() > player) (*values)[num_players_ + history_[player]] = 1;
+  if (history_.size() > player) values[num_players_ + history_[player]] = 1;
 
   // Betting sequence.
   for (int i = num_players_; i < history_.size(); ++i) {
-    (*values)[1 + 2 * i + history_[i]] = 1;
+    values[1 + 2 * i + history_[i]] = 1;
   }
 }
 
 void KuhnState::ObservationTensor(Player player,
-                                  std::vector<double>* values) const {
+                                  absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
   // The format is described in ObservationTensorShape
@@ -225,20 +251,20 @@ void KuhnState::ObservationTensor(Player player,
   // each player. These values are thus not normalized.
 
   // Initialize the vector with zeroes.
-  values->resize(3 * num_players_ + 1);
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), 3 * num_players_ + 1);
+  std::fill(values.begin(), values.end(), 0.);
 
   // The current player
-  (*values)[player] = 1;
+  values[player] = 1;
 
   // The player's card, if one has been dealt.
-  if (history_.size() > player) (*values)[num_players_ + history_[player]] = 1;
+  if (history_.size() > player) values[num_players_ + history_[player]] = 1;
 
   int offset = 2 * num_players_ + 1;
   // Adding the contribution of each players to the pot. These values are not
   // between 0 and 1.
   for (auto p = Player{0}; p < num_players_; p++) {
-    (*values)[offset + p] = ante_[p];
+    values[offset + p] = ante_[p];
   }
 }
 
@@ -246,6 +272,10 @@ std::unique_ptr<State> KuhnState::Clone() const {
   return std::unique_ptr<State>(new KuhnState(*this));
 }
 
+bool KuhnState::CloneInto(State* dst) const {
+  return CopyStateInto(*this, dst);
+}
+
 void KuhnState::UndoAction(Player player, Action move) {
   if (history_.size() <= num_players_) {
     // Undoing a deal move.
@@ -32,6 +32,8 @@ void BasicKuhnTests() {
     testing::RandomSimTest(
         *LoadGame("kuhn_poker", {{"players", GameParameter(players)}}), 100);
   }
+  testing::InformationStateFingerprintTest(
+      *LoadGame("kuhn_poker", {{"players", GameParameter(3)}}), 100);
 }
 
 void CountStates() {
@@ -468,7 +468,7 @@ int LaserTagState::observation_plane(int r, int c) const {
 }
 
 void LaserTagState::ObservationTensor(int player,
-                                      std::vector<double>* values) const {
+                                      absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -91,7 +91,7 @@ class LaserTagState : public SimMoveState {
     return ToString();
   }
   void ObservationTensor(int player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   int CurrentPlayer() const override {
     return IsTerminal() ? kTerminalPlayerId : cur_player_;
   }
@@ -21,8 +21,10 @@
 
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/algorithms/public_tree_cfr.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/fingerprint.h"
 
 namespace open_spiel {
 namespace leduc_poker {
@@ -52,6 +54,42 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+// The rank of a private card together with the public card; higher wins.
+int RankCards(int private_card, int public_card, int num_cards) {
+  int hand[] = {public_card, private_card};
+  // Put the lower card in slot 0, the higher in slot 1.
+  if (hand[0] > hand[1]) {
+    std::swap(hand[0], hand[1]);
+  }
+
+  // E.g. rank for two players:
+  // 0 J1, 1 J2, 2 Q1, 3 Q2, 4 K1, 5 K2.
+  if (hand[0] % 2 == 0 && hand[1] == hand[0] + 1) {
+    // Pair! Offset by deck_size_^2 to put higher than every singles combo.
+    return (num_cards * num_cards + hand[0]);
+  } else {
+    // Otherwise card value dominates. No high/low suit: only two suits, and
+    // given ordering above, dividing by gets the value (integer division
+    // intended.) This could lead to ties/draws and/or multiple winners.
+    return (hand[1] / 2) * num_cards + (hand[0] / 2);
+  }
+}
+
+// One private card each, ranked with the single public card. Before the
+// public card is dealt, only the value of the private card counts.
+algorithms::PokerDecomposition Decomposition(const Game& game) {
+  const int num_cards = (game.NumPlayers() + 1) * kNumSuits;
+  algorithms::PokerDecomposition decomposition;
+  decomposition.hand_strength = [num_cards](uint64_t hole, uint64_t board) {
+    const int private_card = __builtin_ctzll(hole);
+    if (board == 0) return private_card / kNumSuits;
+    return RankCards(private_card, __builtin_ctzll(board), num_cards);
+  };
+  return decomposition;
+}
+
+REGISTER_POKER_DECOMPOSITION(kGameType.short_name, Decomposition);
+
 }  // namespace
 LeducState::LeducState(std::shared_ptr<const Game> game)
     : State(game),
@@ -277,6 +315,21 @@ std::string LeducState::InformationStateString(Player player) const {
       public_card_, absl::StrJoin(round2_sequence_, " "));
 }
 
+// The pot and the players' money follow from the betting sequences, so only
+// the remaining fields of the information state string are hashed.
+absl::uint128 LeducState::InformationStateFingerprint(Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  Fingerprinter fingerprinter;
+  fingerprinter.Add(round_).Add(cur_player_);
+  fingerprinter.Add(private_cards_[player]).Add(public_card_);
+  fingerprinter.Add(round1_sequence_.size());
+  for (int action : round1_sequence_) fingerprinter.Add(action);
+  fingerprinter.Add(round2_sequence_.size());
+  for (int action : round2_sequence_) fingerprinter.Add(action);
+  return fingerprinter.Fingerprint();
+}
+
 // Observation is card then contribution of each players to the pot.
 std::string LeducState::ObservationString(Player player) const {
   SPIEL_CHECK_GE(player, 0);
@@ -303,12 +356,12 @@ std::string LeducState::ObservationString(Player player) const {
 }
 
 void LeducState::InformationStateTensor(Player player,
-                                        std::vector<double>* values) const {
+                                        absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->resize(game_->InformationStateTensorShape()[0]);
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), game_->InformationStateTensorShape()[0]);
+  std::fill(values.begin(), values.end(), 0.);
 
   // Layout of observation:
   //   my player number: num_players bits
@@ -320,16 +373,16 @@ void LeducState::InformationStateTensor(Player player,
   int offset = 0;
 
   // Mark who I am.
-  (*values)[player] = 1;
+  values[player] = 1;
   offset += num_players_;
 
   if (private_cards_[player] >= 0) {
-    (*values)[offset + private_cards_[player]] = 1;
+    values[offset + private_cards_[player]] = 1;
   }
   offset += deck_.size();
 
   if (public_card_ >= 0) {
-    (*values)[offset + public_card_] = 1;
+    values[offset + public_card_] = 1;
   }
   offset += deck_.size();
 
@@ -338,19 +391,19 @@ void LeducState::InformationStateTensor(Player player,
         (r == 1 ? round1_sequence_ : round2_sequence_);
 
     for (int i = 0; i < round_sequence.size(); ++i) {
-      SPIEL_CHECK_LT(offset + i + 1, values->size());
+      SPIEL_CHECK_LT(offset + i + 1, values.size());
       if (round_sequence[i] == ActionType::kCall) {
         // Encode call as 10.
-        (*values)[offset + (2 * i)] = 1;
-        (*values)[offset + (2 * i) + 1] = 0;
+        values[offset + (2 * i)] = 1;
+        values[offset + (2 * i) + 1] = 0;
       } else if (round_sequence[i] == ActionType::kRaise) {
         // Encode raise as 01.
-        (*values)[offset + (2 * i)] = 0;
-        (*values)[offset + (2 * i) + 1] = 1;
+        values[offset + (2 * i)] = 0;
+        values[offset + (2 * i) + 1] = 1;
       } else {
         // Encode fold as 00.
-        (*values)[offset + (2 * i)] = 0;
-        (*values)[offset + (2 * i) + 1] = 0;
+        values[offset + (2 * i)] = 0;
+        values[offset + (2 * i) + 1] = 0;
       }
     }
 
@@ -360,12 +413,12 @@ void LeducState::InformationStateTensor(Player player,
 }
 
 void LeducState::ObservationTensor(Player player,
-                                   std::vector<double>* values) const {
+                                   absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->resize(game_->ObservationTensorShape()[0]);
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), game_->ObservationTensorShape()[0]);
+  std::fill(values.begin(), values.end(), 0.);
 
   // Layout of observation:
   //   my player number: num_players bits
@@ -376,21 +429,21 @@ void LeducState::ObservationTensor(Player player,
   int offset = 0;
 
   // Mark who I am.
-  (*values)[player] = 1;
+  values[player] = 1;
   offset += num_players_;
 
   if (private_cards_[player] >= 0) {
-    (*values)[offset + private_cards_[player]] = 1;
+    values[offset + private_cards_[player]] = 1;
   }
   offset += deck_.size();
 
   if (public_card_ >= 0) {
-    (*values)[offset + public_card_] = 1;
+    values[offset + public_card_] = 1;
   }
   offset += deck_.size();
   // Adding the contribution of each players to the pot.
   for (auto p = Player{0}; p < num_players_; p++) {
-    (*values)[offset + p] = ante_[p];
+    values[offset + p] = ante_[p];
   }
 }
 
@@ -398,6 +451,10 @@ std::unique_ptr<State> LeducState::Clone() const {
   return std::unique_ptr<State>(new LeducState(*this));
 }
 
+bool LeducState::CloneInto(State* dst) const {
+  return CopyStateInto(*this, dst);
+}
+
 std::vector<std::pair<Action, double>> LeducState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
   std::vector<std::pair<Action, double>> outcomes;
@@ -433,25 +490,7 @@ int LeducState::NextPlayer() const {
 }
 
 int LeducState::RankHand(Player player) const {
-  int hand[] = {public_card_, private_cards_[player]};
-  // Put the lower card in slot 0, the higher in slot 1.
-  if (hand[0] > hand[1]) {
-    std::swap(hand[0], hand[1]);
-  }
-
-  // E.g. rank for two players:
-  // 0 J1, 1 J2, 2 Q1, 3 Q2, 4 K1, 5 K2.
-  int num_cards = deck_.size();
-
-  if (hand[0] % 2 == 0 && hand[1] == hand[0] + 1) {
-    // Pair! Offset by deck_size_^2 to put higher than every singles combo.
-    return (num_cards * num_cards + hand[0]);
-  } else {
-    // Otherwise card value dominates. No high/low suit: only two suits, and
-    // given ordering above, dividing by gets the value (integer division
-    // intended.) This could lead to ties/draws and/or multiple winners.
-    return (hand[1] / 2) * num_cards + (hand[0] / 2);
-  }
+  return RankCards(private_cards_[player], public_card_, deck_.size());
 }
 
 void LeducState::ResolveWinner() {
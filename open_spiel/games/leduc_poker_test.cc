@@ -30,6 +30,8 @@ void BasicLeducTests() {
         *LoadGame("leduc_poker", {{"players", GameParameter(players)}}), 100);
   }
   testing::ResampleInfostateTest(*LoadGame("leduc_poker"), /*num_sims=*/100);
+  testing::InformationStateFingerprintTest(*LoadGame("leduc_poker"),
+                                           /*num_sims=*/1000);
 }
 
 }  // namespace
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "open_spiel/game_parameters.h"
+#include "open_spiel/utils/fingerprint.h"
 
 namespace open_spiel {
 namespace liars_dice {
@@ -218,6 +219,19 @@ std::vector<std::pair<Action, double>> LiarsDiceState::ChanceOutcomes() const {
   return outcomes;
 }
 
+std::unique_ptr<State> LiarsDiceState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  std::unique_ptr<State> state = game_->NewInitialState();
+  const auto& world = static_cast<const LiarsDiceState&>(*state);
+  for (Action action : history_) {
+    if (world.IsChanceNode() && world.cur_roller_ != player_id) {
+      action = SampleAction(world.ChanceOutcomes(), rng()).first;
+    }
+    state->ApplyAction(action);
+  }
+  return state;
+}
+
 std::string LiarsDiceState::InformationStateString(Player player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
@@ -234,6 +248,18 @@ std::string LiarsDiceState::InformationStateString(Player player) const {
   return result;
 }
 
+absl::uint128 LiarsDiceState::InformationStateFingerprint(
+    Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  Fingerprinter fingerprinter;
+  fingerprinter.Add(dice_outcomes_[player].size());
+  for (int outcome : dice_outcomes_[player]) fingerprinter.Add(outcome);
+  for (int bid : bidseq_) fingerprinter.Add(bid);
+  return fingerprinter.Fingerprint();
+}
+
 std::string LiarsDiceState::ToString() const {
   std::string result = "";
 
@@ -277,7 +303,7 @@ std::vector<double> LiarsDiceState::Returns() const {
 }
 
 void LiarsDiceState::InformationStateTensor(Player player,
-                                            std::vector<double>* values) const {
+                                            absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -287,10 +313,11 @@ void LiarsDiceState::InformationStateTensor(Player player,
   // One slot(bit) for calling liar. (Necessary because observations and
   // information states need to be defined at terminals)
   int offset = 0;
-  std::fill(values->begin(), values->end(), 0.);
-  values->resize(num_players_ + (max_dice_per_player_ * kDiceSides) +
-                 (total_num_dice_ * kDiceSides) + 1);
-  (*values)[player] = 1;
+  SPIEL_CHECK_EQ(values.size(), num_players_ +
+                                     (max_dice_per_player_ * kDiceSides) +
+                                     (total_num_dice_ * kDiceSides) + 1);
+  std::fill(values.begin(), values.end(), 0.);
+  values[player] = 1;
   offset += num_players_;
 
   int my_num_dice = num_dice_[player];
@@ -300,7 +327,7 @@ void LiarsDiceState::InformationStateTensor(Player player,
     if (outcome != kInvalidOutcome) {
       SPIEL_CHECK_GE(outcome, 1);
       SPIEL_CHECK_LE(outcome, kDiceSides);
-      (*values)[offset + (outcome - 1)] = 1;
+      values[offset + (outcome - 1)] = 1;
     }
     offset += kDiceSides;
   }
@@ -312,12 +339,12 @@ void LiarsDiceState::InformationStateTensor(Player player,
   for (int b = 0; b < bidseq_.size(); b++) {
     SPIEL_CHECK_GE(bidseq_[b], 0);
     SPIEL_CHECK_LE(bidseq_[b], total_num_dice_ * kDiceSides);
-    (*values)[offset + bidseq_[b]] = 1;
+    values[offset + bidseq_[b]] = 1;
   }
 }
 
 void LiarsDiceState::ObservationTensor(
-    Player player, std::vector<double>* values) const {
+    Player player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -327,10 +354,11 @@ void LiarsDiceState::ObservationTensor(
   // One slot(bit) for calling liar. (Necessary because observations and
   // information states need to be defined at terminals)
   int offset = 0;
-  std::fill(values->begin(), values->end(), 0.);
-  values->resize(num_players_ + (max_dice_per_player_ * kDiceSides) +
-                 (total_num_dice_ * kDiceSides) + 1);
-  (*values)[player] = 1;
+  SPIEL_CHECK_EQ(values.size(), num_players_ +
+                                     (max_dice_per_player_ * kDiceSides) +
+                                     (total_num_dice_ * kDiceSides) + 1);
+  std::fill(values.begin(), values.end(), 0.);
+  values[player] = 1;
   offset += num_players_;
 
   int my_num_dice = num_dice_[player];
@@ -340,7 +368,7 @@ void LiarsDiceState::ObservationTensor(
     if (outcome != kInvalidOutcome) {
       SPIEL_CHECK_GE(outcome, 1);
       SPIEL_CHECK_LE(outcome, kDiceSides);
-      (*values)[offset + (outcome - 1)] = 1;
+      values[offset + (outcome - 1)] = 1;
     }
     offset += kDiceSides;
   }
@@ -355,7 +383,7 @@ void LiarsDiceState::ObservationTensor(
   for (int b = bid_offset; b < size_bid; b++) {
     SPIEL_CHECK_GE(bidseq_[b], 0);
     SPIEL_CHECK_LE(bidseq_[b], total_num_dice_ * kDiceSides);
-    (*values)[offset + bidseq_[b]] = 1;
+    values[offset + bidseq_[b]] = 1;
   }
 }
 
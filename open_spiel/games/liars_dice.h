@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_LIARS_DICE_H_
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -51,13 +52,17 @@ class LiarsDiceState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationStateString(Player player) const override;
+  absl::uint128 InformationStateFingerprint(Player player) const override;
   void InformationStateTensor(
-      Player player, std::vector<double>* values) const override;
+      Player player, absl::Span<float> values) const override;
   void ObservationTensor(
-      Player player, std::vector<double>* values) const override;
+      Player player, absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
   std::vector<Action> LegalActions() const override;
+  // Rerolls the dice of the other players.
+  std::unique_ptr<State> ResampleFromInfostate(
+      int player_id, std::function<double()> rng) const override;
 
  protected:
   void DoApplyAction(Action action_id) override;
@@ -25,6 +25,8 @@ void BasicLiarsDiceTests() {
   testing::LoadGameTest("liars_dice");
   testing::ChanceOutcomesTest(*LoadGame("liars_dice"));
   testing::RandomSimTest(*LoadGame("liars_dice"), 100);
+  testing::InformationStateFingerprintTest(*LoadGame("liars_dice"), 1000);
+  testing::ResampleInfostateTest(*LoadGame("liars_dice"), /*num_sims=*/100);
 }
 
 }  // namespace
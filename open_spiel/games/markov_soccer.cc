@@ -347,7 +347,7 @@ int MarkovSoccerState::observation_plane(int r, int c) const {
 }
 
 void MarkovSoccerState::ObservationTensor(Player player,
-                                          std::vector<double>* values) const {
+                                          absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
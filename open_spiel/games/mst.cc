@@ -15,13 +15,18 @@
 #include "open_spiel/games/mst.h"
 
 #include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <utility>
 #include <vector>
 #include <list>
 
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
 #include "open_spiel/spiel_utils.h"
-#include "open_spiel/tensor_view.h"
+#include "open_spiel/utils/tensor_view.h"
 
 namespace open_spiel {
 namespace mst {
@@ -44,7 +49,13 @@ const GameType kGameType{
     /*provides_observation_as_normalized_vector=*/true,
     /*parameter_specification=*/
     {{"num_nodes", GameParameter(kNumNodes)},
-     {"weights", GameParameter(std::string(kWeights))}}
+     {"weights", GameParameter(std::string(kWeights))},
+     {"shaped_rewards", GameParameter(kDefaultShapedRewards)},
+     {"generator", GameParameter(std::string(kDefaultGenerator))},
+     {"seed", GameParameter(kDefaultSeed)},
+     {"num_clusters", GameParameter(kDefaultNumClusters)},
+     {"weights_file", GameParameter(std::string(kDefaultWeightsFile))},
+     {"instance", GameParameter(kDefaultInstance)}}
    };
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
@@ -53,8 +64,159 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+// Minimal disjoint-set forest used by Kruskal's algorithm.
+class DisjointSets {
+ public:
+  explicit DisjointSets(std::vector<int> parent) : parent_(std::move(parent)) {}
+
+  int Find(int node) {
+    while (parent_[node] != node) {
+      parent_[node] = parent_[parent_[node]];
+      node = parent_[node];
+    }
+    return node;
+  }
+
+  // Returns false if both nodes were already in the same set.
+  bool Union(int a, int b) {
+    a = Find(a);
+    b = Find(b);
+    if (a == b) return false;
+    parent_[b] = a;
+    return true;
+  }
+
+ private:
+  std::vector<int> parent_;
+};
+
+// Runs Kruskal's algorithm over `sorted_edges`, starting from the partition
+// given by `parent`, and returns the cost of the added edges. If `tree` is
+// not null, the added edges are appended to it.
+double KruskalCost(const std::vector<Action>& sorted_edges,
+                   const std::vector<float>& weights, int num_nodes,
+                   int num_components, std::vector<int> parent,
+                   std::vector<Action>* tree) {
+  DisjointSets sets(std::move(parent));
+  double cost = 0;
+  for (Action edge : sorted_edges) {
+    if (num_components <= 1) break;
+    if (sets.Union(edge / num_nodes, edge % num_nodes)) {
+      cost += weights[edge];
+      --num_components;
+      if (tree != nullptr) tree->push_back(edge);
+    }
+  }
+  return cost;
+}
+
+// Pairwise Euclidean distances between points given as (x, y) pairs.
+std::vector<float> DistanceMatrix(const std::vector<std::pair<double, double>>&
+                                      points) {
+  int num_nodes = points.size();
+  std::vector<float> weights(num_nodes * num_nodes, 0.0);
+  for (int r = 0; r < num_nodes; ++r) {
+    for (int c = r + 1; c < num_nodes; ++c) {
+      float distance = std::hypot(points[r].first - points[c].first,
+                                  points[r].second - points[c].second);
+      weights[r * num_nodes + c] = distance;
+      weights[c * num_nodes + r] = distance;
+    }
+  }
+  return weights;
+}
+
+std::vector<float> WeightsFromParameters(
+    int num_nodes, const std::string& weights_file, int instance,
+    const std::string& generator, int seed, int num_clusters,
+    const std::string& weights) {
+  if (!weights_file.empty()) {
+    return ReadWeightsFile(weights_file, num_nodes, instance);
+  } else if (generator == "euclidean") {
+    return EuclideanWeights(num_nodes, seed);
+  } else if (generator == "uniform") {
+    return UniformWeights(num_nodes, seed);
+  } else if (generator == "clustered") {
+    return ClusteredWeights(num_nodes, num_clusters, seed);
+  } else if (!generator.empty()) {
+    SpielFatalError(absl::StrCat("Unknown MST generator: ", generator));
+  }
+  return ParseWeights(weights);
+}
+
 }  // namespace
 
+std::vector<float> EuclideanWeights(int num_nodes, int seed) {
+  std::seed_seq seq{seed};
+  std::mt19937 rng(seq);
+  std::vector<std::pair<double, double>> points(num_nodes);
+  for (auto& point : points) {
+    point.first = absl::Uniform<double>(rng, 0.0, 1.0);
+    point.second = absl::Uniform<double>(rng, 0.0, 1.0);
+  }
+  return DistanceMatrix(points);
+}
+
+std::vector<float> UniformWeights(int num_nodes, int seed) {
+  std::seed_seq seq{seed};
+  std::mt19937 rng(seq);
+  std::vector<float> weights(num_nodes * num_nodes, 0.0);
+  for (int r = 0; r < num_nodes; ++r) {
+    for (int c = r + 1; c < num_nodes; ++c) {
+      float weight = absl::Uniform<float>(rng, 0.0, 1.0);
+      weights[r * num_nodes + c] = weight;
+      weights[c * num_nodes + r] = weight;
+    }
+  }
+  return weights;
+}
+
+std::vector<float> ClusteredWeights(int num_nodes, int num_clusters,
+                                    int seed) {
+  SPIEL_CHECK_GT(num_clusters, 0);
+  std::seed_seq seq{seed};
+  std::mt19937 rng(seq);
+  std::vector<std::pair<double, double>> centres(num_clusters);
+  for (auto& centre : centres) {
+    centre.first = absl::Uniform<double>(rng, 0.0, 1.0);
+    centre.second = absl::Uniform<double>(rng, 0.0, 1.0);
+  }
+  std::vector<std::pair<double, double>> points(num_nodes);
+  for (auto& point : points) {
+    const auto& centre = centres[absl::Uniform<int>(rng, 0, num_clusters)];
+    point.first = absl::Gaussian<double>(rng, centre.first, kClusterStddev);
+    point.second = absl::Gaussian<double>(rng, centre.second, kClusterStddev);
+  }
+  return DistanceMatrix(points);
+}
+
+std::vector<float> ReadWeightsFile(const std::string& path, int num_nodes,
+                                   int instance) {
+  SPIEL_CHECK_GE(instance, 0);
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Could not open MST weights file: ", path));
+  }
+  const std::streamoff matrix_bytes =
+      static_cast<std::streamoff>(num_nodes) * num_nodes * sizeof(float);
+  std::vector<float> weights(num_nodes * num_nodes);
+  file.seekg(matrix_bytes * instance);
+  file.read(reinterpret_cast<char*>(weights.data()), matrix_bytes);
+  if (file.gcount() != matrix_bytes) {
+    SpielFatalError(absl::StrCat("MST weights file ", path,
+                                 " does not contain instance ", instance,
+                                 " for ", num_nodes, " nodes."));
+  }
+  return weights;
+}
+
+std::shared_ptr<const Game> LoadGameWithWeights(std::vector<float> weights,
+                                                GameParameters params) {
+  int num_nodes = std::round(std::sqrt(weights.size()));
+  params["num_nodes"] = GameParameter(num_nodes);
+  return std::shared_ptr<const Game>(new MstGame(params, std::move(weights)));
+}
+
 EdgeState PlayerToState(Player player) {
   switch (player) {
     case -1:
@@ -97,6 +259,7 @@ std::vector<float> ParseWeights(std::string values){
 
 void MstState::DoApplyAction(Action move) {
   SPIEL_CHECK_EQ(adjMat_[move], EdgeState::kAvailable);
+  SPIEL_CHECK_TRUE(ValidEdge(move));
   int row = move / num_nodes_;
   int col = move % num_nodes_;
 
@@ -104,8 +267,15 @@ void MstState::DoApplyAction(Action move) {
   adjMat_[col * num_nodes_ + row] = EdgeState::kConnected;
 
   AddEdge(move); //adds the edge to the adj_list
+  MergeComponents(row, col);
 
   reward_ = -weights_[move];
+  if (static_cast<const MstGame&>(*game_).ShapedRewards()) {
+    double remaining = RemainingOptimalCost();
+    reward_ += remaining_optimal_cost_ - remaining;
+    remaining_optimal_cost_ = remaining;
+  }
+  move_rewards_.push_back(reward_);
   total_rewards_ += reward_;
   num_moves_ += 1;
 }
@@ -113,15 +283,27 @@ void MstState::DoApplyAction(Action move) {
 std::vector<Action> MstState::LegalActions() const {
   if (IsTerminal()) return {};
   // Choose edges where value in adjacency matrix is kAvailable '0'.
+  // legal_edges_ only holds available edges between different components, so
+  // no cycle check is needed here.
   std::vector<Action> moves;
+  moves.reserve(num_legal_edges_);
   for (int edge = 0; edge < num_edges_; ++edge) {
-    if (adjMat_[edge] == EdgeState::kAvailable && ValidEdge(edge)) {
+    if (legal_edges_[edge]) {
       moves.push_back(edge);
     }
   }
   return moves;
 }
 
+void MstState::LegalActionsMask(Player player, absl::Span<uint8_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0);
+  if (IsTerminal() || player != CurrentPlayer()) return;
+  for (int edge = 0; edge < num_edges_; ++edge) {
+    mask[edge] = legal_edges_[edge];
+  }
+}
+
 std::string MstState::ActionToString(Player player,
                                            Action action_id) const {
   return absl::StrCat(StateToString(PlayerToState(player)), "(",
@@ -160,73 +342,83 @@ void MstState::RemoveEdge(int edge) const{
 }
 */
 bool MstState::HasNMinus1Edges() const {
-  int edgeCount = 0;
-  for (int cell = 0; cell < num_edges_; ++cell) {
-    if (adjMat_[cell] == EdgeState::kConnected) {
-      edgeCount += 1;
-    }
-  }
-  return edgeCount == 2*(num_nodes_ - 1); // matrix is symmetric (so need 2(n-1) edges)
+  // Every move joins two components, so the chosen edges form a forest and
+  // there are exactly n-1 of them once a single component is left.
+  return num_moves_ == num_nodes_ - 1;
 }
 
 bool MstState::IsConnected() const {
-  int rowCount = 0;
-  for (int r = 0; r < num_nodes_; ++r) {
-    for (int c = 0; c < num_nodes_; ++c) {
-      if (AdjMatAt(r, c) == EdgeState::kConnected){ //adjMat_[row * num_nodes_ + column]
-        rowCount += 1;
-        break;
+  return num_components_ == 1;
+}
+
+void MstState::SetCrossEdgesLegal(int component_a, int component_b,
+                                  bool legal) {
+  for (int u : component_members_[component_a]) {
+    for (int v : component_members_[component_b]) {
+      int edge = u * num_nodes_ + v;
+      int reverse_edge = v * num_nodes_ + u;
+      if (legal) {
+        if (adjMat_[edge] != EdgeState::kAvailable) continue;
+        legal_edges_[edge] = true;
+        legal_edges_[reverse_edge] = true;
+        num_legal_edges_ += 2;
+      } else if (legal_edges_[edge]) {
+        legal_edges_[edge] = false;
+        legal_edges_[reverse_edge] = false;
+        num_legal_edges_ -= 2;
       }
     }
-    if (rowCount == 0){
-      return false;
-    }
-    rowCount = 0;
   }
-  return true;
 }
 
-bool MstState::IsCyclic(int v, bool visited[], int parent) const{
-  // Mark the current node as visited 
-  visited[v] = true; 
+void MstState::MergeComponents(int row, int column) {
+  int kept = component_[row];
+  int absorbed = component_[column];
+  SPIEL_CHECK_NE(kept, absorbed);
+  if (component_members_[kept].size() < component_members_[absorbed].size()) {
+    std::swap(kept, absorbed);
+  }
 
-  // Recur for all the vertices adjacent to this vertex 
-  //std::vector<int>::iterator i; 
-  //for (i = adjList_[v].begin(); i != adjList_[v].end(); ++i) 
-  for(int i=0; i<adjList_[v].size(); ++i)
-  {
-    int u = adjList_[v][i];
-    // If an adjacent is not visited, then recur for that adjacent 
-    if (!visited[u]) 
-    { 
-    if (IsCyclic(u, visited, v)) 
-      return true; 
-    } 
-
-    // If an adjacent is visited and not parent of current vertex, 
-    // then there is a cycle. 
-    else if (u != parent) 
-    return true; 
-  } 
-  return false; 
-} 
-
-bool MstState::HasCycle(int r, int c) const{
-  bool visited[num_nodes_];
-  for (int i = 0; i < num_nodes_; i++) 
-      visited[i] = false;
-  visited[r] = true;
-
-  if (IsCyclic(c, visited, r)){
-    return true; 
-  } 
-  return false; 
+  // Any edge between the two components would now close a cycle.
+  SetCrossEdgesLegal(kept, absorbed, false);
+
+  // The absorbed member list is left untouched so that the merge can be
+  // undone by truncating the kept list.
+  for (int node : component_members_[absorbed]) {
+    component_[node] = kept;
+    component_members_[kept].push_back(node);
+  }
+  merges_.push_back({kept, absorbed});
+  --num_components_;
+}
+
+void MstState::SplitLastMerge() {
+  SPIEL_CHECK_FALSE(merges_.empty());
+  const auto [kept, absorbed] = merges_.back();
+  merges_.pop_back();
+
+  std::vector<int>& kept_members = component_members_[kept];
+  kept_members.resize(kept_members.size() -
+                      component_members_[absorbed].size());
+  for (int node : component_members_[absorbed]) {
+    component_[node] = absorbed;
+  }
+  ++num_components_;
+
+  SetCrossEdgesLegal(kept, absorbed, true);
+}
+
+double MstState::RemainingOptimalCost() const {
+  const auto& game = static_cast<const MstGame&>(*game_);
+  // component_ already maps each node to a root of its component.
+  return KruskalCost(game.SortedEdges(), weights_, num_nodes_,
+                     num_components_, component_, /*tree=*/nullptr);
 }
 
 bool MstState::ValidEdge(int edge) const{
     int eRow = edge / num_nodes_;
     int eCol = edge % num_nodes_;
-    return not HasCycle(eRow, eCol);
+    return component_[eRow] != component_[eCol];
 }
 
 // Only set the diagonals to kEmpty --> no self-loops
@@ -236,7 +428,12 @@ MstState::MstState(std::shared_ptr<const Game> game, int num_nodes, std::vector<
   weights_(weights),
   num_edges_(num_nodes * num_nodes),
   adjMat_(std::vector<EdgeState>(num_nodes * num_nodes, EdgeState::kAvailable)),
-  adjList_(std::vector<std::vector<int>>(num_nodes)) {
+  adjList_(std::vector<std::vector<int>>(num_nodes)),
+  component_(num_nodes),
+  component_members_(num_nodes),
+  num_components_(num_nodes),
+  legal_edges_(num_nodes * num_nodes, true),
+  num_legal_edges_(num_nodes * (num_nodes - 1)) {
   //const MstGame& parent_game = static_cast<const MstGame&>(*game);
   //num_nodes_ = parent_game.NumNodes();
   //weights_ = parent_game.EdgeWeights();
@@ -255,6 +452,13 @@ MstState::MstState(std::shared_ptr<const Game> game, int num_nodes, std::vector<
       //adjMat_[r * num_nodes_ + c] = EdgeState::kAvailable;
     //}
     adjMat_[r * num_nodes_ + r] = EdgeState::kEmpty; // set diagonal to empty
+    legal_edges_[r * num_nodes_ + r] = false;
+    component_[r] = r;
+    component_members_[r].push_back(r);
+  }
+  if (static_cast<const MstGame&>(*game_).ShapedRewards()) {
+    remaining_optimal_cost_ =
+        static_cast<const MstGame&>(*game_).OptimalCost();
   }
 }
 
@@ -300,7 +504,7 @@ std::string MstState::ObservationString(Player player) const {
 }
 
 void MstState::ObservationTensor(
-    Player player, std::vector<double>* values) const {
+    Player player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -312,12 +516,23 @@ void MstState::ObservationTensor(
 }
 
 void MstState::UndoAction(Player player, Action move) {
+  int row = move / num_nodes_;
+  int col = move % num_nodes_;
   adjMat_[move] = EdgeState::kAvailable;
-  //RemoveEdge(move);
+  adjMat_[col * num_nodes_ + row] = EdgeState::kAvailable;
+  adjList_[row].pop_back();
+  adjList_[col].pop_back();
+  SplitLastMerge();
+  total_rewards_ -= move_rewards_.back();
+  move_rewards_.pop_back();
+  if (static_cast<const MstGame&>(*game_).ShapedRewards()) {
+    remaining_optimal_cost_ = RemainingOptimalCost();
+  }
   current_player_ = player;
   outcome_ = kInvalidPlayer;
   num_moves_ -= 1;
   history_.pop_back();
+  reward_ = move_rewards_.empty() ? 0 : move_rewards_.back();
 }
 
 std::unique_ptr<State> MstState::Clone() const {
@@ -327,8 +542,64 @@ std::unique_ptr<State> MstState::Clone() const {
 MstGame::MstGame(const GameParameters& params)
     : Game(kGameType, params),
       num_nodes_(ParameterValue<int>("num_nodes")),
-      edge_weights_(ParseWeights(ParameterValue<std::string>("weights")))
-    {}
+      shaped_rewards_(ParameterValue<bool>("shaped_rewards")) {
+  edge_weights_ = WeightsFromParameters(
+      num_nodes_, ParameterValue<std::string>("weights_file"),
+      ParameterValue<int>("instance"), ParameterValue<std::string>("generator"),
+      ParameterValue<int>("seed"), ParameterValue<int>("num_clusters"),
+      ParameterValue<std::string>("weights"));
+  SPIEL_CHECK_EQ(edge_weights_.size(), num_nodes_ * num_nodes_);
+  ComputeOptimalTree();
+}
+
+MstGame::MstGame(const GameParameters& params, std::vector<float> weights)
+    : Game(kGameType, params),
+      num_nodes_(ParameterValue<int>("num_nodes")),
+      edge_weights_(std::move(weights)),
+      shaped_rewards_(ParameterValue<bool>("shaped_rewards")) {
+  SPIEL_CHECK_EQ(edge_weights_.size(), num_nodes_ * num_nodes_);
+  ComputeOptimalTree();
+}
+
+void MstGame::ComputeOptimalTree() {
+  sorted_edges_.clear();
+  for (int r = 0; r < num_nodes_; ++r) {
+    for (int c = r + 1; c < num_nodes_; ++c) {
+      Action edge = r * num_nodes_ + c;
+      Action reverse_edge = c * num_nodes_ + r;
+      sorted_edges_.push_back(
+          edge_weights_[reverse_edge] < edge_weights_[edge] ? reverse_edge
+                                                            : edge);
+    }
+  }
+  std::stable_sort(sorted_edges_.begin(), sorted_edges_.end(),
+                   [this](Action a, Action b) {
+                     return edge_weights_[a] < edge_weights_[b];
+                   });
+
+  std::vector<int> parent(num_nodes_);
+  std::iota(parent.begin(), parent.end(), 0);
+  optimal_edges_.clear();
+  optimal_cost_ = KruskalCost(sorted_edges_, edge_weights_, num_nodes_,
+                              num_nodes_, parent, &optimal_edges_);
+
+  // The same algorithm on the costlier direction of each edge, in decreasing
+  // order, gives the most expensive tree.
+  std::vector<Action> reverse_sorted_edges;
+  reverse_sorted_edges.reserve(sorted_edges_.size());
+  for (Action edge : sorted_edges_) {
+    Action reverse_edge = (edge % num_nodes_) * num_nodes_ + edge / num_nodes_;
+    reverse_sorted_edges.push_back(
+        edge_weights_[reverse_edge] > edge_weights_[edge] ? reverse_edge
+                                                          : edge);
+  }
+  std::stable_sort(reverse_sorted_edges.begin(), reverse_sorted_edges.end(),
+                   [this](Action a, Action b) {
+                     return edge_weights_[a] > edge_weights_[b];
+                   });
+  worst_cost_ = KruskalCost(reverse_sorted_edges, edge_weights_, num_nodes_,
+                            num_nodes_, std::move(parent), /*tree=*/nullptr);
+}
 
 }  // namespace mst
 }  // namespace open_spiel
@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_MST_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_MST_H_
 
+#include <algorithm>
 #include <array>
 #include <map>
 #include <memory>
@@ -24,6 +25,16 @@
 #include "open_spiel/spiel.h"
 
 // Parameters: numNodes: 5-100
+//
+// The edge weights are a row-major num_nodes x num_nodes matrix, taken from
+// the first of these sources that is set:
+//   "weights_file"  path to a binary file of float32 matrices stored back to
+//                   back; "instance" selects which one is loaded.
+//   "generator"     "euclidean" (distances between uniform random points in
+//                   the unit square), "uniform" (symmetric uniform [0, 1)
+//                   weights) or "clustered" (distances between points drawn
+//                   around "num_clusters" random centres), seeded by "seed".
+//   "weights"       comma-separated list of floats.
 
 namespace open_spiel {
 namespace mst {
@@ -32,7 +43,14 @@ namespace mst {
 inline constexpr int kNumPlayers = 1;
 inline constexpr int kNumNodes = 1;
 inline constexpr int kEdgeStates = 3;  // -1, 0, 1 not able to connect, able to connect, connected
-inline constexpr auto kWeights = "0";//"0.0,0.33,0.37,0.19,0.84,0.33,0.0,0.18,0.42,0.58,0.37,0.18,0.0,0.39,0.46,0.19,0.42,0.39,0.0,0.82,0.84,0.58,0.46,0.82,0.0";
+inline constexpr bool kDefaultShapedRewards = false;
+inline constexpr auto kWeights = "0";
+inline constexpr auto kDefaultGenerator = "";
+inline constexpr auto kDefaultWeightsFile = "";
+inline constexpr int kDefaultInstance = 0;
+inline constexpr int kDefaultSeed = 42;
+inline constexpr int kDefaultNumClusters = 4;
+inline constexpr double kClusterStddev = 0.05;
 
 // inline constexpr int kNumberStates = 5478;
 
@@ -64,11 +82,17 @@ class MstState : public State {
   std::string InformationStateString(Player player) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(
-      Player player, std::vector<double>* values) const override;
+      Player player, absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
   void UndoAction(Player player, Action move) override;
   std::vector<Action> LegalActions() const override;
+  void LegalActionsMask(Player player,
+                        absl::Span<uint8_t> mask) const override;
   EdgeState AdjMatAt(int cell) const { return adjMat_[cell]; }
+
+  // Cost of the cheapest spanning tree that contains every edge chosen so
+  // far, minus the cost of those edges. Zero at terminal states.
+  double RemainingOptimalCost() const;
   EdgeState AdjMatAt(int row, int column) const {
     return adjMat_[row * num_nodes_ + column];
   }
@@ -84,10 +108,11 @@ class MstState : public State {
 
  private:
   bool ValidEdge(int edge) const;
-  bool HasCycle(int r, int c) const;
-  bool IsCyclic(int v, bool visited[], int parent) const;
   void AddEdge(int row, int column);
   void AddEdge(int edge);
+  void MergeComponents(int row, int column);
+  void SplitLastMerge();
+  void SetCrossEdgesLegal(int component_a, int component_b, bool legal);
   /*
   void RemoveEdge(int row, int column) const;
   void RemoveEdge(int edge) const;
@@ -102,6 +127,24 @@ class MstState : public State {
   // Most recent rewards.
   double reward_ = 0;
   double total_rewards_ = 0;
+  // Reward received for each move so far, so that moves can be undone.
+  std::vector<double> move_rewards_;
+  // Only maintained when the game uses shaped rewards.
+  double remaining_optimal_cost_ = 0;
+
+  // Union-find over the components formed by the connected edges. Each node
+  // stores its component id directly, and components are merged
+  // smaller-into-larger, so Find is O(1) and every merge can be undone.
+  std::vector<int> component_;
+  std::vector<std::vector<int>> component_members_;
+  int num_components_ = kNumNodes;
+  // Merges done so far as (kept, absorbed) component ids, one per move.
+  std::vector<std::pair<int, int>> merges_;
+
+  // legal_edges_[e] is true iff edge e is available and joins two different
+  // components. Updated incrementally on every merge.
+  std::vector<bool> legal_edges_;
+  int num_legal_edges_ = 0;
 
 };
 
@@ -109,34 +152,83 @@ class MstState : public State {
 class MstGame : public Game {
  public:
   explicit MstGame(const GameParameters& params);
+  // Uses the given weights instead of any weight source in `params`.
+  MstGame(const GameParameters& params, std::vector<float> weights);
   int NumDistinctActions() const override { return num_nodes_ * num_nodes_; }
   std::unique_ptr<State> NewInitialState() const override {
     return std::unique_ptr<State>(
         new MstState(shared_from_this(), num_nodes_, edge_weights_));
   }
   int NumPlayers() const override { return kNumPlayers; }
-  double MinUtility() const override { return -1; }
+  // The return is minus the cost of the chosen tree, offset by the optimal
+  // cost when rewards are shaped, so it is bounded by the cheapest and the
+  // most expensive spanning trees. The lower bound is pushed down on
+  // instances where every tree has the same cost, so the range is not empty.
+  double MinUtility() const override {
+    return std::min((shaped_rewards_ ? optimal_cost_ : 0) - worst_cost_,
+                    MaxUtility() - 1);
+  }
   double UtilitySum() const override { return 0; }
-  double MaxUtility() const override { return 1; }
+  double MaxUtility() const override {
+    return shaped_rewards_ ? 0 : -optimal_cost_;
+  }
   std::shared_ptr<const Game> Clone() const override {
     return std::shared_ptr<const Game>(new MstGame(*this));
   }
   std::vector<int> ObservationTensorShape() const override {
-    return {kEdgeStates, kNumNodes, kNumNodes};
+    return {kEdgeStates, num_nodes_, num_nodes_};
   }
   int MaxGameLength() const { return num_nodes_ * num_nodes_; }
   int NumNodes() const { return num_nodes_; }
   std::vector<float> EdgeWeights() const { return edge_weights_; }
 
+  // When true, the reward for a move is minus its cost in excess of the
+  // optimal completion, so the return is minus the optimality gap.
+  bool ShapedRewards() const { return shaped_rewards_; }
+
+  // Exact minimum spanning tree for this weight matrix, computed once by
+  // Kruskal's algorithm when the game is created. Each undirected edge is
+  // represented by whichever of its two actions is cheaper.
+  double OptimalCost() const { return optimal_cost_; }
+  const std::vector<Action>& OptimalEdges() const { return optimal_edges_; }
+
+  // One action per undirected edge, sorted by increasing weight.
+  const std::vector<Action>& SortedEdges() const { return sorted_edges_; }
+
  private:
+  void ComputeOptimalTree();
+
   int num_nodes_ = 0; //set some defaults
   std::vector<float> edge_weights_ = {};
+  bool shaped_rewards_ = kDefaultShapedRewards;
+  std::vector<Action> sorted_edges_;
+  std::vector<Action> optimal_edges_;
+  double optimal_cost_ = 0;
+  // Cost of the most expensive spanning tree.
+  double worst_cost_ = 0;
 };
 
 EdgeState PlayerToState(Player player);
 std::string StateToString(EdgeState state);
 std::vector<float> ParseWeights(std::string values);
 
+// Random instance generators. All return a symmetric row-major
+// num_nodes x num_nodes matrix with a zero diagonal.
+std::vector<float> EuclideanWeights(int num_nodes, int seed);
+std::vector<float> UniformWeights(int num_nodes, int seed);
+std::vector<float> ClusteredWeights(int num_nodes, int num_clusters, int seed);
+
+// Reads the `instance`-th num_nodes x num_nodes float32 matrix from a binary
+// file of matrices stored back to back.
+std::vector<float> ReadWeightsFile(const std::string& path, int num_nodes,
+                                   int instance);
+
+// Creates a game directly from a weight matrix, without going through the
+// string parameter. The matrix is not part of the game's parameters, so the
+// resulting game cannot be reloaded from its ToString().
+std::shared_ptr<const Game> LoadGameWithWeights(
+    std::vector<float> weights, GameParameters params = {});
+
 inline std::ostream& operator<<(std::ostream& stream, const EdgeState& state) {
   return stream << StateToString(state);
 }
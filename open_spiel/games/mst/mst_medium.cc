@@ -21,7 +21,7 @@
 #include <list>
 
 #include "open_spiel/spiel_utils.h"
-#include "open_spiel/tensor_view.h"
+#include "open_spiel/utils/tensor_view.h"
 
 namespace open_spiel {
 namespace mst_medium {
@@ -305,7 +305,7 @@ std::string MstState::ObservationString(Player player) const {
 }
 
 void MstState::ObservationTensor(
-    Player player, std::vector<double>* values) const {
+    Player player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -12,6 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "open_spiel/games/mst.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -27,10 +35,141 @@ void BasicMstTests() {
   testing::RandomSimTest(*LoadGame("mst"), 100);
 }
 
+std::shared_ptr<const Game> LoadSquareGame(bool shaped_rewards = false) {
+  // Four nodes on the corners of a unit square.
+  return LoadGame("mst", {{"num_nodes", GameParameter(4)},
+                          {"weights", GameParameter(std::string(
+                                          "0,1,1.41,1,"
+                                          "1,0,1,1.41,"
+                                          "1.41,1,0,1,"
+                                          "1,1.41,1,0"))},
+                          {"shaped_rewards", GameParameter(shaped_rewards)}});
+}
+
+bool Contains(const std::vector<Action>& actions, Action action) {
+  return std::find(actions.begin(), actions.end(), action) != actions.end();
+}
+
+void LegalActionsExcludeCyclesTest() {
+  std::shared_ptr<const Game> game = LoadSquareGame();
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_EQ(state->LegalActions().size(), 12);
+
+  state->ApplyAction(0 * 4 + 1);  // (0,1)
+  SPIEL_CHECK_EQ(state->LegalActions().size(), 10);
+  SPIEL_CHECK_FALSE(Contains(state->LegalActions(), 1 * 4 + 0));
+
+  state->ApplyAction(1 * 4 + 2);  // (1,2)
+  std::vector<Action> legal_actions = state->LegalActions();
+  SPIEL_CHECK_EQ(legal_actions.size(), 6);
+  SPIEL_CHECK_FALSE(Contains(legal_actions, 0 * 4 + 2));
+  SPIEL_CHECK_FALSE(Contains(legal_actions, 2 * 4 + 0));
+  SPIEL_CHECK_TRUE(Contains(legal_actions, 3 * 4 + 0));
+
+  state->ApplyAction(2 * 4 + 3);  // (2,3)
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  SPIEL_CHECK_FLOAT_EQ(state->Returns()[0], -3.0);
+
+  state->UndoAction(0, 2 * 4 + 3);
+  SPIEL_CHECK_FALSE(state->IsTerminal());
+  SPIEL_CHECK_EQ(state->LegalActions(), legal_actions);
+  SPIEL_CHECK_FLOAT_EQ(state->Returns()[0], -2.0);
+}
+
+void OptimalTreeTest() {
+  std::shared_ptr<const Game> game = LoadSquareGame();
+  const auto& mst_game = static_cast<const MstGame&>(*game);
+  SPIEL_CHECK_FLOAT_EQ(mst_game.OptimalCost(), 3.0);
+  SPIEL_CHECK_EQ(mst_game.OptimalEdges().size(), 3);
+
+  std::unique_ptr<State> state = game->NewInitialState();
+  const auto& mst_state = static_cast<const MstState&>(*state);
+  SPIEL_CHECK_FLOAT_EQ(mst_state.RemainingOptimalCost(), 3.0);
+  state->ApplyAction(0 * 4 + 2);  // Diagonal, not in any optimal tree.
+  SPIEL_CHECK_FLOAT_EQ(mst_state.RemainingOptimalCost(), 2.0);
+  state->ApplyAction(0 * 4 + 1);
+  SPIEL_CHECK_FLOAT_EQ(mst_state.RemainingOptimalCost(), 1.0);
+}
+
+void ShapedRewardsTest() {
+  std::shared_ptr<const Game> game = LoadSquareGame(/*shaped_rewards=*/true);
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(0 * 4 + 2);
+  SPIEL_CHECK_FLOAT_NEAR(state->Rewards()[0], -0.41, 1e-5);
+  state->ApplyAction(0 * 4 + 1);
+  SPIEL_CHECK_FLOAT_NEAR(state->Rewards()[0], 0.0, 1e-5);
+  state->ApplyAction(2 * 4 + 3);
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  SPIEL_CHECK_FLOAT_NEAR(state->Returns()[0], -0.41, 1e-5);
+
+  state->UndoAction(0, 2 * 4 + 3);
+  state->UndoAction(0, 0 * 4 + 1);
+  SPIEL_CHECK_FLOAT_NEAR(state->Returns()[0], -0.41, 1e-5);
+  state->ApplyAction(1 * 4 + 2);
+  SPIEL_CHECK_FLOAT_NEAR(state->Rewards()[0], 0.0, 1e-5);
+}
+
+void GeneratorsTest() {
+  for (const char* generator : {"euclidean", "uniform", "clustered"}) {
+    GameParameters params = {
+        {"num_nodes", GameParameter(20)},
+        {"generator", GameParameter(std::string(generator))},
+        {"seed", GameParameter(7)}};
+    std::shared_ptr<const Game> game = LoadGame("mst", params);
+    std::vector<float> weights =
+        static_cast<const MstGame&>(*game).EdgeWeights();
+    SPIEL_CHECK_EQ(weights.size(), 20 * 20);
+    for (int r = 0; r < 20; ++r) {
+      SPIEL_CHECK_EQ(weights[r * 20 + r], 0.0);
+      for (int c = 0; c < 20; ++c) {
+        SPIEL_CHECK_EQ(weights[r * 20 + c], weights[c * 20 + r]);
+      }
+    }
+    // Same seed, same instance; the game string is enough to rebuild it.
+    SPIEL_CHECK_EQ(static_cast<const MstGame&>(*LoadGame(game->ToString()))
+                       .EdgeWeights(),
+                   weights);
+    testing::RandomSimTest(*game, 5);
+  }
+  SPIEL_CHECK_NE(EuclideanWeights(10, 1), EuclideanWeights(10, 2));
+}
+
+void WeightsFileTest() {
+  char dir_template[] = "/tmp/mst_test_XXXXXX";
+  const std::string dir = mkdtemp(dir_template);
+  const std::string path = absl::StrCat(dir, "/weights.bin");
+  std::vector<float> first = UniformWeights(6, 1);
+  std::vector<float> second = UniformWeights(6, 2);
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(first.data()),
+               first.size() * sizeof(float));
+    file.write(reinterpret_cast<const char*>(second.data()),
+               second.size() * sizeof(float));
+  }
+  std::shared_ptr<const Game> game =
+      LoadGame("mst", {{"num_nodes", GameParameter(6)},
+                       {"weights_file", GameParameter(path)},
+                       {"instance", GameParameter(1)}});
+  SPIEL_CHECK_EQ(static_cast<const MstGame&>(*game).EdgeWeights(), second);
+  std::remove(path.c_str());
+  std::remove(dir.c_str());
+
+  std::shared_ptr<const Game> direct_game = LoadGameWithWeights(first);
+  SPIEL_CHECK_EQ(static_cast<const MstGame&>(*direct_game).NumNodes(), 6);
+  SPIEL_CHECK_EQ(static_cast<const MstGame&>(*direct_game).EdgeWeights(),
+                 first);
+}
+
 }  // namespace
-}  // namespace tic_tac_toe
+}  // namespace mst
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::mst::BasicMstTests();
+  open_spiel::mst::LegalActionsExcludeCyclesTest();
+  open_spiel::mst::OptimalTreeTest();
+  open_spiel::mst::ShapedRewardsTest();
+  open_spiel::mst::GeneratorsTest();
+  open_spiel::mst::WeightsFileTest();
 }
@@ -79,7 +79,7 @@ class OwareState : public State {
   // training, although the given representation is not necessary the best
   // for that purpose.
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
 
  protected:
   void DoApplyAction(Action action) override;
@@ -264,7 +264,7 @@ int PlayerRelative(PentagoPlayer state, Player current) {
 }
 
 void PentagoState::ObservationTensor(Player player,
-                                     std::vector<double>* values) const {
+                                     absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -14,6 +14,7 @@
 
 #include "open_spiel/games/phantom_ttt.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -54,10 +55,21 @@ const GameType kGameType{
     /*parameter_specification=*/
     {{"obstype", GameParameter(static_cast<std::string>(kDefaultObsType))}}};
 
+// Stands for a try of the opponent in the action sequence of a player.
+constexpr Action kUnknownAction = -1;
+
+// Sampling gives up after this many inconsistent worlds.
+constexpr int kMaxResampleTries = 1000;
+
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new PhantomTTTGame(params));
 }
 
+// A uniform index below n.
+int SampleIndex(int n, const std::function<double()>& rng) {
+  return std::min<int>(rng() * n, n - 1);
+}
+
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
 }  // namespace
@@ -148,7 +160,7 @@ std::string PhantomTTTState::InformationStateString(Player player) const {
 }
 
 void PhantomTTTState::InformationStateTensor(
-    Player player, std::vector<double>* values) const {
+    Player player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -157,11 +169,11 @@ void PhantomTTTState::InformationStateTensor(
   // Encoded in the same way as InformationStateAsString, so full sequences
   // which may contain action value 10 to represent "I don't know."
   const auto& player_view = player == Player{0} ? x_view_ : o_view_;
-  values->resize(kNumCells * kCellStates +
-                 kLongestSequence * (1 + kBitsPerAction));
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), kNumCells * kCellStates +
+                                     kLongestSequence * (1 + kBitsPerAction));
+  std::fill(values.begin(), values.end(), 0.);
   for (int cell = 0; cell < kNumCells; ++cell) {
-    (*values)[kNumCells * static_cast<int>(player_view[cell]) + cell] = 1.0;
+    values[kNumCells * static_cast<int>(player_view[cell]) + cell] = 1.0;
   }
 
   // Now encode the sequence. Each (player, action) pair uses 11 bits:
@@ -171,19 +183,20 @@ void PhantomTTTState::InformationStateTensor(
   for (const auto& player_with_action : action_sequence_) {
     if (player_with_action.first == player) {
       // Always include the observing player's actions.
-      (*values)[offset] = player_with_action.first;  // Player 0 or 1
-      (*values)[offset + 1 + player_with_action.second] = 1.0;
+      values[offset] = player_with_action.first;  // Player 0 or 1
+      values[offset + 1 + player_with_action.second] = 1.0;
+      offset += (1 + kBitsPerAction);
     } else if (obs_type_ == ObservationType::kRevealNumTurns) {
       // If the number of turns are revealed, then each of the other player's
       // actions will show up as unknowns.
-      (*values)[offset] = player_with_action.first;
-      (*values)[offset + 1 + 10] = 1.0;  // I don't know.
+      values[offset] = player_with_action.first;
+      values[offset + 1 + 10] = 1.0;  // I don't know.
+      offset += (1 + kBitsPerAction);
     } else {
-      // Do not reveal anything about the number of actions taken by opponent.
+      // Do not reveal anything about the number of actions taken by opponent,
+      // not even by leaving a gap for them.
       SPIEL_CHECK_EQ(obs_type_, ObservationType::kRevealNothing);
     }
-
-    offset += (1 + kBitsPerAction);
   }
 }
 
@@ -198,21 +211,21 @@ std::string PhantomTTTState::ObservationString(Player player) const {
 }
 
 void PhantomTTTState::ObservationTensor(Player player,
-                                        std::vector<double>* values) const {
+                                        absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
-  values->resize(game_->ObservationTensorSize());
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), game_->ObservationTensorSize());
+  std::fill(values.begin(), values.end(), 0.);
 
   // First 27 bits encodes the player's view in the same way as TicTacToe.
   const auto& player_view = player == Player{0} ? x_view_ : o_view_;
   for (int cell = 0; cell < kNumCells; ++cell) {
-    (*values)[kNumCells * static_cast<int>(player_view[cell]) + cell] = 1.0;
+    values[kNumCells * static_cast<int>(player_view[cell]) + cell] = 1.0;
   }
 
   // Then a one-hot to represent total number of turns.
   if (obs_type_ == ObservationType::kRevealNumTurns) {
-    (*values)[kNumCells * kCellStates + action_sequence_.size()] = 1.0;
+    values[kNumCells * kCellStates + action_sequence_.size()] = 1.0;
   }
 }
 
@@ -242,6 +255,136 @@ void PhantomTTTState::UndoAction(Player player, Action move) {
   // if necessary.
 }
 
+std::unique_ptr<State> PhantomTTTState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  SPIEL_CHECK_FALSE(IsTerminal());
+  const Player opponent = 1 - player_id;
+  const auto& view = player_id == Player{0} ? x_view_ : o_view_;
+  const CellState own_mark = PlayerToState(player_id);
+
+  // What the player knows of the action sequence, and for each cell where a
+  // try revealed an opponent mark, how many opponent moves preceded the try.
+  std::vector<Action> events;
+  std::array<int, kNumCells> deadline;
+  std::fill(deadline.begin(), deadline.end(), -1);
+  int num_opponent_moves = player_id == Player{0} ? 0 : 1;
+  for (const auto& [player, action] : action_sequence_) {
+    if (player != player_id) {
+      if (obs_type_ == ObservationType::kRevealNumTurns) {
+        events.push_back(kUnknownAction);
+      }
+      continue;
+    }
+    events.push_back(action);
+    if (view[action] == own_mark) {
+      ++num_opponent_moves;
+    } else {
+      deadline[action] = num_opponent_moves;
+    }
+  }
+
+  const std::string info_state = InformationStateString(player_id);
+  for (int tries = 0; tries < kMaxResampleTries; ++tries) {
+    std::unique_ptr<State> state = game_->NewInitialState();
+    auto& world = static_cast<PhantomTTTState&>(*state);
+    const auto& opponent_view = opponent == Player{0} ? world.x_view_
+                                                      : world.o_view_;
+    int num_moves = 0;
+    bool consistent = true;
+    int i = 0;
+    while (consistent && !world.IsTerminal()) {
+      if (world.CurrentPlayer() == player_id) {
+        if (i == events.size()) break;
+        if (events[i] == kUnknownAction) {
+          consistent = false;
+        } else {
+          world.ApplyAction(events[i++]);
+        }
+        continue;
+      }
+      // The opponent's turn ends with a move if the player acts after it.
+      int num_tries = 0;
+      while (i + num_tries < events.size() &&
+             events[i + num_tries] == kUnknownAction) {
+        ++num_tries;
+      }
+      i += num_tries;
+      const bool completed = i < events.size() || CurrentPlayer() == player_id;
+      if (obs_type_ == ObservationType::kRevealNothing) {
+        num_tries = completed ? 1 : 0;
+      }
+      // Failed tries hit the player's marks that the opponent has not seen.
+      for (int t = completed ? 1 : 0; consistent && t < num_tries; ++t) {
+        std::vector<Action> hidden_marks;
+        for (Action cell = 0; cell < kNumCells; ++cell) {
+          if (world.state_.BoardAt(cell) == own_mark &&
+              opponent_view[cell] == CellState::kEmpty) {
+            hidden_marks.push_back(cell);
+          }
+        }
+        if (hidden_marks.empty()) {
+          consistent = false;
+        } else {
+          world.ApplyAction(
+              hidden_marks[SampleIndex(hidden_marks.size(), rng)]);
+        }
+      }
+      if (!consistent || !completed) break;
+      if (num_tries == 0) {
+        consistent = false;
+        break;
+      }
+
+      // The move must leave room for the marks that the player's later tries
+      // reveal: once as many are pending as there are moves left before one
+      // of them, the earliest one is played.
+      std::vector<Action> pending;
+      for (Action cell = 0; cell < kNumCells; ++cell) {
+        if (deadline[cell] >= 0 &&
+            world.state_.BoardAt(cell) == CellState::kEmpty) {
+          pending.push_back(cell);
+        }
+      }
+      std::sort(pending.begin(), pending.end(), [&](Action a, Action b) {
+        return deadline[a] < deadline[b];
+      });
+      bool forced = false;
+      for (int k = 0; k < pending.size(); ++k) {
+        const int moves_left = deadline[pending[k]] - num_moves;
+        if (moves_left < k + 1) consistent = false;
+        if (moves_left == k + 1) forced = true;
+      }
+      if (!consistent) break;
+      Action move = kInvalidAction;
+      if (forced) {
+        move = pending[0];
+      } else {
+        // Any empty cell where the player does not play later.
+        std::vector<Action> moves;
+        for (Action cell = 0; cell < kNumCells; ++cell) {
+          if (world.state_.BoardAt(cell) == CellState::kEmpty &&
+              view[cell] != own_mark) {
+            moves.push_back(cell);
+          }
+        }
+        if (moves.empty()) {
+          consistent = false;
+          break;
+        }
+        move = moves[SampleIndex(moves.size(), rng)];
+      }
+      world.ApplyAction(move);
+      ++num_moves;
+    }
+    if (consistent && i == events.size() && !world.IsTerminal() &&
+        world.CurrentPlayer() == CurrentPlayer() &&
+        world.InformationStateString(player_id) == info_state) {
+      return state;
+    }
+  }
+  SpielFatalError("Could not sample a world consistent with the infostate.");
+}
+
 PhantomTTTGame::PhantomTTTGame(const GameParameters& params)
     : Game(kGameType, params),
       game_(std::static_pointer_cast<const tic_tac_toe::TicTacToeGame>(
@@ -50,7 +50,7 @@ class PigState : public State {
   std::vector<double> Returns() const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
 
   std::unique_ptr<State> Clone() const override;
 
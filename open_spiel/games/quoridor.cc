@@ -15,6 +15,7 @@
 #include "open_spiel/games/quoridor.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -76,7 +77,6 @@ class QuoridorState::SearchState {
   explicit SearchState(int board_diameter) {
     int size = board_diameter * board_diameter;
     mark_.resize(size, false);
-    on_shortest_path_.resize(size, false);
     distance_.resize(size, UndefinedDistance());
     queue_.reserve(size);
   }
@@ -112,8 +112,6 @@ class QuoridorState::SearchState {
 
   void SetDist(Move move, int dist) { distance_[move.xy] = dist; }
   int GetDist(Move move) const { return distance_[move.xy]; }
-  void SetOnShortestPath(Move move) { on_shortest_path_[move.xy] = true; }
-  bool IsOnShortestPath(Move move) const { return on_shortest_path_[move.xy]; }
 
   static constexpr int UndefinedDistance() { return -1; }
 
@@ -121,7 +119,6 @@ class QuoridorState::SearchState {
   SearchQueue queue_;
   std::vector<bool> mark_;     // Whether this position has been pushed before.
   std::vector<int> distance_;  // Distance from player.
-  std::vector<bool> on_shortest_path_;  // Is this position on a shortest path?
 };
 
 std::string Move::ToString() const {
@@ -153,6 +150,12 @@ QuoridorState::QuoridorState(std::shared_ptr<const Game> game, int board_size,
   SetPlayer(player_loc_[kPlayer2], kPlayer2, kPlayerNone);
   end_zone_[kPlayer1] = player_loc_[kPlayer2].y;
   end_zone_[kPlayer2] = player_loc_[kPlayer1].y;
+
+  SearchState search_state(board_diameter_);
+  for (QuoridorPlayer p : {kPlayer1, kPlayer2}) {
+    on_shortest_path_[p].resize(board_.size(), false);
+    SearchShortestPath(p, &search_state, &on_shortest_path_[p]);
+  }
 }
 
 Move QuoridorState::ActionToMove(Action action_id) const {
@@ -178,8 +181,6 @@ std::vector<Action> QuoridorState::LegalActions() const {
   // Wall placements.
   if (wall_count_[current_player_] > 0) {
     SearchState search_state(board_diameter_);
-    SearchShortestPath(kPlayer1, &search_state);
-    SearchShortestPath(kPlayer2, &search_state);
     for (int y = 0; y < board_diameter_ - 2; y += 2) {
       for (int x = 0; x < board_diameter_ - 2; x += 2) {
         Move h = GetMove(x, y + 1);
@@ -245,10 +246,9 @@ bool QuoridorState::IsValidWall(Move m, SearchState* search_state) const {
   // Any wall that doesn't intersect with a shortest path is clearly legal.
   // Walls that do intersect might still be legal because there's another way
   // around, but that's more expensive to check.
-  if (!search_state->IsOnShortestPath(m) &&
-      !search_state->IsOnShortestPath(m + offset * 2)) {
-    return true;
-  }
+  bool cuts_p1 = CutsShortestPath(kPlayer1, m, offset);
+  bool cuts_p2 = CutsShortestPath(kPlayer2, m, offset);
+  if (!cuts_p1 && !cuts_p2) return true;
 
   // If this wall doesn't connect two existing walls/edges, then it can't cut
   // any paths. Even connecting to a node where 3 other walls meet, but without
@@ -266,9 +266,12 @@ bool QuoridorState::IsValidWall(Move m, SearchState* search_state) const {
        IsWall(m + offset + offset.rotate_right())));
   if (count <= 1) return true;
 
-  // Do a full search to verify both players can get to their respective goals.
-  return (SearchEndZone(kPlayer1, m, m + offset * 2, search_state) &&
-          SearchEndZone(kPlayer2, m, m + offset * 2, search_state));
+  // Do a full search to verify the players whose path was cut can still get to
+  // their respective goals.
+  return ((!cuts_p1 ||
+           SearchEndZone(kPlayer1, m, m + offset * 2, search_state)) &&
+          (!cuts_p2 ||
+           SearchEndZone(kPlayer2, m, m + offset * 2, search_state)));
 }
 
 bool QuoridorState::SearchEndZone(QuoridorPlayer p, Move wall1, Move wall2,
@@ -297,7 +300,9 @@ bool QuoridorState::SearchEndZone(QuoridorPlayer p, Move wall1, Move wall2,
 }
 
 void QuoridorState::SearchShortestPath(QuoridorPlayer p,
-                                       SearchState* search_state) const {
+                                       SearchState* search_state,
+                                       std::vector<bool>* on_path) const {
+  std::fill(on_path->begin(), on_path->end(), false);
   search_state->ResetSearchQueue();
   search_state->ResetDists();
   Offset dir(1, 0);  // Direction is arbitrary. Queue will make it fast.
@@ -339,7 +344,7 @@ void QuoridorState::SearchShortestPath(QuoridorPlayer p,
         Move move = current + dir * 2;
         int dist2 = search_state->GetDist(move);
         if (dist2 != search_state->UndefinedDistance() && dist2 + 1 == dist) {
-          search_state->SetOnShortestPath(wall);
+          (*on_path)[wall.xy] = true;
           current = move;
           dist = dist2;
           break;
@@ -434,7 +439,7 @@ std::string QuoridorState::ObservationString(Player player) const {
 }
 
 void QuoridorState::ObservationTensor(Player player,
-                                      std::vector<double>* values) const {
+                                      absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -458,6 +463,7 @@ void QuoridorState::DoApplyAction(Action action) {
   Move move = ActionToMove(action);
   SPIEL_CHECK_TRUE(move.IsValid());
 
+  Move from;  // Only set for pawn moves.
   if (move.IsWall()) {
     Offset offset = (move.IsHorizontalWall() ? Offset(1, 0) : Offset(0, 1));
     SetPlayer(move + offset * 0, kPlayerWall, kPlayerNone);
@@ -465,6 +471,7 @@ void QuoridorState::DoApplyAction(Action action) {
     SetPlayer(move + offset * 2, kPlayerWall, kPlayerNone);
     wall_count_[current_player_] -= 1;
   } else {
+    from = player_loc_[current_player_];
     SetPlayer(player_loc_[current_player_], kPlayerNone, current_player_);
     SetPlayer(move, current_player_, kPlayerNone);
     player_loc_[current_player_] = move;
@@ -479,9 +486,42 @@ void QuoridorState::DoApplyAction(Action action) {
     outcome_ = kPlayerDraw;
   }
 
+  if (!IsTerminal()) UpdateShortestPaths(current_player_, from, move);
+
   current_player_ = (current_player_ == kPlayer1 ? kPlayer2 : kPlayer1);
 }
 
+void QuoridorState::UpdateShortestPaths(QuoridorPlayer mover, Move from,
+                                        Move move) {
+  bool recompute[kNumPlayers] = {false, false};
+  if (move.IsWall()) {
+    // Pawns don't block paths, so only players whose path crosses the new wall
+    // need a new one.
+    Offset offset = (move.IsHorizontalWall() ? Offset(1, 0) : Offset(0, 1));
+    for (QuoridorPlayer p : {kPlayer1, kPlayer2}) {
+      recompute[p] = CutsShortestPath(p, move, offset);
+    }
+  } else {
+    // A single step along the path leaves the rest of it as a shortest path
+    // from the new location. Any other move needs a new search.
+    Move step = GetMove((from.x + move.x) / 2, (from.y + move.y) / 2);
+    bool is_step = std::abs(from.x - move.x) + std::abs(from.y - move.y) == 2;
+    if (is_step && on_shortest_path_[mover][step.xy]) {
+      on_shortest_path_[mover][step.xy] = false;
+    } else {
+      recompute[mover] = true;
+    }
+  }
+
+  if (!recompute[kPlayer1] && !recompute[kPlayer2]) return;
+  SearchState search_state(board_diameter_);
+  for (QuoridorPlayer p : {kPlayer1, kPlayer2}) {
+    if (recompute[p]) {
+      SearchShortestPath(p, &search_state, &on_shortest_path_[p]);
+    }
+  }
+}
+
 std::unique_ptr<State> QuoridorState::Clone() const {
   return std::unique_ptr<State>(new QuoridorState(*this));
 }
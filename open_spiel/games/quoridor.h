@@ -101,7 +101,7 @@ class QuoridorState : public State {
   std::string InformationStateString(Player player) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
   std::vector<Action> LegalActions() const override;
 
@@ -135,9 +135,25 @@ class QuoridorState : public State {
   bool IsValidWall(Move m, SearchState*) const;
   bool SearchEndZone(QuoridorPlayer p, Move wall1, Move wall2,
                      SearchState*) const;
-  void SearchShortestPath(QuoridorPlayer p, SearchState* search_state) const;
+  void SearchShortestPath(QuoridorPlayer p, SearchState* search_state,
+                          std::vector<bool>* on_path) const;
+
+  // Whether a wall at `m` would cross the cached path of player `p`.
+  bool CutsShortestPath(QuoridorPlayer p, Move m, Offset offset) const {
+    return on_shortest_path_[p][m.xy] ||
+           on_shortest_path_[p][(m + offset * 2).xy];
+  }
+
+  // Keeps `on_shortest_path_` valid after `DoApplyAction` moved a pawn or
+  // placed a wall.
+  void UpdateShortestPaths(QuoridorPlayer mover, Move from, Move move);
 
   std::vector<QuoridorPlayer> board_;
+  // For each player, the wall slots crossed by one of their shortest paths to
+  // the end zone. Walls can only make paths longer, so a wall that doesn't
+  // cross this path leaves it intact, and only walls that do cross it need a
+  // full search in `LegalActions`.
+  std::vector<bool> on_shortest_path_[kNumPlayers];
   int wall_count_[kNumPlayers];
   int end_zone_[kNumPlayers];
   Move player_loc_[kNumPlayers];
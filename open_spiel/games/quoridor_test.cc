@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <iostream>
+#include <random>
+#include <vector>
 
+#include "open_spiel/games/quoridor.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -24,6 +27,67 @@ namespace {
 
 namespace testing = open_spiel::testing;
 
+// Breadth-first search over the wall plane of the observation tensor, checking
+// that both pawns can still reach their end zone.
+bool BothPlayersCanReachGoal(const State& state, int diameter) {
+  std::vector<double> obs = state.ObservationTensor(0);
+  auto plane = [&](int p, int x, int y) {
+    return obs[p * diameter * diameter + y * diameter + x] > 0;
+  };
+  for (int p = 0; p < kNumPlayers; ++p) {
+    int goal = p == 0 ? 0 : diameter - 1;
+    std::vector<bool> seen(diameter * diameter, false);
+    std::vector<std::pair<int, int>> queue;
+    for (int y = 0; y < diameter; y += 2) {
+      for (int x = 0; x < diameter; x += 2) {
+        if (plane(p, x, y)) queue.push_back({x, y});
+      }
+    }
+    bool found = false;
+    for (int i = 0; i < queue.size() && !found; ++i) {
+      auto [x, y] = queue[i];
+      if (y == goal) found = true;
+      const int dirs[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+      for (const auto& d : dirs) {
+        int wx = x + d[0], wy = y + d[1];
+        int nx = x + 2 * d[0], ny = y + 2 * d[1];
+        if (nx < 0 || ny < 0 || nx >= diameter || ny >= diameter) continue;
+        if (plane(kPlayerWall, wx, wy) || seen[ny * diameter + nx]) continue;
+        seen[ny * diameter + nx] = true;
+        queue.push_back({nx, ny});
+      }
+    }
+    if (!found) return false;
+  }
+  return true;
+}
+
+// The cached shortest paths decide which walls skip the full search, so check
+// that every legal wall still leaves both players a path to their goal.
+void WallLegalityTest() {
+  std::mt19937 rng(7);
+  for (int board_size : {3, 5, 7}) {
+    int diameter = board_size * 2 - 1;
+    std::shared_ptr<const Game> game = LoadGame(absl::StrCat(
+        "quoridor(board_size=", board_size, ",wall_count=", board_size, ")"));
+    for (int episode = 0; episode < 20; ++episode) {
+      std::unique_ptr<State> state = game->NewInitialState();
+      while (!state->IsTerminal()) {
+        std::vector<Action> legal = state->LegalActions();
+        for (Action action : legal) {
+          if (action % diameter % 2 == 0 && action / diameter % 2 == 0) {
+            continue;  // Pawn move.
+          }
+          std::unique_ptr<State> child = state->Child(action);
+          SPIEL_CHECK_TRUE(BothPlayersCanReachGoal(*child, diameter));
+        }
+        std::uniform_int_distribution<int> dist(0, legal.size() - 1);
+        state->ApplyAction(legal[dist(rng)]);
+      }
+    }
+  }
+}
+
 void BasicQuoridorTests() {
   testing::LoadGameTest("quoridor(board_size=5)");
   testing::NoChanceOutcomesTest(*LoadGame("quoridor()"));
@@ -43,6 +107,8 @@ void BasicQuoridorTests() {
       3);
   testing::RandomSimTest(
       *LoadGame("quoridor(board_size=5,ansi_color_output=True)"), 3);
+
+  WallLegalityTest();
 }
 
 }  // namespace
@@ -14,6 +14,9 @@
 
 #include "open_spiel/games/skat.h"
 
+#include <algorithm>
+#include <functional>
+
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/game_parameters.h"
@@ -178,6 +181,30 @@ std::string SkatGameTypeToString(SkatGameType trump_game) {
   }
 }
 
+// Cards 0-2, 11-14, 23-25 to player 1.
+// Cards 3-5, 15-18, 26-28 to player 2.
+// Cards 6-8, 19-22, 29-31 to player 3.
+// Cards 9-10 into the Skat.
+// While this might seem a bit weird, this is the official order Skat cards
+// are dealt.
+CardLocation DealLocation(int deal_round) {
+  if ((deal_round >= 0 && deal_round <= 2) ||
+      (deal_round >= 11 && deal_round <= 14) ||
+      (deal_round >= 23 && deal_round <= 25)) {
+    return kHand0;
+  } else if ((deal_round >= 3 && deal_round <= 5) ||
+      (deal_round >= 15 && deal_round <= 18) ||
+      (deal_round >= 26 && deal_round <= 28)) {
+    return kHand1;
+  } else if ((deal_round >= 6 && deal_round <= 8) ||
+      (deal_round >= 19 && deal_round <= 22) ||
+      (deal_round >= 29 && deal_round <= 31)) {
+    return kHand2;
+  } else {
+    return kSkat;
+  }
+}
+
 CardLocation PlayerToLocation(int player) {
   switch (player) {
     case 0:
@@ -290,6 +317,15 @@ bool SkatState::IsTrump(int card) const {
   }
 }
 
+bool SkatState::FollowsSuit(int card, int first_card) const {
+  // In Null games the Jacks belong to their suits. Otherwise a led trump,
+  // Jacks included, must be followed by any trump, and other suits by their
+  // cards that are not trumps.
+  if (game_type_ == kNullGame) return CardSuit(card) == CardSuit(first_card);
+  if (IsTrump(first_card)) return IsTrump(card);
+  return !IsTrump(card) && CardSuit(card) == CardSuit(first_card);
+}
+
 int SkatState::CardOrder(int card, int first_card) const {
   if (IsTrump(card)) {
     return 7 + TrumpOrder(card);
@@ -368,27 +404,7 @@ void SkatState::DoApplyAction(Action action) {
 void SkatState::ApplyDealAction(int card) {
   SPIEL_CHECK_EQ(card_locations_[card], kDeck);
   int deal_round = history_.size();
-  // Cards 0-2, 11-14, 23-25 to player 1.
-  // Cards 3-5, 15-18, 26-28 to player 2.
-  // Cards 6-8, 19-22, 29-31 to player 3.
-  // Cards 9-10 into the Skat.
-  // While this might seem a bit weird, this is the official order Skat cards
-  // are dealt.
-  if ((deal_round >= 0 && deal_round <= 2) ||
-      (deal_round >= 11 && deal_round <= 14) ||
-      (deal_round >= 23 && deal_round <= 25)) {
-    card_locations_[card] = kHand0;
-  } else if ((deal_round >= 3 && deal_round <= 5) ||
-      (deal_round >= 15 && deal_round <= 18) ||
-      (deal_round >= 26 && deal_round <= 28)) {
-    card_locations_[card] = kHand1;
-  } else if ((deal_round >= 6 && deal_round <= 8) ||
-      (deal_round >= 19 && deal_round <= 22) ||
-      (deal_round >= 29 && deal_round <= 31)) {
-    card_locations_[card] = kHand2;
-  } else if (deal_round == 9 || deal_round == 10) {
-    card_locations_[card] = kSkat;
-  }
+  card_locations_[card] = DealLocation(deal_round);
   if (deal_round == kNumCards - 1) {
     current_player_ = 0;
     phase_ = kBidding;
@@ -416,7 +432,7 @@ void SkatState::EndBidding(Player winner, SkatGameType game_type) {
     current_player_ = winner;
     game_type_ = game_type;
     // Winner takes up Skat cards.
-    for (int card = 0; card <= kNumCards; card++) {
+    for (int card = 0; card < kNumCards; card++) {
       if (card_locations_[card] == kSkat) {
         card_locations_[card] = PlayerToLocation(winner);
       }
@@ -426,7 +442,7 @@ void SkatState::EndBidding(Player winner, SkatGameType game_type) {
 
 int SkatState::CardsInSkat() const {
   int cards_in_skat = 0;
-  for (int card = 0; card <= kNumCards; card++) {
+  for (int card = 0; card < kNumCards; card++) {
     if (card_locations_[card] == kSkat) cards_in_skat++;
   }
   return cards_in_skat;
@@ -595,25 +611,10 @@ std::vector<Action> SkatState::PlayLegalActions() const {
   if (num_cards_played_ % kNumPlayers != 0) {
     // Check if we can follow suit.
     int first_card = CurrentTrick().FirstCard();
-    int suit = CardSuit(first_card);
-    if (game_type_ == kNullGame) {
-      for (int rank = 0; rank < kNumRanks; ++rank) {
-        int card = rank * kNumSuits + static_cast<int>(suit);
-        if (card_locations_[card] == PlayerToLocation(current_player_)) {
-          legal_actions.push_back(card);
-        }
-      }
-    } else {
-      // This is a bid fidely but it makes sure the legal actions are sorted
-      // (which is required), which the special status of jacks makes hard
-      // otherwise.
-      for (int card = 0; card < kNumCards; ++card) {
-        if ((IsTrump(first_card) && CardRank(card) == kJack) ||
-            (suit == CardSuit(card) && CardRank(card) != kJack)) {
-          if (card_locations_[card] == PlayerToLocation(current_player_)) {
-            legal_actions.push_back(card);
-          }
-        }
+    for (int card = 0; card < kNumCards; ++card) {
+      if (card_locations_[card] == PlayerToLocation(current_player_) &&
+          FollowsSuit(card, first_card)) {
+        legal_actions.push_back(card);
       }
     }
   }
@@ -631,6 +632,156 @@ std::vector<Action> SkatState::PlayLegalActions() const {
   return legal_actions;
 }
 
+std::unique_ptr<State> SkatState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  if (phase_ == kDeal) {
+    SpielFatalError("Skat cannot resample during the deal.");
+  }
+  const CardLocation own_hand = PlayerToLocation(player_id);
+  const bool knows_skat = player_id == solo_player_;
+
+  // The cards player_id has not seen, which may go to any of the places
+  // holding them now, as many as each holds.
+  std::vector<int> unseen_cards;
+  std::array<int, kTrick> capacity{};
+  for (int card = 0; card < kNumCards; ++card) {
+    const CardLocation location = card_locations_[card];
+    if (location == kDeck || location == kTrick || location == own_hand ||
+        (location == kSkat && knows_skat)) {
+      continue;
+    }
+    unseen_cards.push_back(card);
+    ++capacity[location];
+  }
+  // Except that a player who did not follow suit holds no card of that suit.
+  std::array<std::vector<int>, kNumPlayers> void_leads;
+  for (int i = 0; i * kNumPlayers < num_cards_played_; ++i) {
+    const std::vector<int> cards = tricks_[i].GetCards();
+    for (int position = 1; position < cards.size(); ++position) {
+      if (!FollowsSuit(cards[position], cards[0])) {
+        void_leads[tricks_[i].PlayerAtPosition(position)].push_back(cards[0]);
+      }
+    }
+  }
+  auto can_hold = [&](CardLocation location, int card) {
+    if (location == kSkat) return true;
+    for (int lead : void_leads[location - kHand0]) {
+      if (FollowsSuit(card, lead)) return false;
+    }
+    return true;
+  };
+
+  // Deals the most constrained cards first, each to a place that can hold it
+  // with a probability proportional to the room left there. This can paint
+  // itself into a corner, in which case it starts over.
+  std::array<CardLocation, kNumCards> locations = card_locations_;
+  for (int attempt = 0;; ++attempt) {
+    if (attempt == 100) {
+      SpielFatalError("Could not find a deal consistent with the play.");
+    }
+    for (int i = unseen_cards.size() - 1; i > 0; --i) {
+      std::swap(unseen_cards[i],
+                unseen_cards[static_cast<int>(rng() * (i + 1))]);
+    }
+    std::vector<int> num_places(kNumCards);
+    for (int card : unseen_cards) {
+      for (CardLocation location : {kHand0, kHand1, kHand2, kSkat}) {
+        if (capacity[location] > 0 && can_hold(location, card)) {
+          ++num_places[card];
+        }
+      }
+    }
+    std::stable_sort(
+        unseen_cards.begin(), unseen_cards.end(),
+        [&](int a, int b) { return num_places[a] < num_places[b]; });
+    std::array<int, kTrick> room = capacity;
+    bool dealt = true;
+    for (int card : unseen_cards) {
+      int total_room = 0;
+      for (CardLocation location : {kHand0, kHand1, kHand2, kSkat}) {
+        if (can_hold(location, card)) total_room += room[location];
+      }
+      if (total_room == 0) {
+        dealt = false;
+        break;
+      }
+      int pick = static_cast<int>(rng() * total_room);
+      for (CardLocation location : {kHand0, kHand1, kHand2, kSkat}) {
+        if (!can_hold(location, card)) continue;
+        if (pick < room[location]) {
+          locations[card] = location;
+          --room[location];
+          break;
+        }
+        pick -= room[location];
+      }
+    }
+    if (dealt) break;
+  }
+
+  // Where each card was dealt: played cards to whoever played them, and the
+  // solo player's cards to their hand, except for the Skat they picked up.
+  // Only the solo player knows that Skat; for the others, the cards in the
+  // Skat now (topped up from the solo player's hand while discarding) are as
+  // good a guess as any.
+  for (int i = 0; i * kNumPlayers < num_cards_played_; ++i) {
+    const std::vector<int> cards = tricks_[i].GetCards();
+    for (int position = 0; position < cards.size(); ++position) {
+      locations[cards[position]] =
+          PlayerToLocation(tricks_[i].PlayerAtPosition(position));
+    }
+  }
+  std::vector<int> discards;
+  if (solo_player_ >= 0) {
+    const CardLocation solo_hand = PlayerToLocation(solo_player_);
+    std::vector<int> dealt_skat;
+    for (int card = 0; card < kNumCards; ++card) {
+      if (locations[card] == kSkat) {
+        discards.push_back(card);
+        dealt_skat.push_back(card);
+      }
+    }
+    if (knows_skat) {
+      // The Skat is dealt in rounds 9 and 10.
+      dealt_skat = {static_cast<int>(history_[9]),
+                    static_cast<int>(history_[10])};
+    }
+    for (int card = 0; card < kNumCards; ++card) {
+      if (locations[card] == kSkat) locations[card] = solo_hand;
+    }
+    for (int card = 0;
+         card < kNumCards && dealt_skat.size() < kNumCardsInSkat; ++card) {
+      if (locations[card] == solo_hand &&
+          std::find(dealt_skat.begin(), dealt_skat.end(), card) ==
+              dealt_skat.end()) {
+        dealt_skat.push_back(card);
+      }
+    }
+    for (int card : dealt_skat) locations[card] = kSkat;
+  }
+
+  std::unique_ptr<State> state = game_->NewInitialState();
+  for (int deal_round = 0; deal_round < kNumCards; ++deal_round) {
+    for (int card = 0; card < kNumCards; ++card) {
+      if (locations[card] == DealLocation(deal_round)) {
+        locations[card] = kDeck;
+        state->ApplyAction(card);
+        break;
+      }
+    }
+  }
+  int num_discards = 0;
+  for (int i = kNumCards; i < history_.size(); ++i) {
+    const auto& skat_state = static_cast<const SkatState&>(*state);
+    if (skat_state.phase_ == kDiscardCards && !knows_skat) {
+      state->ApplyAction(discards[num_discards++]);
+    } else {
+      state->ApplyAction(history_[i]);
+    }
+  }
+  return state;
+}
+
 std::vector<std::pair<Action, double>> SkatState::ChanceOutcomes() const {
   std::vector<std::pair<Action, double>> outcomes;
   int num_cards_remaining = kNumCards - history_.size();
@@ -643,11 +794,11 @@ std::vector<std::pair<Action, double>> SkatState::ChanceOutcomes() const {
 }
 
 void SkatState::ObservationTensor(Player player,
-                                  std::vector<double>* values) const {
-  std::fill(values->begin(), values->end(), 0.0);
-  values->resize(game_->ObservationTensorSize());
+                                  absl::Span<float> values) const {
+  SPIEL_CHECK_EQ(values.size(), game_->ObservationTensorSize());
+  std::fill(values.begin(), values.end(), 0.0);
   if (phase_ == Phase::kGameOver || phase_ == Phase::kDeal) return;
-  auto ptr = values->begin();
+  auto ptr = values.begin();
   // Position:
   ptr[player] = 1;
   ptr += kNumPlayers;
@@ -701,7 +852,7 @@ void SkatState::ObservationTensor(Player player,
   }
 }
 
-std::vector<int> GetCardsFromMultiHot(std::vector<double>::iterator multi_hot) {
+std::vector<int> GetCardsFromMultiHot(std::vector<float>::iterator multi_hot) {
   std::vector<int> cards;
   for (int i = 0; i < kNumCards; i++) {
     if (multi_hot[i]) cards.push_back(i);
@@ -709,7 +860,7 @@ std::vector<int> GetCardsFromMultiHot(std::vector<double>::iterator multi_hot) {
   return cards;
 }
 
-int GetIntFromOneHot(std::vector<double>::iterator one_hot, int num_values) {
+int GetIntFromOneHot(std::vector<float>::iterator one_hot, int num_values) {
   for (int i = 0; i < num_values; i++) {
     if (one_hot[i]) return i;
   }
@@ -722,8 +873,8 @@ std::string SkatState::ObservationString(Player player) const {
   if (phase_ == Phase::kGameOver || phase_ == Phase::kDeal) {
     return "No Observation";
   }
-  std::vector<double> tensor(game_->ObservationTensorSize());
-  ObservationTensor(player, &tensor);
+  std::vector<float> tensor(game_->ObservationTensorSize());
+  ObservationTensor(player, absl::MakeSpan(tensor));
   std::string rv;
   auto ptr = tensor.begin();
   int player_pos = GetIntFromOneHot(ptr, kNumPlayers);
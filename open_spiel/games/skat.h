@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_SKAT_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_SKAT_H_
 
+#include <functional>
+#include <memory>
 #include <string>
 
 #include "open_spiel/spiel.h"
@@ -105,6 +107,11 @@ enum Phase {
   kPlay = 3,
   kGameOver = 4};
 
+Suit CardSuit(int card);
+Rank CardRank(int card);
+// The points the card is worth when taken in a trick.
+int CardValue(int card);
+
 // This is the information about one trick, i.e. up to three cards where each
 // card was played by one player.
 class Trick {
@@ -136,6 +143,8 @@ class Trick {
   Suit led_suit_;
 };
 
+class CardPlaySolver;
+
 class SkatState : public State {
  public:
   SkatState(std::shared_ptr<const Game> game);
@@ -154,15 +163,24 @@ class SkatState : public State {
   std::string ToString() const override;
   std::vector<Action> LegalActions() const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  // Keeps the bids, the cards played and the hand of `player_id`, and the
+  // Skat if they are the solo player. The other cards are dealt at random
+  // among the places holding them, respecting the suits the other players
+  // have shown out of.
+  std::unique_ptr<State> ResampleFromInfostate(
+      int player_id, std::function<double()> rng) const override;
 
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
-                         std::vector<double>* values) const override;
+                         absl::Span<float> values) const override;
 
  protected:
   void DoApplyAction(Action action) override;
 
  private:
+  // Reads the hands and the current trick.
+  friend class CardPlaySolver;
+
   std::vector<Action> DealLegalActions() const;
   std::vector<Action> BiddingLegalActions() const;
   std::vector<Action> DiscardCardsLegalActions() const;
@@ -175,6 +193,8 @@ class SkatState : public State {
   void EndBidding(Player winner, SkatGameType game_type);
   int NextPlayer() { return (current_player_ + 1) % kNumPlayers; }
   bool IsTrump(int card) const;
+  // Whether playing `card` follows suit when `first_card` was led.
+  bool FollowsSuit(int card, int first_card) const;
   int CardOrder(int card, int first_card) const;
   int TrumpOrder(int card) const;
   int NullOrder(Rank rank) const;
@@ -0,0 +1,446 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/skat/skat_solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>  // NOLINT
+
+#include "open_spiel/algorithms/pimc.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace skat {
+namespace {
+
+constexpr int kTrumpGroup = kNumSuits;
+constexpr int kMaxPoints = 120;
+// 4MB of transposition table per thread.
+constexpr int kTableBits = 18;
+
+uint32_t CardBit(int card) { return uint32_t{1} << card; }
+
+class CardPlaySolverBot : public Bot {
+ public:
+  CardPlaySolverBot(Player player_id, int seed)
+      : player_id_(player_id),
+        random_bot_(MakeUniformRandomBot(player_id, seed)) {}
+
+  Action Step(const State& state) override {
+    SPIEL_CHECK_EQ(state.CurrentPlayer(), player_id_);
+    if (!CardPlaySolver::CanSolve(state)) return random_bot_->Step(state);
+    CardPlaySolver solver(state);
+    const bool maximize = player_id_ == solver.solo_player();
+    Action best_action = kInvalidAction;
+    int best_value = 0;
+    for (const auto& [action, value] : solver.ActionValues()) {
+      if (best_action == kInvalidAction ||
+          (maximize ? value > best_value : value < best_value)) {
+        best_action = action;
+        best_value = value;
+      }
+    }
+    return best_action;
+  }
+
+ private:
+  const Player player_id_;
+  std::unique_ptr<Bot> random_bot_;
+};
+
+// Solves the card play exactly; bidding and discarding fall back to MCTS.
+std::vector<double> SolveWorld(const State& world, int seed) {
+  if (!CardPlaySolver::CanSolve(world)) {
+    return algorithms::MCTSWorldSolver()(world, seed);
+  }
+  CardPlaySolver solver(world);
+  const bool solo = world.CurrentPlayer() == solver.solo_player();
+  const std::vector<Action> legal_actions = world.LegalActions();
+  std::vector<double> values(legal_actions.size());
+  for (const auto& [action, points] : solver.ActionValues()) {
+    const int index =
+        std::find(legal_actions.begin(), legal_actions.end(), action) -
+        legal_actions.begin();
+    // The returns of the game when it ends with `points` for the solo player.
+    values[index] = solo ? (points - 60) / 120.0 : (60 - points) / 240.0;
+  }
+  return values;
+}
+
+REGISTER_WORLD_SOLVER("skat", SolveWorld);
+
+}  // namespace
+
+CardPlaySolver::CardPlaySolver(const State& state) {
+  SPIEL_CHECK_TRUE(CanSolve(state));
+  const auto& skat_state = static_cast<const SkatState&>(state);
+  null_game_ = skat_state.game_type_ == kNullGame;
+  solo_player_ = skat_state.solo_player_;
+  player_ = skat_state.current_player_;
+
+  for (int card = 0; card < kNumCards; ++card) {
+    const Suit suit = CardSuit(card);
+    const Rank rank = CardRank(card);
+    if (skat_state.IsTrump(card)) {
+      group_[card] = kTrumpGroup;
+      strength_[card] = skat_state.TrumpOrder(card);
+    } else {
+      group_[card] = suit;
+      strength_[card] =
+          null_game_ ? skat_state.NullOrder(rank) : static_cast<int>(rank);
+    }
+    points_[card] = CardValue(card);
+  }
+  group_cards_.fill(0);
+  for (int card = 0; card < kNumCards; ++card) {
+    group_cards_[group_[card]] |= CardBit(card);
+    order_[card] = card;
+  }
+  std::sort(order_.begin(), order_.end(), [this](int a, int b) {
+    return group_[a] != group_[b] ? group_[a] < group_[b]
+                                  : strength_[a] > strength_[b];
+  });
+  for (int group = 0, i = 0; group <= kTrumpGroup + 1; ++group) {
+    while (i < kNumCards && group_[order_[i]] < group) ++i;
+    group_begin_[group] = i;
+  }
+
+  hands_.fill(0);
+  hand_points_ = 0;
+  initial_points_ = skat_state.points_solo_;
+  for (int card = 0; card < kNumCards; ++card) {
+    const CardLocation location = skat_state.card_locations_[card];
+    if (location >= kHand0 && location <= kHand2) {
+      hands_[location - kHand0] |= CardBit(card);
+      hand_points_ += points_[card];
+    } else if (location == kSkat && !null_game_) {
+      initial_points_ += points_[card];
+    }
+  }
+  hands_key_ = HandsKey();
+  UseThreadTable();
+  trick_size_ = 0;
+  if (skat_state.num_cards_played_ % kNumPlayers != 0) {
+    for (int card : skat_state.CurrentTrick().GetCards()) {
+      trick_[trick_size_++] = card;
+    }
+  }
+}
+
+CardPlaySolver::Table& CardPlaySolver::ThreadTable() {
+  thread_local Table table;
+  return table;
+}
+
+void CardPlaySolver::UseThreadTable() {
+  static std::atomic<uint32_t> num_epochs{0};
+  Table& table = ThreadTable();
+  if (&table == thread_table_ && table.epoch == epoch_) return;
+  if (table.entries.empty()) {
+    table.entries.resize(1 << kTableBits);
+    table.epoch = ++num_epochs;
+  }
+  if (++table.generation == 0) {
+    std::fill(table.entries.begin(), table.entries.end(), Entry());
+    table.generation = 1;
+    table.epoch = ++num_epochs;
+  }
+  table_ = table.entries.data();
+  thread_table_ = &table;
+  generation_ = table.generation;
+  epoch_ = table.epoch;
+}
+
+bool CardPlaySolver::CanSolve(const State& state) {
+  if (state.GetGame()->GetType().short_name != "skat") return false;
+  return static_cast<const SkatState&>(state).phase_ == kPlay;
+}
+
+int CardPlaySolver::Solve() {
+  UseThreadTable();
+  return ToPoints(NullWindowSearch(kNoCard));
+}
+
+std::vector<std::pair<Action, int>> CardPlaySolver::ActionValues() {
+  UseThreadTable();
+  std::vector<std::pair<Action, int>> values;
+  for (uint32_t cards = LegalCards(); cards != 0; cards &= cards - 1) {
+    const int card = __builtin_ctz(cards);
+    values.emplace_back(card, ToPoints(NullWindowSearch(card)));
+  }
+  return values;
+}
+
+int CardPlaySolver::NullWindowSearch(int card) {
+  // MTD(f): each search tells whether the value is below a guess, and the
+  // bounds from earlier searches stay in the table.
+  int lower = 0;
+  int upper = null_game_ ? 1 : hand_points_;
+  for (int i = 0; i < trick_size_ && !null_game_; ++i) {
+    upper += points_[trick_[i]];
+  }
+  int guess = (lower + upper) / 2;
+  while (lower < upper) {
+    const int beta = std::max(guess, lower + 1);
+    guess = card == kNoCard ? Search(beta - 1, beta)
+                            : PlayAndSearch(card, beta - 1, beta);
+    if (guess < beta) {
+      upper = guess;
+    } else {
+      lower = guess;
+    }
+  }
+  return lower;
+}
+
+int CardPlaySolver::ToPoints(int value) const {
+  if (null_game_) return value == 1 ? 90 : 30;
+  return initial_points_ + value;
+}
+
+int CardPlaySolver::Search(int alpha, int beta) {
+  ++num_nodes_;
+  Entry* entry = nullptr;
+  Entry known;
+  int first_card = kNoCard;
+  if (trick_size_ == 0) {
+    if (hands_[player_] == 0) return null_game_ ? 1 : 0;
+    const int upper = null_game_ ? 1 : hand_points_;
+    entry = &TableEntry(hands_key_, player_);
+    if (entry->generation == generation_ && entry->hands == hands_key_ &&
+        entry->leader == player_) {
+      known = *entry;
+    } else {
+      known = Entry{hands_key_, static_cast<int8_t>(player_), 0,
+                    static_cast<int8_t>(upper), kNoCard, generation_};
+    }
+    if (known.lower >= beta) return known.lower;
+    if (known.upper <= alpha) return known.upper;
+    if (known.lower == known.upper) return known.lower;
+    alpha = std::max<int>(alpha, known.lower);
+    beta = std::min<int>(beta, known.upper);
+    first_card = known.best_card;
+  }
+
+  const int searched_alpha = alpha;
+  const int searched_beta = beta;
+  const bool maximize = player_ == solo_player_;
+  const Moves moves = OrderedMoves(first_card);
+  int best_value = maximize ? -1 : kMaxPoints + 1;
+  int best_card = kNoCard;
+  for (int i = 0; i < moves.size; ++i) {
+    const int value = PlayAndSearch(moves.cards[i], alpha, beta);
+    if (maximize ? value > best_value : value < best_value) {
+      best_value = value;
+      best_card = moves.cards[i];
+    }
+    if (maximize) {
+      alpha = std::max(alpha, value);
+    } else {
+      beta = std::min(beta, value);
+    }
+    if (alpha >= beta) break;
+  }
+
+  if (entry != nullptr) {
+    // The search below may have used the slot for other positions.
+    if (best_value > searched_alpha) known.lower = best_value;
+    if (best_value < searched_beta) known.upper = best_value;
+    known.best_card = best_card;
+    *entry = known;
+  }
+  return best_value;
+}
+
+int CardPlaySolver::PlayAndSearch(int card, int alpha, int beta) {
+  const Player player = player_;
+  hands_[player] &= ~CardBit(card);
+  hands_key_ &= ~(uint64_t{3} << (2 * card));
+  hand_points_ -= points_[card];
+  trick_[trick_size_++] = card;
+
+  int value;
+  if (trick_size_ < kNumPlayers) {
+    player_ = (player + 1) % kNumPlayers;
+    value = Search(alpha, beta);
+  } else {
+    // The last card of the trick; the player after it led.
+    const Player winner = (player + 1 + TrickWinner()) % kNumPlayers;
+    const std::array<int, kNumPlayers> trick = trick_;
+    trick_size_ = 0;
+    player_ = winner;
+    if (winner != solo_player_) {
+      value = Search(alpha, beta);
+    } else if (null_game_) {
+      value = 0;
+    } else {
+      const int trick_points =
+          points_[trick[0]] + points_[trick[1]] + points_[trick[2]];
+      value = trick_points + Search(alpha - trick_points, beta - trick_points);
+    }
+    trick_ = trick;
+    trick_size_ = kNumPlayers;
+  }
+
+  player_ = player;
+  --trick_size_;
+  hand_points_ += points_[card];
+  hands_[player] |= CardBit(card);
+  hands_key_ |= uint64_t(player + 1) << (2 * card);
+  return value;
+}
+
+uint32_t CardPlaySolver::LegalCards() const {
+  const uint32_t hand = hands_[player_];
+  if (trick_size_ == 0) return hand;
+  const uint32_t following = hand & group_cards_[group_[trick_[0]]];
+  return following != 0 ? following : hand;
+}
+
+CardPlaySolver::Moves CardPlaySolver::OrderedMoves(int first_card) const {
+  const uint32_t legal = LegalCards();
+  uint32_t in_play = hands_[0] | hands_[1] | hands_[2];
+  for (int i = 0; i < trick_size_; ++i) in_play |= CardBit(trick_[i]);
+
+  // Keeps the strongest card of each run of equivalent cards.
+  Moves moves;
+  for (int group = 0; group <= kTrumpGroup; ++group) {
+    if ((legal & group_cards_[group]) == 0) continue;
+    int previous = kNoCard;
+    for (int i = group_begin_[group]; i < group_begin_[group + 1]; ++i) {
+      const int card = order_[i];
+      if ((in_play & CardBit(card)) == 0) continue;
+      if ((legal & CardBit(card)) == 0) {
+        previous = kNoCard;
+      } else if (previous == kNoCard ||
+                 (!null_game_ && points_[card] != points_[previous])) {
+        moves.cards[moves.size++] = card;
+        previous = card;
+      }
+    }
+  }
+
+  if (moves.size == 1) return moves;
+
+  // Tries the best card of an earlier search first, then cards that take the
+  // trick, then the others, giving points to a partner that holds the trick
+  // and keeping them from an opponent.
+  std::array<int, kNumTricks> scores;
+  const int winner = trick_size_ > 0 ? TrickWinner() : 0;
+  const Player winning_player =
+      (player_ + kNumPlayers - trick_size_ + winner) % kNumPlayers;
+  const bool partner_wins =
+      (winning_player == solo_player_) == (player_ == solo_player_);
+  for (int i = 0; i < moves.size; ++i) {
+    const int card = moves.cards[i];
+    int score;
+    if (card == first_card) {
+      score = 1000;
+    } else if (trick_size_ == 0) {
+      score = (group_[card] == kTrumpGroup ? 100 : 0) + strength_[card];
+    } else {
+      const int best = trick_[winner];
+      const bool takes = group_[card] == group_[best]
+                             ? strength_[card] > strength_[best]
+                             : group_[card] == kTrumpGroup;
+      if (takes) {
+        score = 500 + points_[card];
+      } else if (partner_wins) {
+        score = 200 + points_[card];
+      } else {
+        score = 200 - points_[card];
+      }
+    }
+    scores[i] = score;
+  }
+  // Insertion sort; there are at most ten moves.
+  for (int i = 1; i < moves.size; ++i) {
+    for (int j = i; j > 0 && scores[j] > scores[j - 1]; --j) {
+      std::swap(scores[j], scores[j - 1]);
+      std::swap(moves.cards[j], moves.cards[j - 1]);
+    }
+  }
+  return moves;
+}
+
+int CardPlaySolver::TrickWinner() const {
+  int winner = 0;
+  for (int i = 1; i < trick_size_; ++i) {
+    const int card = trick_[i];
+    const int best = trick_[winner];
+    if (group_[card] == group_[best] ? strength_[card] > strength_[best]
+                                     : group_[card] == kTrumpGroup) {
+      winner = i;
+    }
+  }
+  return winner;
+}
+
+uint64_t CardPlaySolver::HandsKey() const {
+  uint64_t key = 0;
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    for (uint32_t cards = hands_[player]; cards != 0; cards &= cards - 1) {
+      key |= uint64_t(player + 1) << (2 * __builtin_ctz(cards));
+    }
+  }
+  return key;
+}
+
+CardPlaySolver::Entry& CardPlaySolver::TableEntry(uint64_t hands_key,
+                                                  Player leader) {
+  // Each position may go in either of two slots. When both are taken by other
+  // positions, the one with fewer cards left, which is cheaper to search
+  // again, is replaced. Entries of other solves count as empty.
+  const uint64_t hash = (hands_key + leader) * 0x9e3779b97f4a7c15ULL;
+  Entry* slots = &table_[(hash >> (64 - kTableBits)) & ~uint64_t{1}];
+  for (int i = 0; i < 2; ++i) {
+    if (slots[i].generation == generation_ && slots[i].hands == hands_key &&
+        slots[i].leader == leader) {
+      return slots[i];
+    }
+  }
+  auto cards_left = [this](const Entry& slot) {
+    return slot.generation == generation_ ? __builtin_popcountll(slot.hands)
+                                          : 0;
+  };
+  return cards_left(slots[0]) <= cards_left(slots[1]) ? slots[0] : slots[1];
+}
+
+std::vector<int> SolveCardPlay(absl::Span<const State* const> states,
+                               int num_threads) {
+  SPIEL_CHECK_GT(num_threads, 0);
+  std::vector<int> values(states.size());
+  // States are dealt to the threads round-robin. Each has its own solver,
+  // and the solvers of a thread share its transposition table.
+  num_threads = std::max(1, std::min<int>(num_threads, states.size()));
+  auto solve_states = [&](int first) {
+    for (int i = first; i < states.size(); i += num_threads) {
+      values[i] = CardPlaySolver(*states[i]).Solve();
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int t = 1; t < num_threads; ++t) threads.emplace_back(solve_states, t);
+  solve_states(0);
+  for (std::thread& thread : threads) thread.join();
+  return values;
+}
+
+std::unique_ptr<Bot> MakeCardPlaySolverBot(Player player_id, int seed) {
+  return std::make_unique<CardPlaySolverBot>(player_id, seed);
+}
+
+}  // namespace skat
+}  // namespace open_spiel
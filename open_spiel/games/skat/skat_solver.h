@@ -0,0 +1,164 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_SKAT_SKAT_SOLVER_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_SKAT_SKAT_SOLVER_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/skat.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+
+// Open-hand analysis of the card play of skat, the counterpart of bridge's
+// double-dummy solver: with all hands known, the card play is a game of
+// perfect information, in which the solo player maximizes their card points
+// and the two other players minimize them.
+//
+// The solver is an alpha-beta search over hands held as bitmasks. Cards of a
+// hand that are next to each other in the order of their suit, once the
+// cards out of play are skipped, and that are worth the same points, lead to
+// the same result, so only one of them is searched. The bounds found at the
+// start of each trick are kept in a transposition table keyed by the holders
+// of the remaining cards and the leader.
+
+namespace open_spiel {
+namespace skat {
+
+class CardPlaySolver {
+ public:
+  // `state` must be a skat state in the play phase.
+  explicit CardPlaySolver(const State& state);
+
+  // Whether `state` is a skat state in the play phase.
+  static bool CanSolve(const State& state);
+
+  // The points of the solo player at the end of the game when everyone plays
+  // optimally, the Skat included. In Null games this is 90 if the solo player
+  // takes no trick and 30 otherwise, as in the returns of the game.
+  int Solve();
+
+  // The same value after each legal action of the current player, in the
+  // order of LegalActions().
+  std::vector<std::pair<Action, int>> ActionValues();
+
+  Player solo_player() const { return solo_player_; }
+  int64_t num_nodes() const { return num_nodes_; }
+
+ private:
+  static constexpr int kNoCard = -1;
+
+  // Bounds on the points the solo player takes in the remaining tricks from
+  // the start of a trick, and the card that was best.
+  struct Entry {
+    uint64_t hands = 0;  // HandsKey() of the position.
+    int8_t leader;
+    int8_t lower;
+    int8_t upper;
+    int8_t best_card;
+    uint16_t generation = 0;  // The solve that wrote it; zero if unused.
+  };
+
+  // The transposition table of a thread, shared by the solvers it runs. Each
+  // solver takes the next generation and ignores the entries of the others,
+  // so the table is only cleared when the generation wraps around. Clearing
+  // it starts a new epoch, unique across tables, and a solver whose epoch is
+  // over takes a new generation before it searches again, as the solvers
+  // created since may have reused its generation.
+  struct Table {
+    std::vector<Entry> entries;
+    uint16_t generation = 0;
+    uint32_t epoch = 0;
+  };
+  static Table& ThreadTable();
+  // Points table_ at the table of the calling thread, taking a generation in
+  // it unless this solver holds one of the current epoch.
+  void UseThreadTable();
+
+  struct Moves {
+    std::array<int8_t, kNumTricks> cards;
+    int size = 0;
+  };
+
+  // Returns the points the solo player takes in the remaining tricks (in Null
+  // games, 1 if they take none and 0 otherwise), fail-soft within
+  // [alpha, beta].
+  int Search(int alpha, int beta);
+  // The exact value of Search, or of PlayAndSearch if `card` is given, by a
+  // sequence of searches with empty windows.
+  int NullWindowSearch(int card);
+  // Plays `card` for the player to move, searches and takes the card back.
+  int PlayAndSearch(int card, int alpha, int beta);
+  uint32_t LegalCards() const;
+  Moves OrderedMoves(int first_card) const;
+  // The position in the current trick of the card that wins it.
+  int TrickWinner() const;
+  // The holders of the remaining cards, two bits per card.
+  uint64_t HandsKey() const;
+  Entry& TableEntry(uint64_t hands_key, Player leader);
+  // Converts the value of Search from the start of the play to points.
+  int ToPoints(int value) const;
+
+  bool null_game_;
+  Player solo_player_;
+  // Points of the solo player from the tricks taken and the Skat.
+  int initial_points_;
+
+  // Trumps form one more group after the four suits. Cards are ranked by
+  // their strength within their group.
+  std::array<int, kNumCards> group_;
+  std::array<int, kNumCards> strength_;
+  std::array<int, kNumCards> points_;
+  std::array<uint32_t, kNumSuits + 1> group_cards_;
+  // The cards by group, strongest first within each, and where each group
+  // starts.
+  std::array<int, kNumCards> order_;
+  std::array<int, kNumSuits + 2> group_begin_;
+
+  // The position being searched.
+  std::array<uint32_t, kNumPlayers> hands_;
+  std::array<int, kNumPlayers> trick_;
+  int trick_size_;
+  Player player_;
+  int hand_points_;
+
+  uint64_t hands_key_;
+
+  // The entries of ThreadTable(); a position replaces whatever shares its
+  // slot.
+  Entry* table_;
+  const Table* thread_table_ = nullptr;
+  uint16_t generation_;
+  uint32_t epoch_;
+  int64_t num_nodes_ = 0;
+};
+
+// Solves each of the states, which must be in the play phase, on
+// `num_threads` threads.
+std::vector<int> SolveCardPlay(absl::Span<const State* const> states,
+                               int num_threads = 1);
+
+// A bot that plays the card play optimally, looking at all the hands. It bids
+// and discards at random.
+std::unique_ptr<Bot> MakeCardPlaySolverBot(Player player_id, int seed);
+
+}  // namespace skat
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_SKAT_SKAT_SOLVER_H_
@@ -14,6 +14,14 @@
 
 #include "open_spiel/games/skat.h"
 
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/games/skat/skat_solver.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -28,10 +36,159 @@ void BasicSkatTests() {
   testing::RandomSimTest(*LoadGame("skat"), 10);
 }
 
+void ResampleFromInfostateTest() {
+  std::shared_ptr<const Game> game = LoadGame("skat");
+  std::mt19937 rng(3);
+  UniformProbabilitySampler sampler(/*seed=*/11);
+  int num_changed = 0;
+  for (int i = 0; i < 20; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (!state->IsChanceNode()) {
+        for (Player player = 0; player < kNumPlayers; ++player) {
+          std::unique_ptr<State> resampled =
+              state->ResampleFromInfostate(player, sampler);
+          SPIEL_CHECK_EQ(resampled->History().size(), state->History().size());
+          SPIEL_CHECK_EQ(resampled->CurrentPlayer(), state->CurrentPlayer());
+          SPIEL_CHECK_EQ(resampled->ObservationString(player),
+                         state->ObservationString(player));
+          if (player == state->CurrentPlayer()) {
+            SPIEL_CHECK_EQ(resampled->LegalActions(), state->LegalActions());
+          }
+          if (resampled->ToString() != state->ToString()) ++num_changed;
+        }
+      }
+      const std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[rng() % actions.size()]);
+    }
+  }
+  SPIEL_CHECK_GT(num_changed, 0);
+}
+
+// Deals at random, lets player 0 bid `game_type` and discards at random.
+std::unique_ptr<State> StartPlay(const Game& game, SkatGameType game_type,
+                                 std::mt19937* rng) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  while (state->IsChanceNode()) {
+    const double z = std::uniform_real_distribution<double>()(*rng);
+    state->ApplyAction(SampleAction(state->ChanceOutcomes(), z).first);
+  }
+  state->ApplyAction(kBiddingActionBase + game_type);
+  for (int i = 0; i < kNumCardsInSkat; ++i) {
+    const std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[(*rng)() % actions.size()]);
+  }
+  return state;
+}
+
+// The returns of the solo player under optimal play, by searching the game
+// tree.
+double BruteForceValue(const State& state, Player solo_player) {
+  if (state.IsTerminal()) return state.Returns()[solo_player];
+  const bool maximize = state.CurrentPlayer() == solo_player;
+  double best_value = maximize ? -2 : 2;
+  for (Action action : state.LegalActions()) {
+    const double value =
+        BruteForceValue(*state.Child(action), solo_player);
+    best_value = maximize ? std::max(best_value, value)
+                          : std::min(best_value, value);
+  }
+  return best_value;
+}
+
+double PointsToReturn(int points) { return (points - 60) / 120.0; }
+
+void CardPlaySolverMatchesBruteForce() {
+  std::shared_ptr<const Game> game = LoadGame("skat");
+  std::mt19937 rng(5);
+  for (int game_type = kDiamondsTrump; game_type <= kNullGame; ++game_type) {
+    for (int deal = 0; deal < 5; ++deal) {
+      std::unique_ptr<State> state =
+          StartPlay(*game, static_cast<SkatGameType>(game_type), &rng);
+      // Leaves four tricks, minus a card or two of the current one.
+      const int num_random_cards = 18 + deal % 3;
+      for (int i = 0; i < num_random_cards && !state->IsTerminal(); ++i) {
+        const std::vector<Action> actions = state->LegalActions();
+        state->ApplyAction(actions[rng() % actions.size()]);
+      }
+      if (state->IsTerminal()) continue;
+      CardPlaySolver solver(*state);
+      const Player solo_player = solver.solo_player();
+      const int points = solver.Solve();
+      SPIEL_CHECK_FLOAT_EQ(PointsToReturn(points),
+                           BruteForceValue(*state, solo_player));
+      // A new solver reuses the table of the thread, without its entries.
+      CardPlaySolver again(*state);
+      SPIEL_CHECK_EQ(again.Solve(), points);
+      SPIEL_CHECK_EQ(again.num_nodes(), solver.num_nodes());
+      const std::vector<Action> legal_actions = state->LegalActions();
+      const auto action_values = solver.ActionValues();
+      SPIEL_CHECK_EQ(action_values.size(), legal_actions.size());
+      for (int i = 0; i < legal_actions.size(); ++i) {
+        SPIEL_CHECK_EQ(action_values[i].first, legal_actions[i]);
+        SPIEL_CHECK_FLOAT_EQ(
+            PointsToReturn(action_values[i].second),
+            BruteForceValue(*state->Child(legal_actions[i]), solo_player));
+      }
+    }
+  }
+}
+
+// The table generations wrap around after 65535 solvers. A solver that is
+// still alive by then must not see the entries of the later solver that takes
+// its generation.
+void CardPlaySolverOutlivesGenerationWrap() {
+  std::shared_ptr<const Game> game = LoadGame("skat");
+  std::mt19937 rng(11);
+  std::unique_ptr<State> state = StartPlay(*game, kGrand, &rng);
+  for (int i = 0; i < 18; ++i) {
+    const std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[rng() % actions.size()]);
+  }
+  CardPlaySolver solver(*state);
+  for (int i = 0; i < 65534; ++i) CardPlaySolver unused(*state);
+  CardPlaySolver successor(*state);
+  const int points = successor.Solve();
+  SPIEL_CHECK_EQ(solver.Solve(), points);
+  SPIEL_CHECK_EQ(solver.num_nodes(), successor.num_nodes());
+}
+
+void CardPlaySolverBotsPlayOptimally() {
+  std::shared_ptr<const Game> game = LoadGame("skat");
+  std::mt19937 rng(7);
+  std::vector<std::unique_ptr<State>> states;
+  std::vector<const State*> state_ptrs;
+  for (int game_type = kDiamondsTrump; game_type <= kNullGame; ++game_type) {
+    states.push_back(
+        StartPlay(*game, static_cast<SkatGameType>(game_type), &rng));
+    state_ptrs.push_back(states.back().get());
+  }
+  const std::vector<int> values = SolveCardPlay(state_ptrs, /*num_threads=*/3);
+  SPIEL_CHECK_EQ(values, SolveCardPlay(state_ptrs));
+
+  std::vector<std::unique_ptr<Bot>> bots;
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    bots.push_back(MakeCardPlaySolverBot(player, /*seed=*/player));
+  }
+  for (int i = 0; i < states.size(); ++i) {
+    State& state = *states[i];
+    const Player solo_player = CardPlaySolver(state).solo_player();
+    while (!state.IsTerminal()) {
+      state.ApplyAction(bots[state.CurrentPlayer()]->Step(state));
+    }
+    SPIEL_CHECK_FLOAT_EQ(state.Returns()[solo_player],
+                         PointsToReturn(values[i]));
+  }
+}
+
 }  // namespace
 }  // namespace skat
 }  // namespace open_spiel
 
 int main(int argc, char **argv) {
   open_spiel::skat::BasicSkatTests();
+  open_spiel::skat::ResampleFromInfostateTest();
+  open_spiel::skat::CardPlaySolverMatchesBruteForce();
+  open_spiel::skat::CardPlaySolverOutlivesGenerationWrap();
+  open_spiel::skat::CardPlaySolverBotsPlayOptimally();
 }
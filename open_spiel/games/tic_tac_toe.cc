@@ -99,6 +99,16 @@ std::vector<Action> TicTacToeState::LegalActions() const {
   return moves;
 }
 
+void TicTacToeState::LegalActionsMask(Player player,
+                                      absl::Span<uint8_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0);
+  if (IsTerminal() || player != CurrentPlayer()) return;
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    mask[cell] = board_[cell] == CellState::kEmpty;
+  }
+}
+
 std::string TicTacToeState::ActionToString(Player player,
                                            Action action_id) const {
   return absl::StrCat(StateToString(PlayerToState(player)), "(",
@@ -161,7 +171,7 @@ std::string TicTacToeState::ObservationString(Player player) const {
 }
 
 void TicTacToeState::ObservationTensor(Player player,
-                                       std::vector<double>* values) const {
+                                       absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -184,6 +194,10 @@ std::unique_ptr<State> TicTacToeState::Clone() const {
   return std::unique_ptr<State>(new TicTacToeState(*this));
 }
 
+bool TicTacToeState::CloneInto(State* dst) const {
+  return CopyStateInto(*this, dst);
+}
+
 TicTacToeGame::TicTacToeGame(const GameParameters& params)
     : Game(kGameType, params) {}
 
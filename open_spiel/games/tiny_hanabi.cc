@@ -164,23 +164,23 @@ std::string TinyHanabiState::InformationStateString(Player player) const {
 }
 
 void TinyHanabiState::InformationStateTensor(
-    Player player, std::vector<double>* values) const {
+    Player player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->resize(payoff_.NumChance() +
+  SPIEL_CHECK_EQ(values.size(), payoff_.NumChance() +
                  payoff_.NumActions() * payoff_.NumPlayers());
-  std::fill(values->begin(), values->end(), 0);
-  if (history_.size() > player) values->at(history_[player]) = 1;
+  std::fill(values.begin(), values.end(), 0);
+  if (history_.size() > player) values.at(history_[player]) = 1;
   for (int i = payoff_.NumPlayers(); i < history_.size(); ++i) {
-    values->at(payoff_.NumChance() +
+    values.at(payoff_.NumChance() +
                (i - payoff_.NumPlayers()) * payoff_.NumActions() +
                history_[i]) = 1;
   }
 }
 
 void TinyHanabiState::ObservationTensor(Player player,
-                                        std::vector<double>* values) const {
+                                        absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
@@ -16,17 +16,26 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
+#include <numeric>
 #include <utility>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/algorithms/public_tree_cfr.h"
 #include "open_spiel/game_parameters.h"
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
 #include "open_spiel/games/universal_poker/logic/card_set.h"
+#include "open_spiel/games/universal_poker/logic/hand_evaluator.h"
+#include "open_spiel/games/universal_poker/logic/suit_isomorphism.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/fingerprint.h"
 
 namespace open_spiel {
 namespace universal_poker {
@@ -102,7 +111,37 @@ const GameType kGameType{
      // Specify which actions are available to the player, in both limit and
      // nolimit games. Available options are: "fc" for fold and check/call.
      // "fcpa" for fold, check/call, bet pot and all in (default).
-     {"bettingAbstraction", GameParameter(std::string("fcpa"))}}};
+     // "fcba" for fold, check/call, the bets of "betSizes" and all in, in
+     // nolimit games only.
+     {"bettingAbstraction", GameParameter(std::string("fcpa"))},
+     // The bets of the "fcba" betting abstraction, as increasing fractions of
+     // the pot after calling. Rounds can be given their own bets by separating
+     // them with '|', e.g. "0.5 1 2|1|1|1"; a single list applies to every
+     // round. Bets below the minimum raise are raised to it, and bets of at
+     // least all in are dropped.
+     {"betSizes", GameParameter(std::string("0.5 1 2"))},
+     // Whether to identify deals which only differ by a relabelling of the
+     // suits. Chance nodes then only deal one card per class of isomorphic
+     // cards, with the combined probability, and information states are
+     // reported for the canonical relabelling of the player's cards. This is
+     // lossless, and can be combined with "gamedef".
+     {"suitIsomorphism", GameParameter(false)},
+     // The number of buckets of the card abstraction at each round, e.g.
+     // "10 50 50 50" (see universal_poker/logic/card_abstraction.h). When set,
+     // information states hold the bucket of the player's cards at each round
+     // rather than the cards. It can be combined with "gamedef".
+     {"cardBuckets", GameParameter(std::string(kEmptyString))},
+     // A directory where the card abstraction is cached, to only compute it
+     // once for a given game.
+     {"cardAbstractionCache", GameParameter(std::string(kEmptyString))},
+     // The number of threads computing the card abstraction, 0 for one per
+     // core.
+     {"cardAbstractionThreads", GameParameter(0)}}};
+
+// The parameters which may be combined with "gamedef".
+constexpr absl::string_view kNonGamedefParameters[] = {
+    "suitIsomorphism", "cardBuckets", "cardAbstractionCache",
+    "cardAbstractionThreads"};
 
 std::shared_ptr<const Game> Factory(const GameParameters &params) {
   return std::shared_ptr<const Game>(new UniversalPokerGame(params));
@@ -110,6 +149,31 @@ std::shared_ptr<const Game> Factory(const GameParameters &params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+// Chance outcomes are card ids, and all the hole cards are dealt first. Suit
+// isomorphism and card buckets merge hands in the information states, which
+// the public tree does not model.
+algorithms::PokerDecomposition Decomposition(const Game &game) {
+  const auto &poker_game = static_cast<const UniversalPokerGame &>(game);
+  if (poker_game.suit_isomorphism() || poker_game.card_abstraction()) {
+    SpielFatalError(
+        "The public tree of universal_poker requires suitIsomorphism=false "
+        "and cardBuckets=0.");
+  }
+  algorithms::PokerDecomposition decomposition;
+  decomposition.num_hole_cards =
+      poker_game.GetACPCGame()->GetNbHoleCardsRequired();
+  decomposition.hand_strength = [](uint64_t hole, uint64_t board) {
+    logic::CardSet cards;
+    for (uint64_t mask = hole | board; mask != 0; mask &= mask - 1) {
+      cards.AddCard(__builtin_ctzll(mask));
+    }
+    return logic::RankHand(cards);
+  };
+  return decomposition;
+}
+
+REGISTER_POKER_DECOMPOSITION(kGameType.short_name, Decomposition);
+
 // Returns how many actions are available at a choice node (3 when limit
 // and 4 for no limit).
 // TODO(author2): Is that a bug? There are 5 actions? Is no limit means
@@ -129,20 +193,32 @@ UniversalPokerState::UniversalPokerState(std::shared_ptr<const Game> game)
       hole_cards_(acpc_game_->GetNbPlayers()),
       cur_player_(kChancePlayerId),
       possibleActions_(ACTION_DEAL),
+      betSizes_(static_cast<const UniversalPokerGame *>(game.get())
+                    ->NumBetSizes(),
+                0),
       betting_abstraction_(static_cast<const UniversalPokerGame *>(game.get())
-                               ->betting_abstraction()) {}
+                               ->betting_abstraction()),
+      suit_isomorphism_(static_cast<const UniversalPokerGame *>(game.get())
+                            ->suit_isomorphism()),
+      card_abstraction_(static_cast<const UniversalPokerGame *>(game.get())
+                            ->card_abstraction()) {}
 
 std::string UniversalPokerState::ToString() const {
   std::ostringstream buf;
   buf << betting_abstraction_ << std::endl;
+  const logic::SuitPermutation permutation = DealSuitPermutation();
   for (int p = 0; p < acpc_game_->GetNbPlayers(); ++p) {
-    buf << "P" << p << " Cards: " << hole_cards_[p].ToString()
+    buf << "P" << p << " Cards: "
+        << logic::PermuteSuits(hole_cards_[p], permutation).ToString()
         << std::endl;
   }
-  buf << "BoardCards " << board_cards_.ToString() << std::endl;
+  buf << "BoardCards "
+      << logic::PermuteSuits(board_cards_, permutation).ToString()
+      << std::endl;
 
   if (IsChanceNode()) {
-    buf << "PossibleCardsToDeal " << deck_.ToString() << std::endl;
+    buf << "PossibleCardsToDeal "
+        << logic::PermuteSuits(deck_, permutation).ToString() << std::endl;
   }
   if (IsTerminal()) {
     for (int p = 0; p < acpc_game_->GetNbPlayers(); ++p) {
@@ -208,6 +284,7 @@ std::vector<double> UniversalPokerState::Returns() const {
   }
 
   std::vector<double> returns(NumPlayers());
+  if (GetSinglePotReturns(&returns)) return returns;
   for (Player player = 0; player < NumPlayers(); ++player) {
     // Money vs money at start.
     returns[player] = GetTotalReward(player);
@@ -217,12 +294,12 @@ std::vector<double> UniversalPokerState::Returns() const {
 }
 
 void UniversalPokerState::InformationStateTensor(
-    Player player, std::vector<double> *values) const {
+    Player player, absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->resize(game_->InformationStateTensorShape()[0]);
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), game_->InformationStateTensorShape()[0]);
+  std::fill(values.begin(), values.end(), 0.);
 
   // Layout of observation:
   //   my player number: num_players bits
@@ -230,56 +307,93 @@ void UniversalPokerState::InformationStateTensor(
   //             MaxChanceOutcomes() = NumSuits * NumRanks
   //   public cards: Same as above, but for the public cards.
   //   NumRounds() round sequence: (max round seq length)*2 bits
+  // With a card abstraction, the cards are replaced by the one-hot encoding
+  // of the bucket at each round: sum of the numbers of buckets bits.
   int offset = 0;
 
   // Mark who I am.
-  (*values)[player] = 1;
+  values[player] = 1;
   offset += NumPlayers();
 
+  if (card_abstraction_ != nullptr) {
+    const std::vector<int> buckets = GetCardBuckets(player);
+    for (int round = 0; round < card_abstraction_->NumRounds(); ++round) {
+      if (round < buckets.size()) values[offset + buckets[round]] = 1;
+      offset += card_abstraction_->NumBuckets(round);
+    }
+    AppendActionSequenceTensor(offset, values);
+    return;
+  }
+
   const logic::CardSet full_deck(acpc_game_->NumSuitsDeck(),
                                  acpc_game_->NumRanksDeck());
   const std::vector<uint8_t> deckCards = full_deck.ToCardArray();
-  logic::CardSet holeCards = hole_cards_[player];
+  logic::CardSet holeCards;
+  logic::CardSet boardCards;
+  GetInformationStateCards(player, &holeCards, &boardCards);
   // TODO(author2): it should be way more efficient to iterate over the cards
   // of the player, rather than iterating over all the cards.
   for (uint32_t i = 0; i < full_deck.NumCards(); i++) {
-    (*values)[i + offset] = holeCards.ContainsCards(deckCards[i]) ? 1.0 : 0.0;
+    values[i + offset] = holeCards.ContainsCards(deckCards[i]) ? 1.0 : 0.0;
   }
   offset += full_deck.NumCards();
 
   // Public cards
   for (int i = 0; i < full_deck.NumCards(); ++i) {
-    (*values)[i + offset] =
-        board_cards_.ContainsCards(deckCards[i]) ? 1.0 : 0.0;
+    values[i + offset] =
+        boardCards.ContainsCards(deckCards[i]) ? 1.0 : 0.0;
   }
   offset += full_deck.NumCards();
+  AppendActionSequenceTensor(offset, values);
+}
 
+void UniversalPokerState::AppendActionSequenceTensor(
+    int offset, absl::Span<float> values) const {
   const std::string actionSeq = GetActionSequence();
   const int length = actionSeq.length();
   SPIEL_CHECK_LT(length, game_->MaxGameLength());
 
+  if (betting_abstraction_ == BettingAbstraction::kFCBA) {
+    // One-hot encoding of the action of each move, with no bit for deals.
+    for (int i = 0; i < length; ++i) {
+      const int start = offset + i * num_distinct_actions_;
+      if (actionSeq[i] == 'f') {
+        values[start + kFold] = 1;
+      } else if (actionSeq[i] == 'c') {
+        values[start + kCall] = 1;
+      } else if (actionSeq[i] == 'a') {
+        values[start + num_distinct_actions_ - 1] = 1;
+      } else if (actionSeq[i] != 'd') {
+        values[start + kBet + actionSeq[i] - '0'] = 1;
+      }
+    }
+    offset += game_->MaxGameLength() * num_distinct_actions_;
+    SPIEL_CHECK_EQ(offset, game_->InformationStateTensorShape()[0]);
+    return;
+  }
+
   for (int i = 0; i < length; ++i) {
-    SPIEL_CHECK_LT(offset + i + 1, values->size());
+    SPIEL_CHECK_LT(offset + i + 1, values.size());
     if (actionSeq[i] == 'c') {
       // Encode call as 10.
-      (*values)[offset + (2 * i)] = 1;
-      (*values)[offset + (2 * i) + 1] = 0;
+      values[offset + (2 * i)] = 1;
+      values[offset + (2 * i) + 1] = 0;
     } else if (actionSeq[i] == 'p') {
       // Encode raise as 01.
-      (*values)[offset + (2 * i)] = 0;
-      (*values)[offset + (2 * i) + 1] = 1;
+      values[offset + (2 * i)] = 0;
+      values[offset + (2 * i) + 1] = 1;
     } else if (actionSeq[i] == 'a') {
       // Encode raise as 01.
-      (*values)[offset + (2 * i)] = 1;
-      (*values)[offset + (2 * i) + 1] = 1;
+      values[offset + (2 * i)] = 1;
+      values[offset + (2 * i) + 1] = 1;
     } else if (actionSeq[i] == 'f') {
       // Encode fold as 00.
       // TODO(author2): Should this be 11?
-      (*values)[offset + (2 * i)] = 0;
-      (*values)[offset + (2 * i) + 1] = 0;
+      values[offset + (2 * i)] = 0;
+      values[offset + (2 * i) + 1] = 0;
     } else if (actionSeq[i] == 'd') {
-      (*values)[offset + (2 * i)] = 0;
-      (*values)[offset + (2 * i) + 1] = 0;
+      values[offset + (2 * i)] = 0;
+      values[offset + (2 * i) + 1] = 0;
     } else {
       SPIEL_CHECK_EQ(actionSeq[i], 'd');
     }
@@ -291,12 +405,12 @@ void UniversalPokerState::InformationStateTensor(
 }
 
 void UniversalPokerState::ObservationTensor(Player player,
-                                            std::vector<double> *values) const {
+                                            absl::Span<float> values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, NumPlayers());
 
-  values->resize(game_->ObservationTensorShape()[0]);
-  std::fill(values->begin(), values->end(), 0.);
+  SPIEL_CHECK_EQ(values.size(), game_->ObservationTensorShape()[0]);
+  std::fill(values.begin(), values.end(), 0.);
 
   // Layout of observation:
   //   my player number: num_players bits
@@ -307,28 +421,29 @@ void UniversalPokerState::ObservationTensor(Player player,
   int offset = 0;
 
   // Mark who I am.
-  (*values)[player] = 1;
+  values[player] = 1;
   offset += NumPlayers();
 
   const logic::CardSet full_deck(acpc_game_->NumSuitsDeck(),
                                  acpc_game_->NumRanksDeck());
   const std::vector<uint8_t> all_cards = full_deck.ToCardArray();
-  logic::CardSet holeCards = hole_cards_[player];
+  logic::CardSet holeCards;
+  logic::CardSet boardCards;
+  GetInformationStateCards(player, &holeCards, &boardCards);
 
   for (uint32_t i = 0; i < full_deck.NumCards(); i++) {
-    (*values)[i + offset] = holeCards.ContainsCards(all_cards[i]) ? 1.0 : 0.0;
+    values[i + offset] = holeCards.ContainsCards(all_cards[i]) ? 1.0 : 0.0;
   }
   offset += full_deck.NumCards();
 
   for (uint32_t i = 0; i < full_deck.NumCards(); i++) {
-    (*values)[i + offset] =
-        board_cards_.ContainsCards(all_cards[i]) ? 1.0 : 0.0;
+    values[i + offset] = boardCards.ContainsCards(all_cards[i]) ? 1.0 : 0.0;
   }
   offset += full_deck.NumCards();
 
   // Adding the contribution of each players to the pot.
   for (auto p = Player{0}; p < NumPlayers(); p++) {
-    (*values)[offset + p] = acpc_state_.Ante(p);
+    values[offset + p] = acpc_state_.Ante(p);
   }
   offset += NumPlayers();
   SPIEL_CHECK_EQ(offset, game_->ObservationTensorShape()[0]);
@@ -347,13 +462,88 @@ std::string UniversalPokerState::InformationStateString(Player player) const {
   for (auto r = 0; r <= acpc_state_.GetRound(); r++) {
     sequences.emplace_back(acpc_state_.BettingSequence(r));
   }
+  std::string cards;
+  if (card_abstraction_ != nullptr) {
+    cards = absl::StrCat("[Buckets: ",
+                         absl::StrJoin(GetCardBuckets(player), " "), "]");
+  } else {
+    logic::CardSet hole_cards;
+    logic::CardSet board_cards;
+    GetInformationStateCards(player, &hole_cards, &board_cards);
+    cards = absl::StrCat("[Private: ", hole_cards.ToString(),
+                         "][Public: ", board_cards.ToString(), "]");
+  }
 
   return absl::StrFormat(
-      "[Round %i][Player: %i][Pot: %i][Money: %s][Private: %s][Public: "
-      "%s][Sequences: %s]",
+      "[Round %i][Player: %i][Pot: %i][Money: %s]%s[Sequences: %s]",
       acpc_state_.GetRound(), CurrentPlayer(), pot, absl::StrJoin(money, " "),
-      hole_cards_[player].ToString(), board_cards_.ToString(),
-      absl::StrJoin(sequences, "|"));
+      cards, absl::StrJoin(sequences, "|"));
+}
+
+// Everything else in the information state string (round, player to act, pot,
+// stacks and ACPC betting strings) is determined by the action sequence.
+absl::uint128 UniversalPokerState::InformationStateFingerprint(
+    Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, acpc_game_->GetNbPlayers());
+  Fingerprinter fingerprinter;
+  if (card_abstraction_ != nullptr) {
+    // The number of buckets is implied by the action sequence.
+    for (int bucket : GetCardBuckets(player)) fingerprinter.Add(bucket);
+  } else {
+    logic::CardSet hole_cards;
+    logic::CardSet board_cards;
+    GetInformationStateCards(player, &hole_cards, &board_cards);
+    fingerprinter.Add(hole_cards.cs.cards).Add(board_cards.cs.cards);
+  }
+  return fingerprinter.Add(actionSequence_).Fingerprint();
+}
+
+void UniversalPokerState::GetInformationStateCards(
+    Player player, logic::CardSet *hole_cards,
+    logic::CardSet *board_cards) const {
+  std::array<logic::CardSet, 2> cards = {hole_cards_[player], board_cards_};
+  if (suit_isomorphism_) logic::CanonicalizeSuits(absl::MakeSpan(cards));
+  *hole_cards = cards[0];
+  *board_cards = cards[1];
+}
+
+logic::SuitPermutation UniversalPokerState::DealSuitPermutation() const {
+  if (!suit_isomorphism_) {
+    logic::SuitPermutation identity;
+    std::iota(identity.begin(), identity.end(), 0);
+    return identity;
+  }
+  std::vector<logic::CardSet> dealt = hole_cards_;
+  dealt.push_back(board_cards_);
+  return logic::CanonicalSuitPermutation(dealt);
+}
+
+std::vector<int> UniversalPokerState::GetCardBuckets(Player player) const {
+  SPIEL_CHECK_TRUE(card_abstraction_ != nullptr);
+  // The board cards in the order they were dealt, which tells the board of
+  // each round apart. Every action adds one character to actionSequence_,
+  // and deals are the 'd' ones.
+  const int num_hole_cards =
+      acpc_game_->GetNbPlayers() * acpc_game_->GetNbHoleCardsRequired();
+  std::vector<uint8_t> board;
+  int num_deals = 0;
+  for (int i = 0; i < history_.size(); ++i) {
+    if (actionSequence_[i] == 'd' && num_deals++ >= num_hole_cards) {
+      board.push_back(history_[i]);
+    }
+  }
+  std::vector<int> buckets;
+  if (num_deals < num_hole_cards) return buckets;
+  for (int round = 0; round <= acpc_state_.GetRound(); ++round) {
+    const int num_board_cards = acpc_game_->GetNbBoardCardsRequired(round);
+    if (board.size() < num_board_cards) break;
+    logic::CardSet round_board;
+    for (int i = 0; i < num_board_cards; ++i) round_board.AddCard(board[i]);
+    buckets.push_back(
+        card_abstraction_->Bucket(round, hole_cards_[player], round_board));
+  }
+  return buckets;
 }
 
 std::string UniversalPokerState::ObservationString(Player player) const {
@@ -370,7 +560,10 @@ std::string UniversalPokerState::ObservationString(Player player) const {
   }
   // Add the player's private cards
   if (player != kChancePlayerId) {
-    absl::StrAppend(&result, "[Private: ", hole_cards_[player].ToString(), "]");
+    logic::CardSet hole_cards;
+    logic::CardSet board_cards;
+    GetInformationStateCards(player, &hole_cards, &board_cards);
+    absl::StrAppend(&result, "[Private: ", hole_cards.ToString(), "]");
   }
   // Adding the contribution of each players to the pot
   absl::StrAppend(&result, "[Ante:");
@@ -382,6 +575,45 @@ std::string UniversalPokerState::ObservationString(Player player) const {
   return result;
 }
 
+std::vector<std::pair<Action, double>> UniversalPokerState::TranslateRaise(
+    int32_t raise_to) const {
+  SPIEL_CHECK_GE(cur_player_, 0);
+  SPIEL_CHECK_FALSE(acpc_game_->IsLimitGame());
+  // The legal raises and their raise-to amounts, in increasing order.
+  std::vector<std::pair<int32_t, Action>> raises;
+  if (betting_abstraction_ == BettingAbstraction::kFCBA) {
+    for (int i = 0; i < betSizes_.size(); ++i) {
+      if (betSizes_[i] > 0) raises.push_back({betSizes_[i], kBet + i});
+    }
+    if (ACTION_ALL_IN & possibleActions_) {
+      raises.push_back({allInSize_, kBet + betSizes_.size()});
+    }
+  } else {
+    if (ACTION_BET & possibleActions_) raises.push_back({potSize_, kBet});
+    if (ACTION_ALL_IN & possibleActions_) {
+      raises.push_back({allInSize_, kAllIn});
+    }
+  }
+  if (raises.empty()) SpielFatalError("TranslateRaise: no raise is legal.");
+  if (raise_to <= raises.front().first) return {{raises.front().second, 1.0}};
+  if (raise_to >= raises.back().first) return {{raises.back().second, 1.0}};
+
+  // The mapping works on bets as fractions of the pot after calling.
+  const int max_spend = acpc_state_.MaxSpend();
+  const double pot = acpc_state_.TotalSpent() + max_spend -
+                     acpc_state_.CurrentSpent(cur_player_);
+  auto fraction = [max_spend, pot](int32_t amount) {
+    return (amount - max_spend) / pot;
+  };
+  int i = 1;
+  while (raises[i].first < raise_to) ++i;
+  if (raises[i].first == raise_to) return {{raises[i].second, 1.0}};
+  const double p =
+      PseudoHarmonicMapping(fraction(raises[i - 1].first),
+                            fraction(raises[i].first), fraction(raise_to));
+  return {{raises[i - 1].second, p}, {raises[i].second, 1.0 - p}};
+}
+
 std::unique_ptr<State> UniversalPokerState::Clone() const {
   return std::unique_ptr<State>(new UniversalPokerState(*this));
 }
@@ -396,14 +628,42 @@ std::vector<std::pair<Action, double>> UniversalPokerState::ChanceOutcomes()
   // We need to convert std::vector<uint8_t> into std::vector<Action>.
   std::vector<std::pair<Action, double>> outcomes;
   outcomes.reserve(num_cards);
+  if (!suit_isomorphism_) {
+    for (const auto &card : available_cards) {
+      outcomes.push_back({Action{card}, p});
+    }
+    return outcomes;
+  }
+
+  // Cards are merged into the lowest card they can be swapped with without
+  // changing anything dealt so far. It has the same rank and a lower suit, so
+  // it comes first in the deck and is still in it.
+  std::vector<logic::CardSet> dealt = hole_cards_;
+  dealt.push_back(board_cards_);
+  const logic::SuitPermutation interchangeable =
+      logic::InterchangeableSuits(dealt);
+  // Indexed by card; a CardSet holds at most 64 cards.
+  std::array<int, 64> outcome_index;
   for (const auto &card : available_cards) {
-    outcomes.push_back({Action{card}, p});
+    const uint8_t representative =
+        logic::RepresentativeCard(card, interchangeable);
+    if (representative == card) {
+      outcome_index[card] = outcomes.size();
+      outcomes.push_back({Action{card}, p});
+    } else {
+      outcomes[outcome_index[representative]].second += p;
+    }
   }
   return outcomes;
 }
 
 std::vector<Action> UniversalPokerState::LegalActions() const {
   if (IsChanceNode()) {
+    if (suit_isomorphism_) {
+      std::vector<Action> actions;
+      for (const auto &[card, p] : ChanceOutcomes()) actions.push_back(card);
+      return actions;
+    }
     std::vector<uint8_t> available_cards = deck_.ToCardArray();
     std::vector<Action> actions;
     actions.reserve(available_cards.size());
@@ -415,6 +675,15 @@ std::vector<Action> UniversalPokerState::LegalActions() const {
   std::vector<Action> legal_actions;
   if (ACTION_FOLD & possibleActions_) legal_actions.push_back(kFold);
   if (ACTION_CHECK_CALL & possibleActions_) legal_actions.push_back(kCall);
+  if (betting_abstraction_ == BettingAbstraction::kFCBA) {
+    for (int i = 0; i < betSizes_.size(); ++i) {
+      if (betSizes_[i] > 0) legal_actions.push_back(kBet + i);
+    }
+    if (ACTION_ALL_IN & possibleActions_) {
+      legal_actions.push_back(kBet + betSizes_.size());
+    }
+    return legal_actions;
+  }
   if (ACTION_BET & possibleActions_) legal_actions.push_back(kBet);
   if (ACTION_ALL_IN & possibleActions_) legal_actions.push_back(kAllIn);
   return legal_actions;
@@ -447,6 +716,17 @@ void UniversalPokerState::DoApplyAction(Action action_id) {
     }
   } else {
     int action_int = static_cast<int>(action_id);
+    if (betting_abstraction_ == BettingAbstraction::kFCBA &&
+        action_int >= kBet) {
+      const int bet_index = action_int - kBet;
+      if (bet_index == betSizes_.size()) {
+        ApplyChoiceAction(ACTION_ALL_IN);
+      } else {
+        SPIEL_CHECK_LT(bet_index, betSizes_.size());
+        ApplyBetAction(bet_index);
+      }
+      return;
+    }
     if (action_int == kFold) {
       ApplyChoiceAction(ACTION_FOLD);
       return;
@@ -470,18 +750,21 @@ void UniversalPokerState::DoApplyAction(Action action_id) {
 double UniversalPokerState::GetTotalReward(Player player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, acpc_game_->GetNbPlayers());
-  // Copy Board Cards and Hole Cards
+  // Copy Board Cards and Hole Cards. ToString shows the ACPC state, so with
+  // suit isomorphism it gets the canonical suits, which have the same value.
   uint8_t holeCards[10][3], boardCards[7], nbHoleCards[10];
+  const logic::SuitPermutation permutation = DealSuitPermutation();
 
   for (size_t p = 0; p < hole_cards_.size(); ++p) {
-    auto cards = hole_cards_[p].ToCardArray();
+    auto cards =
+        logic::PermuteSuits(hole_cards_[p], permutation).ToCardArray();
     for (size_t c = 0; c < cards.size(); ++c) {
       holeCards[p][c] = cards[c];
     }
     nbHoleCards[p] = cards.size();
   }
 
-  auto bc = board_cards_.ToCardArray();
+  auto bc = logic::PermuteSuits(board_cards_, permutation).ToCardArray();
   for (size_t c = 0; c < bc.size(); ++c) {
     boardCards[c] = bc[c];
   }
@@ -492,6 +775,54 @@ double UniversalPokerState::GetTotalReward(Player player) const {
   return acpc_state_.ValueOfState(player);
 }
 
+bool UniversalPokerState::GetSinglePotReturns(
+    std::vector<double> *returns) const {
+  const int num_players = acpc_game_->GetNbPlayers();
+  const int num_folded = acpc_state_.NumFolded();
+  if (num_folded == num_players - 1) {
+    // The last player in the hand wins what everybody else spent.
+    double pot = acpc_state_.TotalSpent();
+    for (Player p = 0; p < num_players; ++p) {
+      if (!acpc_state_.PlayerFolded(p)) {
+        (*returns)[p] = pot - acpc_state_.CurrentSpent(p);
+      } else {
+        (*returns)[p] = -static_cast<double>(acpc_state_.CurrentSpent(p));
+      }
+    }
+    return true;
+  }
+
+  // A showdown. Folded players' bets and uneven bets make side pots, which
+  // are left to ACPC.
+  if (num_folded > 0) return false;
+  const uint32_t spent = acpc_state_.CurrentSpent(0);
+  for (Player p = 1; p < num_players; ++p) {
+    if (acpc_state_.CurrentSpent(p) != spent) return false;
+  }
+
+  std::array<uint64_t, 10> hands;
+  std::array<int, 10> ranks;
+  for (Player p = 0; p < num_players; ++p) {
+    hands[p] = hole_cards_[p].cs.cards | board_cards_.cs.cards;
+  }
+  logic::RankHands(absl::MakeConstSpan(hands.data(), num_players),
+                   absl::MakeSpan(ranks.data(), num_players));
+  const int best_rank = *std::max_element(ranks.begin(),
+                                          ranks.begin() + num_players);
+  const int num_winners =
+      std::count(ranks.begin(), ranks.begin() + num_players, best_rank);
+  for (Player p = 0; p < num_players; ++p) {
+    if (ranks[p] == best_rank) {
+      (*returns)[p] =
+          static_cast<double>(spent) * (num_players - num_winners) /
+          num_winners;
+    } else {
+      (*returns)[p] = -static_cast<double>(spent);
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<HistoryDistribution>
 UniversalPokerState::GetHistoriesConsistentWithInfostate(int player_id) const {
   // This is only implemented for 2 players.
@@ -539,18 +870,84 @@ UniversalPokerGame::UniversalPokerGame(const GameParameters &params)
     : Game(kGameType, params),
       gameDesc_(parseParameters(params)),
       acpc_game_(gameDesc_) {
-  max_game_length_ = MaxGameLength();
-  SPIEL_CHECK_TRUE(max_game_length_.has_value());
   std::string betting_abstraction =
       ParameterValue<std::string>("bettingAbstraction");
   if (betting_abstraction == "fc") {
     betting_abstraction_ = BettingAbstraction::kFC;
   } else if (betting_abstraction == "fcpa") {
     betting_abstraction_ = BettingAbstraction::kFCPA;
+  } else if (betting_abstraction == "fcba") {
+    betting_abstraction_ = BettingAbstraction::kFCBA;
+    if (acpc_game_.IsLimitGame()) {
+      SpielFatalError("bettingAbstraction: fcba requires nolimit betting.");
+    }
+    ParseBetSizes(ParameterValue<std::string>("betSizes"));
   } else {
     SpielFatalError(absl::StrFormat("bettingAbstraction: %s not supported.",
                                     betting_abstraction));
   }
+  suit_isomorphism_ = ParameterValue<bool>("suitIsomorphism");
+
+  const std::string card_buckets = ParameterValue<std::string>("cardBuckets");
+  if (card_buckets != kEmptyString) {
+    logic::CardAbstractionConfig config;
+    config.num_suits = acpc_game_.NumSuitsDeck();
+    config.num_ranks = acpc_game_.NumRanksDeck();
+    config.num_hole_cards = acpc_game_.GetNbHoleCardsRequired();
+    for (int round = 0; round < acpc_game_.NumRounds(); ++round) {
+      config.num_board_cards.push_back(
+          acpc_game_.GetNbBoardCardsRequired(round));
+    }
+    for (absl::string_view num_buckets :
+         absl::StrSplit(card_buckets, ' ', absl::SkipEmpty())) {
+      int value;
+      if (!absl::SimpleAtoi(num_buckets, &value)) {
+        SpielFatalError(absl::StrCat("cardBuckets: invalid number ",
+                                     num_buckets));
+      }
+      config.num_buckets.push_back(value);
+    }
+    if (config.num_buckets.size() != acpc_game_.NumRounds()) {
+      SpielFatalError(absl::StrCat("cardBuckets: expected ",
+                                   acpc_game_.NumRounds(),
+                                   " numbers of buckets, got ", card_buckets));
+    }
+    config.num_threads = ParameterValue<int>("cardAbstractionThreads");
+    card_abstraction_ = logic::CardAbstraction::Create(
+        config, ParameterValue<std::string>("cardAbstractionCache"));
+  }
+
+  max_game_length_ = MaxGameLength();
+  SPIEL_CHECK_TRUE(max_game_length_.has_value());
+}
+
+void UniversalPokerGame::ParseBetSizes(const std::string &bet_sizes) {
+  const std::vector<std::string> rounds = absl::StrSplit(bet_sizes, '|');
+  if (rounds.size() != 1 && rounds.size() != acpc_game_.NumRounds()) {
+    SpielFatalError(absl::StrCat("betSizes: expected 1 or ",
+                                 acpc_game_.NumRounds(),
+                                 " lists of bets, got ", bet_sizes));
+  }
+  for (int round = 0; round < acpc_game_.NumRounds(); ++round) {
+    std::vector<double> fractions;
+    for (absl::string_view size :
+         absl::StrSplit(rounds[rounds.size() == 1 ? 0 : round], ' ',
+                        absl::SkipEmpty())) {
+      double fraction;
+      if (!absl::SimpleAtod(size, &fraction) || fraction <= 0 ||
+          (!fractions.empty() && fraction <= fractions.back())) {
+        SpielFatalError(absl::StrCat(
+            "betSizes: expected increasing positive numbers, got ", bet_sizes));
+      }
+      fractions.push_back(fraction);
+    }
+    num_bet_sizes_ = std::max<int>(num_bet_sizes_, fractions.size());
+    bet_sizes_.push_back(std::move(fractions));
+  }
+  // Bets are recorded in the action sequence as a single digit.
+  if (num_bet_sizes_ > 10) {
+    SpielFatalError("betSizes: at most 10 bets per round are supported.");
+  }
 }
 
 std::unique_ptr<State> UniversalPokerGame::NewInitialState() const {
@@ -561,11 +958,24 @@ std::vector<int> UniversalPokerGame::InformationStateTensorShape() const {
   // One-hot encoding for player number (who is to play).
   // 2 slots of cards (total_num_cards bits each): private card, public card
   // Followed by maximum game length * 2 bits each (call / raise)
+  // With a card abstraction, the cards are replaced by the one-hot encoding of
+  // the bucket at each round.
+  // With the kFCBA betting abstraction, each move is a one-hot encoding of the
+  // action instead.
   const int num_players = acpc_game_.GetNbPlayers();
   const int gameLength = MaxGameLength();
-  const int total_num_cards = MaxChanceOutcomes();
+  const int bits_per_move =
+      betting_abstraction_ == BettingAbstraction::kFCBA ? NumDistinctActions()
+                                                         : 2;
+  int card_size = 2 * MaxChanceOutcomes();
+  if (card_abstraction_ != nullptr) {
+    card_size = 0;
+    for (int round = 0; round < card_abstraction_->NumRounds(); ++round) {
+      card_size += card_abstraction_->NumBuckets(round);
+    }
+  }
 
-  return {num_players + 2 * total_num_cards + 2 * gameLength};
+  return {num_players + card_size + bits_per_move * gameLength};
 }
 
 std::vector<int> UniversalPokerGame::ObservationTensorShape() const {
@@ -603,6 +1013,9 @@ int UniversalPokerGame::MaxChanceOutcomes() const {
 int UniversalPokerGame::NumPlayers() const { return acpc_game_.GetNbPlayers(); }
 
 int UniversalPokerGame::NumDistinctActions() const {
+  if (betting_abstraction_ == BettingAbstraction::kFCBA) {
+    return kBet + num_bet_sizes_ + 1;
+  }
   return GetMaxBettingActions(acpc_game_);
 }
 
@@ -635,8 +1048,19 @@ int UniversalPokerGame::MaxGameLength() const {
         acpc_game_.BlindSize(p) > maxStack ? acpc_game_.BlindSize(p) : maxBlind;
   }
 
+  // You have always to bet the pot size, which at least doubles the largest
+  // amount spent. A bet of f times the pot after calling multiplies it by at
+  // least 1 + 2f.
+  double growth = 2.0;
+  if (betting_abstraction_ == BettingAbstraction::kFCBA) {
+    for (const std::vector<double> &fractions : bet_sizes_) {
+      if (!fractions.empty()) {
+        growth = std::min(growth, 1.0 + 2.0 * fractions.front());
+      }
+    }
+  }
   while (maxStack > maxBlind) {
-    maxStack /= 2.0;         // You have always to bet the pot size
+    maxStack /= growth;
     length += NumPlayers();  // Each player has to react
   }
   return length;
@@ -650,7 +1074,11 @@ int UniversalPokerGame::MaxGameLength() const {
 std::string UniversalPokerGame::parseParameters(const GameParameters &map) {
   if (map.find("gamedef") != map.end()) {
     // We check for sanity that all parameters are empty
-    if (map.size() != 1) {
+    int num_non_gamedef_parameters = 0;
+    for (absl::string_view key : kNonGamedefParameters) {
+      num_non_gamedef_parameters += map.count(std::string(key));
+    }
+    if (map.size() != 1 + num_non_gamedef_parameters) {
       std::vector<std::string> game_parameter_keys;
       game_parameter_keys.reserve(map.size());
       for (auto const &imap : map) {
@@ -734,8 +1162,19 @@ void UniversalPokerState::ApplyChoiceAction(ActionType action_type) {
   _CalculateActionsAndNodeType();
 }
 
+// Bets are recorded in the action sequence by their index, as a digit.
+void UniversalPokerState::ApplyBetAction(int bet_index) {
+  SPIEL_CHECK_GE(cur_player_, 0);
+  SPIEL_CHECK_GT(betSizes_[bet_index], 0);
+  actionSequence_ += static_cast<char>('0' + bet_index);
+  acpc_state_.DoAction(acpc_cpp::ACPCState::ACPCActionType::ACPC_RAISE,
+                       betSizes_[bet_index]);
+  _CalculateActionsAndNodeType();
+}
+
 void UniversalPokerState::_CalculateActionsAndNodeType() {
   possibleActions_ = 0;
+  std::fill(betSizes_.begin(), betSizes_.end(), 0);
 
   if (acpc_state_.IsFinished()) {
     if (acpc_state_.NumFolded() >= acpc_game_->GetNbPlayers() - 1) {
@@ -788,7 +1227,29 @@ void UniversalPokerState::_CalculateActionsAndNodeType() {
     bool valid_to_raise = acpc_state_.RaiseIsValid(&potSize_, &allInSize_);
     if (betting_abstraction_ == BettingAbstraction::kFC) return;
     if (valid_to_raise) {
-      if (acpc_game_->IsLimitGame()) {
+      if (betting_abstraction_ == BettingAbstraction::kFCBA) {
+        const int cur_spent =
+            acpc_state_.CurrentSpent(acpc_state_.CurrentPlayer());
+        const int max_spend = acpc_state_.MaxSpend();
+        const int pot_after_call =
+            acpc_state_.TotalSpent() + max_spend - cur_spent;
+        const std::vector<double> &fractions =
+            static_cast<const UniversalPokerGame *>(game_.get())
+                ->BetSizes(acpc_state_.GetRound());
+        int32_t previous = 0;
+        for (int i = 0; i < fractions.size(); ++i) {
+          const int32_t raise_to = std::max<int32_t>(
+              potSize_, max_spend + std::lround(fractions[i] * pot_after_call));
+          // Bets which end up equal, e.g. because of the minimum raise, are
+          // only offered once.
+          if (raise_to >= allInSize_) break;
+          if (raise_to == previous) continue;
+          betSizes_[i] = raise_to;
+          previous = raise_to;
+          possibleActions_ |= ACTION_BET;
+        }
+        possibleActions_ |= ACTION_ALL_IN;
+      } else if (acpc_game_->IsLimitGame()) {
         potSize_ = 0;
         // There's only one "bet" allowed in Limit, which is "all-in or fixed
         // bet".
@@ -814,10 +1275,20 @@ void UniversalPokerState::_CalculateActionsAndNodeType() {
 }
 
 const int UniversalPokerState::GetPossibleActionCount() const {
+  if (betting_abstraction_ == BettingAbstraction::kFCBA && !IsChanceNode()) {
+    return LegalActions().size();
+  }
   // _builtin_popcount(int) function is used to count the number of one's
   return __builtin_popcount(possibleActions_);
 }
 
+double PseudoHarmonicMapping(double a, double b, double bet) {
+  SPIEL_CHECK_LT(a, b);
+  SPIEL_CHECK_GE(bet, a);
+  SPIEL_CHECK_LE(bet, b);
+  return (b - bet) * (1 + a) / ((b - a) * (1 + bet));
+}
+
 std::ostream &operator<<(std::ostream &os, const BettingAbstraction &betting) {
   switch (betting) {
     case BettingAbstraction::kFC: {
@@ -828,6 +1299,10 @@ std::ostream &operator<<(std::ostream &os, const BettingAbstraction &betting) {
       os << "BettingAbstration: FCPA";
       break;
     }
+    case BettingAbstraction::kFCBA: {
+      os << "BettingAbstration: FCBA";
+      break;
+    }
     default:
       SpielFatalError("Unknown betting abstraction.");
       break;
@@ -21,7 +21,9 @@
 #include <vector>
 
 #include "open_spiel/games/universal_poker/acpc_cpp/acpc_game.h"
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
 #include "open_spiel/games/universal_poker/logic/card_set.h"
+#include "open_spiel/games/universal_poker/logic/suit_isomorphism.h"
 #include "open_spiel/spiel.h"
 
 // This is a wrapper around the Annual Computer Poker Competition bot (ACPC)
@@ -40,10 +42,22 @@ constexpr uint8_t kMaxUniversalPokerPlayers = 10;
 
 // This is the mapping from int to action. E.g. the legal action "0" is fold,
 // the legal action "1" is check/call, etc.
+// With the kFCBA betting abstraction, kBet + i is the i-th bet size of the
+// round and kBet + UniversalPokerGame::NumBetSizes() is all-in.
 enum ActionType { kFold = 0, kCall = 1, kBet = 2, kAllIn = 3 };
-enum BettingAbstraction { kFCPA = 0, kFC = 1 };
+// kFCPA: fold, call, pot bet and all-in.
+// kFC: fold and call.
+// kFCBA: fold, call, bets of given fractions of the pot and all-in.
+enum BettingAbstraction { kFCPA = 0, kFC = 1, kFCBA = 2 };
 std::ostream &operator<<(std::ostream &os, const BettingAbstraction &betting);
 
+// The pseudo-harmonic action translation of Ganzfried and Sandholm, "Action
+// Translation in Extensive-Form Games with Large Action Spaces" (IJCAI 2013).
+// Given bets of a < b times the pot in the abstraction, a bet of `bet` times
+// the pot, with a <= bet <= b, is mapped to a with the returned probability
+// and to b otherwise.
+double PseudoHarmonicMapping(double a, double b, double bet);
+
 class UniversalPokerState : public State {
  public:
   explicit UniversalPokerState(std::shared_ptr<const Game> game);
@@ -55,11 +69,12 @@ class UniversalPokerState : public State {
   std::string ToString() const override;
   std::vector<double> Returns() const override;
   std::string InformationStateString(Player player) const override;
+  absl::uint128 InformationStateFingerprint(Player player) const override;
   std::string ObservationString(Player player) const override;
   void InformationStateTensor(Player player,
-                              std::vector<double> *values) const override;
+                              absl::Span<float> values) const override;
   void ObservationTensor(Player player,
-                         std::vector<double> *values) const override;
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
 
   // The probability of taking each possible action in a particular info state.
@@ -70,6 +85,13 @@ class UniversalPokerState : public State {
   std::unique_ptr<HistoryDistribution> GetHistoriesConsistentWithInfostate(
       int player_id) const override;
 
+  // Maps a raise to `raise_to` chips in total, which need not be one of the
+  // abstraction's bets (e.g. an opponent's bet in the unabstracted game), to
+  // the legal raise actions using PseudoHarmonicMapping. Amounts below the
+  // smallest raise or above all-in map to that action. Returns the actions
+  // with their probabilities. Only for no-limit games.
+  std::vector<std::pair<Action, double>> TranslateRaise(int32_t raise_to) const;
+
  protected:
   void DoApplyAction(Action action_id) override;
   enum ActionType {
@@ -98,18 +120,42 @@ class UniversalPokerState : public State {
   uint32_t possibleActions_;
   int32_t potSize_ = 0;
   int32_t allInSize_ = 0;
+  // With kFCBA, the raise-to amount of each bet size, or 0 when the bet is not
+  // available.
+  std::vector<int32_t> betSizes_;
   std::string actionSequence_;
 
   BettingAbstraction betting_abstraction_;
+  bool suit_isomorphism_;
+  // Owned by the game; nullptr without a card abstraction.
+  const logic::CardAbstraction *card_abstraction_;
 
   void _CalculateActionsAndNodeType();
+  // The cards that `player` knows about, with the suits relabelled to the
+  // canonical ones when using suit isomorphism. Used by the information
+  // states and the observations.
+  void GetInformationStateCards(Player player, logic::CardSet *hole_cards,
+                                logic::CardSet *board_cards) const;
+  // Relabels the suits of the whole deal, hole cards and board, to the
+  // canonical ones when using suit isomorphism; the identity otherwise.
+  logic::SuitPermutation DealSuitPermutation() const;
+  // The card abstraction bucket of `player` at each round whose cards have
+  // all been dealt.
+  std::vector<int> GetCardBuckets(Player player) const;
+  // Writes the action sequence part of the information state tensor.
+  void AppendActionSequenceTensor(int offset, absl::Span<float> values) const;
 
   double GetTotalReward(Player player) const;
+  // Computes the returns of a terminal state without going through ACPC when
+  // there are no side pots, ranking the hands with logic::RankHands. Returns
+  // false, leaving `returns` untouched, in the other cases.
+  bool GetSinglePotReturns(std::vector<double> *returns) const;
 
   const uint32_t &GetPossibleActionsMask() const { return possibleActions_; }
   const int GetPossibleActionCount() const;
 
   void ApplyChoiceAction(ActionType action_type);
+  void ApplyBetAction(int bet_index);
   std::string GetActionSequence() const { return actionSequence_; }
 };
 
@@ -131,17 +177,36 @@ class UniversalPokerGame : public Game {
   BettingAbstraction betting_abstraction() const {
     return betting_abstraction_;
   }
+  bool suit_isomorphism() const { return suit_isomorphism_; }
+  // The kFCBA bet sizes of `round`, as increasing fractions of the pot.
+  const std::vector<double> &BetSizes(int round) const {
+    return bet_sizes_[round];
+  }
+  // The largest number of kFCBA bet sizes in a round.
+  int NumBetSizes() const { return num_bet_sizes_; }
+  // Returns nullptr when there is no card abstraction.
+  const logic::CardAbstraction *card_abstraction() const {
+    return card_abstraction_.get();
+  }
 
  private:
   std::string gameDesc_;
   const acpc_cpp::ACPCGame acpc_game_;
   std::optional<int> max_game_length_;
   BettingAbstraction betting_abstraction_ = BettingAbstraction::kFCPA;
+  bool suit_isomorphism_ = false;
+  std::vector<std::vector<double>> bet_sizes_;
+  int num_bet_sizes_ = 0;
+  std::shared_ptr<const logic::CardAbstraction> card_abstraction_;
 
  public:
   const acpc_cpp::ACPCGame *GetACPCGame() const { return &acpc_game_; }
 
   std::string parseParameters(const GameParameters &map);
+
+ private:
+  // Fills bet_sizes_ from the "betSizes" parameter.
+  void ParseBetSizes(const std::string &bet_sizes);
 };
 
 }  // namespace universal_poker
@@ -204,6 +204,11 @@ double ACPCState::ValueOfState(const uint8_t player) const {
                                            acpcState_.get(), player);
 }
 
+bool ACPCState::PlayerFolded(const uint8_t player) const {
+  assert(player < game_->acpc_game_->numPlayers);
+  return acpcState_->playerFolded[player];
+}
+
 bool ACPCState::IsFinished() const { return stateFinished(acpcState_.get()); }
 
 uint32_t ACPCState::MaxSpend() const { return acpcState_->maxSpent; }
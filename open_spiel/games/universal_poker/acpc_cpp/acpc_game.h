@@ -57,6 +57,7 @@ class ACPCState {
   // A showdown is still in game.NumRounds()-1, not a separate round
   int GetRound() const;
   uint8_t NumFolded() const;
+  bool PlayerFolded(const uint8_t player) const;
   uint32_t Money(const uint8_t player) const;
   uint32_t Ante(const uint8_t player) const;
   uint32_t TotalSpent() const;
@@ -0,0 +1,557 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/strings/strip.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+#include "open_spiel/games/universal_poker/logic/hand_evaluator.h"
+#include "open_spiel/games/universal_poker/logic/suit_isomorphism.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/fingerprint.h"
+#include "open_spiel/utils/varint.h"
+
+namespace open_spiel::universal_poker::logic {
+namespace {
+
+constexpr absl::string_view kCacheMagic = "CARDABS1";
+
+// Calls fn(begin, end) on `num_threads` consecutive slices of [0, n), each on
+// its own thread.
+template <typename Fn>
+void ParallelFor(int n, int num_threads, const Fn& fn) {
+  num_threads = std::max(1, std::min(num_threads, n));
+  if (num_threads == 1) {
+    fn(0, n);
+    return;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    const int begin = static_cast<int64_t>(n) * t / num_threads;
+    const int end = static_cast<int64_t>(n) * (t + 1) / num_threads;
+    threads.emplace_back([&fn, begin, end] { fn(begin, end); });
+  }
+  for (std::thread& thread : threads) thread.join();
+}
+
+// Calls fn(cards) with the union of every subset of `size` elements of
+// `card_bits`, where each element is the CardSet mask of a single card.
+template <typename Fn>
+void ForEachSubset(const std::vector<uint64_t>& card_bits, int size,
+                   const Fn& fn) {
+  const int n = card_bits.size();
+  if (size > n) return;
+  std::vector<int> index(size);
+  for (int i = 0; i < size; ++i) index[i] = i;
+  while (true) {
+    uint64_t cards = 0;
+    for (int i : index) cards |= card_bits[i];
+    fn(cards);
+    int i = size - 1;
+    while (i >= 0 && index[i] == n - size + i) --i;
+    if (i < 0) return;
+    ++index[i];
+    for (int j = i + 1; j < size; ++j) index[j] = index[j - 1] + 1;
+  }
+}
+
+// Returns the number of subsets of `size` elements of a set of `n`, capped at
+// `cap`.
+int64_t NumSubsets(int n, int size, int64_t cap) {
+  if (size > n) return 0;
+  double count = 1;
+  for (int i = 0; i < size; ++i) {
+    count = count * (n - i) / (i + 1);
+    if (count > cap) return cap;
+  }
+  return static_cast<int64_t>(count + 0.5);
+}
+
+// Returns the CardSet masks of the single cards of `cards`.
+std::vector<uint64_t> CardBits(uint64_t cards) {
+  std::vector<uint64_t> bits;
+  for (; cards != 0; cards &= cards - 1) bits.push_back(cards & -cards);
+  return bits;
+}
+
+absl::uint128 Key(const CardSet& hole_cards, const CardSet& board_cards) {
+  return absl::MakeUint128(hole_cards.cs.cards, board_cards.cs.cards);
+}
+
+absl::uint128 CanonicalKey(uint64_t hole_cards, uint64_t board_cards) {
+  std::array<CardSet, 2> groups;
+  groups[0].cs.cards = hole_cards;
+  groups[1].cs.cards = board_cards;
+  CanonicalizeSuits(absl::MakeSpan(groups));
+  return Key(groups[0], groups[1]);
+}
+
+// The canonical (hole cards, board) pairs of a round, with the number of
+// pairs of the full game that each of them stands for.
+struct CanonicalPairs {
+  std::vector<absl::uint128> keys;
+  std::vector<double> weights;
+};
+
+// Sorts `pairs` by key and merges duplicates, summing their weights.
+void SortAndMerge(std::vector<std::pair<absl::uint128, double>>* pairs) {
+  std::sort(pairs->begin(), pairs->end());
+  int size = 0;
+  for (int i = 0; i < pairs->size(); ++i) {
+    if (size > 0 && (*pairs)[size - 1].first == (*pairs)[i].first) {
+      (*pairs)[size - 1].second += (*pairs)[i].second;
+    } else {
+      (*pairs)[size++] = (*pairs)[i];
+    }
+  }
+  pairs->resize(size);
+}
+
+CanonicalPairs EnumerateCanonicalPairs(const CardAbstractionConfig& config,
+                                       int round) {
+  const uint64_t deck = CardSet(config.num_suits, config.num_ranks).cs.cards;
+  std::vector<std::pair<absl::uint128, double>> holes;
+  ForEachSubset(CardBits(deck), config.num_hole_cards, [&](uint64_t hole) {
+    holes.push_back({CanonicalKey(hole, 0), 1});
+  });
+  SortAndMerge(&holes);
+
+  std::vector<std::vector<std::pair<absl::uint128, double>>> per_hole(
+      holes.size());
+  ParallelFor(holes.size(), config.num_threads, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      const uint64_t hole = absl::Uint128High64(holes[i].first);
+      ForEachSubset(CardBits(deck & ~hole), config.num_board_cards[round],
+                    [&](uint64_t board) {
+                      per_hole[i].push_back(
+                          {CanonicalKey(hole, board), holes[i].second});
+                    });
+      SortAndMerge(&per_hole[i]);
+    }
+  });
+
+  std::vector<std::pair<absl::uint128, double>> all;
+  for (auto& pairs : per_hole) {
+    all.insert(all.end(), pairs.begin(), pairs.end());
+    pairs.clear();
+    pairs.shrink_to_fit();
+  }
+  SortAndMerge(&all);
+  CanonicalPairs result;
+  result.keys.reserve(all.size());
+  result.weights.reserve(all.size());
+  for (const auto& [key, weight] : all) {
+    result.keys.push_back(key);
+    result.weights.push_back(weight);
+  }
+  return result;
+}
+
+// Returns the probability that `hole` beats a uniformly random opponent hand
+// drawn from `available`, ties counting as one half.
+double HandStrength(uint64_t hole, uint64_t board,
+                    const std::vector<uint64_t>& available,
+                    int num_hole_cards) {
+  const int rank = RankHand(hole | board);
+  double score = 0;
+  int64_t num_hands = 0;
+  ForEachSubset(available, num_hole_cards, [&](uint64_t opponent) {
+    const int opponent_rank = RankHand(opponent | board);
+    score += rank > opponent_rank ? 1.0 : rank == opponent_rank ? 0.5 : 0.0;
+    ++num_hands;
+  });
+  return num_hands == 0 ? 0.5 : score / num_hands;
+}
+
+// The features of a hand clustered by k-means, and its expected hand
+// strength.
+struct Features {
+  std::vector<float> values;
+  double ehs = 0;
+};
+
+// Returns the hand strength in the last round, and otherwise the cumulative
+// histogram of the final hand strength over the runouts.
+Features ComputeFeatures(const CardAbstractionConfig& config, int round,
+                         absl::uint128 key) {
+  const uint64_t hole = absl::Uint128High64(key);
+  const uint64_t board = absl::Uint128Low64(key);
+  const uint64_t deck = CardSet(config.num_suits, config.num_ranks).cs.cards;
+  const std::vector<uint64_t> rest = CardBits(deck & ~hole & ~board);
+  const int num_runout_cards =
+      config.num_board_cards.back() - config.num_board_cards[round];
+  Features features;
+  if (num_runout_cards == 0) {
+    features.ehs = HandStrength(hole, board, rest, config.num_hole_cards);
+    features.values = {static_cast<float>(features.ehs)};
+    return features;
+  }
+
+  const int num_bins = config.num_histogram_bins;
+  std::vector<double> histogram(num_bins, 0.0);
+  int64_t num_runouts = 0;
+  auto add_runout = [&](uint64_t runout) {
+    std::vector<uint64_t> available;
+    available.reserve(rest.size());
+    for (uint64_t card : rest) {
+      if (!(card & runout)) available.push_back(card);
+    }
+    const double strength =
+        HandStrength(hole, board | runout, available, config.num_hole_cards);
+    histogram[std::min(static_cast<int>(strength * num_bins), num_bins - 1)]++;
+    features.ehs += strength;
+    ++num_runouts;
+  };
+  if (NumSubsets(rest.size(), num_runout_cards, config.max_runouts + 1) <=
+      config.max_runouts) {
+    ForEachSubset(rest, num_runout_cards, add_runout);
+  } else {
+    // Seeded by the hand, so that the result does not depend on the order in
+    // which hands are processed.
+    std::mt19937_64 rng(absl::Uint128Low64(
+        Fingerprinter().Add(config.seed).Add(hole).Add(board).Fingerprint()));
+    std::vector<uint64_t> cards = rest;
+    for (int i = 0; i < config.max_runouts; ++i) {
+      uint64_t runout = 0;
+      for (int j = 0; j < num_runout_cards; ++j) {
+        std::uniform_int_distribution<int> dist(j, cards.size() - 1);
+        std::swap(cards[j], cards[dist(rng)]);
+        runout |= cards[j];
+      }
+      add_runout(runout);
+    }
+  }
+  features.ehs /= num_runouts;
+  double cumulative = 0;
+  for (double count : histogram) {
+    cumulative += count / num_runouts;
+    features.values.push_back(cumulative);
+  }
+  return features;
+}
+
+double SquaredDistance(const float* a, const float* b, int dim) {
+  double distance = 0;
+  for (int i = 0; i < dim; ++i) distance += (a[i] - b[i]) * (a[i] - b[i]);
+  return distance;
+}
+
+// Weighted k-means of the `points` (row-major, `dim` values each), seeded
+// with k-means++. Returns the cluster of each point, the clusters being
+// numbered by increasing weighted mean of `ehs`.
+std::vector<uint16_t> KMeans(const std::vector<float>& points, int dim,
+                             const std::vector<double>& weights,
+                             const std::vector<double>& ehs, int num_clusters,
+                             const CardAbstractionConfig& config) {
+  const int n = weights.size();
+  std::vector<int> assignment(n);
+  if (n <= num_clusters) {
+    for (int i = 0; i < n; ++i) assignment[i] = i;
+    num_clusters = n;
+  } else {
+    std::mt19937_64 rng(config.seed);
+    std::vector<float> centers;
+    centers.reserve(num_clusters * dim);
+    std::vector<double> distances(n, std::numeric_limits<double>::infinity());
+    int next = std::discrete_distribution<int>(weights.begin(),
+                                               weights.end())(rng);
+    for (int c = 0; c < num_clusters; ++c) {
+      centers.insert(centers.end(), points.begin() + next * dim,
+                     points.begin() + (next + 1) * dim);
+      std::vector<double> scores(n);
+      double total = 0;
+      for (int i = 0; i < n; ++i) {
+        distances[i] = std::min(
+            distances[i],
+            SquaredDistance(&points[i * dim], &centers[c * dim], dim));
+        scores[i] = weights[i] * distances[i];
+        total += scores[i];
+      }
+      // Fewer distinct points than clusters: the remaining ones stay empty.
+      if (total == 0) break;
+      next = std::discrete_distribution<int>(scores.begin(), scores.end())(rng);
+    }
+    num_clusters = centers.size() / dim;
+
+    std::fill(assignment.begin(), assignment.end(), -1);
+    for (int iteration = 0; iteration < config.num_kmeans_iterations;
+         ++iteration) {
+      std::atomic<int64_t> num_changed = 0;
+      ParallelFor(n, config.num_threads, [&](int begin, int end) {
+        int64_t changed = 0;
+        for (int i = begin; i < end; ++i) {
+          int best = 0;
+          double best_distance = std::numeric_limits<double>::infinity();
+          for (int c = 0; c < num_clusters; ++c) {
+            const double distance =
+                SquaredDistance(&points[i * dim], &centers[c * dim], dim);
+            if (distance < best_distance) {
+              best = c;
+              best_distance = distance;
+            }
+          }
+          if (assignment[i] != best) {
+            assignment[i] = best;
+            ++changed;
+          }
+        }
+        num_changed += changed;
+      });
+      if (num_changed == 0) break;
+      std::vector<double> sums(num_clusters * dim, 0.0);
+      std::vector<double> cluster_weights(num_clusters, 0.0);
+      for (int i = 0; i < n; ++i) {
+        cluster_weights[assignment[i]] += weights[i];
+        for (int d = 0; d < dim; ++d) {
+          sums[assignment[i] * dim + d] += weights[i] * points[i * dim + d];
+        }
+      }
+      for (int c = 0; c < num_clusters; ++c) {
+        // Empty clusters keep their center.
+        if (cluster_weights[c] == 0) continue;
+        for (int d = 0; d < dim; ++d) {
+          centers[c * dim + d] = sums[c * dim + d] / cluster_weights[c];
+        }
+      }
+    }
+  }
+
+  // Number the clusters by increasing EHS.
+  std::vector<double> ehs_sums(num_clusters, 0.0);
+  std::vector<double> cluster_weights(num_clusters, 0.0);
+  for (int i = 0; i < n; ++i) {
+    ehs_sums[assignment[i]] += weights[i] * ehs[i];
+    cluster_weights[assignment[i]] += weights[i];
+  }
+  std::vector<int> order(num_clusters);
+  for (int c = 0; c < num_clusters; ++c) order[c] = c;
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return ehs_sums[a] * cluster_weights[b] < ehs_sums[b] * cluster_weights[a];
+  });
+  std::vector<uint16_t> label(num_clusters);
+  for (int c = 0; c < num_clusters; ++c) label[order[c]] = c;
+  std::vector<uint16_t> buckets(n);
+  for (int i = 0; i < n; ++i) buckets[i] = label[assignment[i]];
+  return buckets;
+}
+
+// Describes every parameter the buckets depend on.
+std::string ConfigDescription(const CardAbstractionConfig& config) {
+  return absl::StrCat(
+      "suits=", config.num_suits, ",ranks=", config.num_ranks,
+      ",hole=", config.num_hole_cards,
+      ",board=", absl::StrJoin(config.num_board_cards, " "),
+      ",buckets=", absl::StrJoin(config.num_buckets, " "),
+      ",bins=", config.num_histogram_bins, ",runouts=", config.max_runouts,
+      ",iterations=", config.num_kmeans_iterations, ",seed=", config.seed);
+}
+
+}  // namespace
+
+CardAbstraction::CardAbstraction(const CardAbstractionConfig& config)
+    : CardAbstraction(config, /*compute=*/true) {}
+
+CardAbstraction::CardAbstraction(const CardAbstractionConfig& config,
+                                 bool compute)
+    : config_(config) {
+  SPIEL_CHECK_GE(config_.num_suits, 1);
+  SPIEL_CHECK_LE(config_.num_suits, kMaxSuits);
+  SPIEL_CHECK_GE(config_.num_ranks, 1);
+  SPIEL_CHECK_LE(config_.num_ranks, 13);
+  SPIEL_CHECK_GE(config_.num_hole_cards, 1);
+  SPIEL_CHECK_FALSE(config_.num_buckets.empty());
+  SPIEL_CHECK_EQ(config_.num_buckets.size(), config_.num_board_cards.size());
+  for (int round = 0; round < NumRounds(); ++round) {
+    SPIEL_CHECK_GE(config_.num_buckets[round], 1);
+    SPIEL_CHECK_LE(config_.num_buckets[round],
+                   std::numeric_limits<uint16_t>::max());
+    if (round > 0) {
+      SPIEL_CHECK_GE(config_.num_board_cards[round],
+                     config_.num_board_cards[round - 1]);
+    }
+  }
+  SPIEL_CHECK_LE(2 * config_.num_hole_cards + config_.num_board_cards.back(),
+                 config_.num_suits * config_.num_ranks);
+  SPIEL_CHECK_GE(config_.num_histogram_bins, 1);
+  SPIEL_CHECK_GE(config_.max_runouts, 1);
+  if (config_.num_threads <= 0) {
+    config_.num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  keys_.resize(NumRounds());
+  buckets_.resize(NumRounds());
+  if (!compute) return;
+
+  for (int round = 0; round < NumRounds(); ++round) {
+    CanonicalPairs pairs = EnumerateCanonicalPairs(config_, round);
+    const int n = pairs.keys.size();
+    std::vector<Features> features(n);
+    ParallelFor(n, config_.num_threads, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        features[i] = ComputeFeatures(config_, round, pairs.keys[i]);
+      }
+    });
+    const int dim = features.empty() ? 0 : features[0].values.size();
+    std::vector<float> points;
+    points.reserve(static_cast<int64_t>(n) * dim);
+    std::vector<double> ehs(n);
+    for (int i = 0; i < n; ++i) {
+      points.insert(points.end(), features[i].values.begin(),
+                    features[i].values.end());
+      ehs[i] = features[i].ehs;
+    }
+    features.clear();
+    buckets_[round] = KMeans(points, dim, pairs.weights, ehs,
+                             config_.num_buckets[round], config_);
+    keys_[round] = std::move(pairs.keys);
+  }
+}
+
+std::shared_ptr<const CardAbstraction> CardAbstraction::Create(
+    const CardAbstractionConfig& config, const std::string& cache_dir) {
+  if (cache_dir.empty()) return std::make_shared<CardAbstraction>(config);
+
+  const std::string path = absl::StrCat(cache_dir, "/", CacheFileName(config));
+  std::ifstream input(path, std::ios::binary);
+  if (input) {
+    std::ostringstream data;
+    data << input.rdbuf();
+    std::shared_ptr<CardAbstraction> abstraction(
+        new CardAbstraction(config, /*compute=*/false));
+    if (abstraction->Deserialize(data.str())) return abstraction;
+  }
+
+  auto abstraction = std::make_shared<CardAbstraction>(config);
+  // Written under a temporary name first, so that processes computing the
+  // same abstraction concurrently never read a partial file.
+  // The process id and a random suffix keep the name unique across processes
+  // and threads.
+  const std::string temp_path = absl::StrCat(
+      path, ".tmp", getpid(), "_", std::random_device()());
+  {
+    std::ofstream output(temp_path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+      SpielFatalError(absl::StrCat("Cannot write the card abstraction to ",
+                                   temp_path));
+    }
+    const std::string data = abstraction->Serialize();
+    output.write(data.data(), data.size());
+    if (!output) {
+      SpielFatalError(absl::StrCat("Failed writing ", temp_path));
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    SpielFatalError(absl::StrCat("Cannot rename ", temp_path, " to ", path));
+  }
+  return abstraction;
+}
+
+int CardAbstraction::Bucket(int round, const CardSet& hole_cards,
+                            const CardSet& board_cards) const {
+  SPIEL_CHECK_GE(round, 0);
+  SPIEL_CHECK_LT(round, NumRounds());
+  std::array<CardSet, 2> groups = {hole_cards, board_cards};
+  CanonicalizeSuits(absl::MakeSpan(groups));
+  const absl::uint128 key = Key(groups[0], groups[1]);
+  const std::vector<absl::uint128>& keys = keys_[round];
+  auto it = std::lower_bound(keys.begin(), keys.end(), key);
+  if (it == keys.end() || *it != key) {
+    SpielFatalError(absl::StrCat("No bucket for hole cards ",
+                                 hole_cards.ToString(), " and board ",
+                                 board_cards.ToString(), " in round ", round));
+  }
+  return buckets_[round][it - keys.begin()];
+}
+
+std::string CardAbstraction::CacheFileName(
+    const CardAbstractionConfig& config) {
+  const absl::uint128 fingerprint =
+      Fingerprinter().Add(ConfigDescription(config)).Fingerprint();
+  return absl::StrFormat("card_abstraction_%016x%016x.bin",
+                         absl::Uint128High64(fingerprint),
+                         absl::Uint128Low64(fingerprint));
+}
+
+std::string CardAbstraction::Serialize() const {
+  std::string data(kCacheMagic);
+  const std::string description = ConfigDescription(config_);
+  AppendVarint(description.size(), &data);
+  data += description;
+  for (int round = 0; round < NumRounds(); ++round) {
+    AppendVarint(keys_[round].size(), &data);
+    for (int i = 0; i < keys_[round].size(); ++i) {
+      AppendVarint(absl::Uint128High64(keys_[round][i]), &data);
+      AppendVarint(absl::Uint128Low64(keys_[round][i]), &data);
+      AppendVarint(buckets_[round][i], &data);
+    }
+  }
+  return data;
+}
+
+bool CardAbstraction::Deserialize(const std::string& data) {
+  absl::string_view view = data;
+  if (!absl::ConsumePrefix(&view, kCacheMagic)) return false;
+  const std::string description = ConfigDescription(config_);
+  uint64_t description_size;
+  if (!TryReadVarint(&view, &description_size) ||
+      description_size != description.size() ||
+      !absl::ConsumePrefix(&view, description)) {
+    return false;
+  }
+  for (int round = 0; round < NumRounds(); ++round) {
+    uint64_t size;
+    // Every pair takes at least three bytes.
+    if (!TryReadVarint(&view, &size) || size > view.size() / 3) return false;
+    keys_[round].resize(size);
+    buckets_[round].resize(size);
+    for (int i = 0; i < size; ++i) {
+      uint64_t high, low, bucket;
+      if (!TryReadVarint(&view, &high) || !TryReadVarint(&view, &low) ||
+          !TryReadVarint(&view, &bucket) || bucket >= NumBuckets(round)) {
+        return false;
+      }
+      keys_[round][i] = absl::MakeUint128(high, low);
+      // Bucket looks the keys up by binary search.
+      if (i > 0 && keys_[round][i] <= keys_[round][i - 1]) return false;
+      buckets_[round][i] = bucket;
+    }
+  }
+  return view.empty();
+}
+
+}  // namespace open_spiel::universal_poker::logic
@@ -0,0 +1,116 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef OPEN_SPIEL_CARD_ABSTRACTION_H
+#define OPEN_SPIEL_CARD_ABSTRACTION_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+
+// The parameters of a card abstraction. The deck and the number of cards
+// dealt match the game's; the rest controls how the buckets are computed.
+struct CardAbstractionConfig {
+  int num_suits = 4;
+  int num_ranks = 13;
+  int num_hole_cards = 2;
+  // The total number of board cards revealed by the end of each round's deal,
+  // e.g. {0, 3, 4, 5} for Texas hold'em.
+  std::vector<int> num_board_cards;
+  // The number of buckets at each round.
+  std::vector<int> num_buckets;
+  // The number of bins of the hand strength histograms of the rounds before
+  // the last one.
+  int num_histogram_bins = 10;
+  // The runouts of the remaining board cards are enumerated when there are at
+  // most this many of them, and sampled otherwise.
+  int max_runouts = 1000;
+  int num_kmeans_iterations = 50;
+  // 0 uses one thread per core.
+  int num_threads = 0;
+  int seed = 0;
+};
+
+// A card abstraction groups the (hole cards, board) pairs of each round into
+// a fixed number of buckets of hands which play alike, so that an information
+// state can refer to its bucket rather than to the exact cards.
+//
+// The hand strength of the hole cards on a final board is the probability of
+// beating a uniformly random opponent hand, counting ties as one half. In the
+// last round, the buckets cluster the hand strength; in earlier rounds, they
+// cluster the histogram of the final hand strength over the runouts of the
+// remaining board cards, whose mean is the expected hand strength (EHS). Two
+// hands with the same EHS but different potential thus usually end up in
+// different buckets. Clustering uses k-means, the histograms being compared
+// through their cumulative distributions (a proxy for the earth mover's
+// distance), and the buckets are numbered by increasing EHS.
+//
+// Pairs are enumerated up to suit isomorphism, so each round stores one
+// bucket per class of isomorphic pairs. This is only practical for decks of
+// moderate size: the classes of the Texas hold'em river alone number in the
+// hundreds of millions.
+class CardAbstraction {
+ public:
+  // Computes the buckets using config.num_threads threads.
+  explicit CardAbstraction(const CardAbstractionConfig& config);
+
+  // Returns an abstraction for `config`. When `cache_dir` is not empty, the
+  // buckets are read from a file of that directory named after the
+  // configuration if it exists, and written to it after being computed
+  // otherwise.
+  static std::shared_ptr<const CardAbstraction> Create(
+      const CardAbstractionConfig& config, const std::string& cache_dir);
+
+  const CardAbstractionConfig& Config() const { return config_; }
+  int NumRounds() const { return config_.num_buckets.size(); }
+  int NumBuckets(int round) const { return config_.num_buckets[round]; }
+
+  // Returns the bucket of the hand at `round`. The board must hold exactly the
+  // cards revealed by that round.
+  int Bucket(int round, const CardSet& hole_cards,
+             const CardSet& board_cards) const;
+
+  // Returns the name of the cache file for `config`, which identifies every
+  // parameter the buckets depend on.
+  static std::string CacheFileName(const CardAbstractionConfig& config);
+
+ private:
+  CardAbstraction(const CardAbstractionConfig& config, bool compute);
+
+  std::string Serialize() const;
+  // Returns false if `data` does not hold buckets for this configuration,
+  // including when it is truncated or corrupt.
+  bool Deserialize(const std::string& data);
+
+  CardAbstractionConfig config_;
+  // For each round, the canonical pairs in increasing order and their
+  // buckets, where a pair is keyed by its (hole cards, board) bit masks.
+  std::vector<std::vector<absl::uint128>> keys_;
+  std::vector<std::vector<uint16_t>> buckets_;
+};
+
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_CARD_ABSTRACTION_H
@@ -0,0 +1,206 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+#include "open_spiel/games/universal_poker/logic/suit_isomorphism.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+namespace {
+
+// A Leduc-like deck, with more ranks.
+CardAbstractionConfig SmallConfig() {
+  CardAbstractionConfig config;
+  config.num_suits = 2;
+  config.num_ranks = 5;
+  config.num_hole_cards = 1;
+  config.num_board_cards = {0, 1};
+  config.num_buckets = {5, 4};
+  config.num_threads = 1;
+  return config;
+}
+
+CardAbstractionConfig HoldemLikeConfig() {
+  CardAbstractionConfig config;
+  config.num_suits = 4;
+  config.num_ranks = 6;
+  config.num_hole_cards = 2;
+  config.num_board_cards = {0, 2, 3};
+  config.num_buckets = {4, 8, 8};
+  config.max_runouts = 50;
+  config.num_threads = 1;
+  return config;
+}
+
+// Calls fn(hole_cards, board_cards) on every deal of `round`.
+template <typename Fn>
+void ForEachDeal(const CardAbstractionConfig& config, int round,
+                 const Fn& fn) {
+  const int num_cards = config.num_suits * config.num_ranks;
+  std::vector<int> cards;
+  for (int r = 0; r < config.num_ranks; ++r) {
+    for (int s = 0; s < config.num_suits; ++s) {
+      cards.push_back(r * kMaxSuits + s);
+    }
+  }
+  const int num_dealt =
+      config.num_hole_cards + config.num_board_cards[round];
+  std::vector<bool> selected(num_cards, false);
+  std::fill(selected.begin(), selected.begin() + num_dealt, true);
+  do {
+    std::vector<int> dealt;
+    for (int i = 0; i < num_cards; ++i) {
+      if (selected[i]) dealt.push_back(cards[i]);
+    }
+    // Every split of the dealt cards between the hole and the board.
+    std::vector<bool> in_hole(num_dealt, false);
+    std::fill(in_hole.begin(), in_hole.begin() + config.num_hole_cards, true);
+    do {
+      CardSet hole_cards;
+      CardSet board_cards;
+      for (int i = 0; i < num_dealt; ++i) {
+        (in_hole[i] ? hole_cards : board_cards).AddCard(dealt[i]);
+      }
+      fn(hole_cards, board_cards);
+    } while (std::prev_permutation(in_hole.begin(), in_hole.end()));
+  } while (std::prev_permutation(selected.begin(), selected.end()));
+}
+
+void PreflopBucketsAreRanks() {
+  CardAbstraction abstraction(SmallConfig());
+  for (int rank = 0; rank < 5; ++rank) {
+    for (int suit = 0; suit < 2; ++suit) {
+      SPIEL_CHECK_EQ(abstraction.Bucket(0, CardSet(std::vector<int>{rank * kMaxSuits + suit}),
+                                        CardSet()),
+                     rank);
+    }
+  }
+  // Pairing the board makes the best hands.
+  const int top_bucket = abstraction.NumBuckets(1) - 1;
+  SPIEL_CHECK_EQ(abstraction.Bucket(1, CardSet("2c"), CardSet("2d")),
+                 top_bucket);
+  SPIEL_CHECK_LT(abstraction.Bucket(1, CardSet("5c"), CardSet("2d")),
+                 top_bucket);
+}
+
+void BucketsAreInRangeAndSuitInvariant() {
+  const CardAbstractionConfig config = HoldemLikeConfig();
+  CardAbstraction abstraction(config);
+  for (int round = 0; round < abstraction.NumRounds(); ++round) {
+    std::vector<bool> used(abstraction.NumBuckets(round), false);
+    ForEachDeal(config, round, [&](const CardSet& hole_cards,
+                                   const CardSet& board_cards) {
+      const int bucket = abstraction.Bucket(round, hole_cards, board_cards);
+      SPIEL_CHECK_GE(bucket, 0);
+      SPIEL_CHECK_LT(bucket, abstraction.NumBuckets(round));
+      used[bucket] = true;
+      const SuitPermutation reverse = {3, 2, 1, 0};
+      SPIEL_CHECK_EQ(bucket,
+                     abstraction.Bucket(round, PermuteSuits(hole_cards, reverse),
+                                        PermuteSuits(board_cards, reverse)));
+    });
+    SPIEL_CHECK_TRUE(std::all_of(used.begin(), used.end(),
+                                 [](bool b) { return b; }));
+  }
+}
+
+bool SameBuckets(const CardAbstraction& a, const CardAbstraction& b) {
+  bool same = true;
+  for (int round = 0; round < a.NumRounds(); ++round) {
+    ForEachDeal(a.Config(), round, [&](const CardSet& hole_cards,
+                                       const CardSet& board_cards) {
+      same = same && a.Bucket(round, hole_cards, board_cards) ==
+                         b.Bucket(round, hole_cards, board_cards);
+    });
+  }
+  return same;
+}
+
+void ResultDoesNotDependOnThreads() {
+  CardAbstractionConfig config = HoldemLikeConfig();
+  CardAbstraction single_threaded(config);
+  config.num_threads = 4;
+  CardAbstraction multi_threaded(config);
+  SPIEL_CHECK_TRUE(SameBuckets(single_threaded, multi_threaded));
+}
+
+void CacheRoundTrip() {
+  char dir_template[] = "/tmp/card_abstraction_test_XXXXXX";
+  const std::string dir = mkdtemp(dir_template);
+  const CardAbstractionConfig config = HoldemLikeConfig();
+  const std::string path =
+      absl::StrCat(dir, "/", CardAbstraction::CacheFileName(config));
+
+  std::shared_ptr<const CardAbstraction> computed =
+      CardAbstraction::Create(config, dir);
+  SPIEL_CHECK_TRUE(std::ifstream(path).good());
+  std::shared_ptr<const CardAbstraction> loaded =
+      CardAbstraction::Create(config, dir);
+  SPIEL_CHECK_TRUE(SameBuckets(*computed, *loaded));
+
+  // Another configuration uses another file.
+  CardAbstractionConfig other = config;
+  other.num_buckets.back() = 3;
+  SPIEL_CHECK_NE(CardAbstraction::CacheFileName(other),
+                 CardAbstraction::CacheFileName(config));
+
+  // A file which does not match is recomputed and replaced.
+  std::ofstream(path, std::ios::trunc) << "garbage";
+  loaded = CardAbstraction::Create(config, dir);
+  SPIEL_CHECK_TRUE(SameBuckets(*computed, *loaded));
+
+  // So is a truncated or corrupt one.
+  std::ostringstream data;
+  data << std::ifstream(path, std::ios::binary).rdbuf();
+  const std::string valid = data.str();
+  std::string corrupt = valid;
+  corrupt.back() = '\x7f';  // Not a bucket.
+  for (const std::string& contents :
+       {valid.substr(0, valid.size() - 1), valid.substr(0, valid.size() / 2),
+        corrupt, valid + '\x80'}) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << contents;
+    loaded = CardAbstraction::Create(config, dir);
+    SPIEL_CHECK_TRUE(SameBuckets(*computed, *loaded));
+  }
+
+  std::remove(path.c_str());
+  std::remove(dir.c_str());
+}
+
+}  // namespace
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::universal_poker::logic::PreflopBucketsAreRanks();
+  open_spiel::universal_poker::logic::BucketsAreInRangeAndSuitInvariant();
+  open_spiel::universal_poker::logic::ResultDoesNotDependOnThreads();
+  open_spiel::universal_poker::logic::CacheRoundTrip();
+}
@@ -0,0 +1,178 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/universal_poker/logic/hand_evaluator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel::universal_poker::logic {
+namespace {
+
+constexpr int kNumRanks = 13;
+constexpr int kNumMasks = 1 << kNumRanks;
+constexpr uint16_t kRankMask = kNumMasks - 1;
+
+// A rank is the hand category in bits 20 and up, followed by up to five
+// 4-bit values in bits 0-19, most significant first. Each value is a card
+// rank plus one, so that a missing kicker compares below any card.
+enum Category {
+  kHighCard = 0,
+  kPair,
+  kTwoPair,
+  kThreeOfAKind,
+  kStraight,
+  kFlush,
+  kFullHouse,
+  kFourOfAKind,
+  kStraightFlush,
+};
+
+constexpr int kCategoryShift = 20;
+
+struct Tables {
+  // The ranks of the (up to) five highest cards of the mask, packed as above.
+  std::array<uint32_t, kNumMasks> top_five;
+  // The highest card of the best straight in the mask, or -1.
+  std::array<int8_t, kNumMasks> straight_high;
+
+  Tables() {
+    for (int mask = 0; mask < kNumMasks; ++mask) {
+      uint32_t packed = 0;
+      int count = 0;
+      for (int rank = kNumRanks - 1; rank >= 0 && count < 5; --rank) {
+        if (mask & (1 << rank)) {
+          packed |= (rank + 1) << (4 * (4 - count));
+          ++count;
+        }
+      }
+      top_five[mask] = packed;
+
+      straight_high[mask] = -1;
+      for (int high = kNumRanks - 1; high >= 4; --high) {
+        const int straight = 0x1f << (high - 4);
+        if ((mask & straight) == straight) {
+          straight_high[mask] = high;
+          break;
+        }
+      }
+      // The wheel: A-2-3-4-5, with the five as the highest card.
+      const int wheel = (1 << (kNumRanks - 1)) | 0xf;
+      if (straight_high[mask] < 0 && (mask & wheel) == wheel) {
+        straight_high[mask] = 3;
+      }
+    }
+  }
+};
+
+const Tables& GetTables() {
+  static const Tables* tables = new Tables();
+  return *tables;
+}
+
+int HighestRank(uint32_t mask) { return 31 - __builtin_clz(mask); }
+
+// The `count` highest ranks of `mask`, packed into the 4 * count most
+// significant bits of the 20 kicker bits.
+uint32_t TopRanks(const Tables& tables, uint32_t mask, int count) {
+  return tables.top_five[mask] & (0xfffffu << (4 * (5 - count)));
+}
+
+int Rank(int category, uint32_t values) {
+  return (category << kCategoryShift) | values;
+}
+
+int RankHand(const Tables& tables, uint64_t cards) {
+  const uint32_t s0 = cards & kRankMask;
+  const uint32_t s1 = (cards >> 16) & kRankMask;
+  const uint32_t s2 = (cards >> 32) & kRankMask;
+  const uint32_t s3 = (cards >> 48) & kRankMask;
+  const uint32_t ranks = s0 | s1 | s2 | s3;
+
+  // Hands of more than 9 cards can hold two flushes.
+  int straight_flush_high = -1;
+  uint32_t flush = 0;
+  for (uint32_t suit : {s0, s1, s2, s3}) {
+    if (__builtin_popcount(suit) < 5) continue;
+    straight_flush_high =
+        std::max<int>(straight_flush_high, tables.straight_high[suit]);
+    flush = std::max(flush, TopRanks(tables, suit, 5));
+  }
+  if (straight_flush_high >= 0) {
+    return Rank(kStraightFlush, (straight_flush_high + 1) << 16);
+  }
+
+  const uint32_t quads = s0 & s1 & s2 & s3;
+  if (quads) {
+    const int quad = HighestRank(quads);
+    return Rank(kFourOfAKind, (quad + 1) << 16 |
+                                  TopRanks(tables, ranks & ~(1 << quad), 1) >>
+                                      4);
+  }
+
+  const uint32_t trips =
+      (s0 & s1 & s2) | (s0 & s1 & s3) | (s0 & s2 & s3) | (s1 & s2 & s3);
+  const uint32_t pairs = (s0 & s1) | (s0 & s2) | (s0 & s3) | (s1 & s2) |
+                         (s1 & s3) | (s2 & s3);
+  if (trips) {
+    const int trip = HighestRank(trips);
+    // A second set of trips also fills the house.
+    const uint32_t others = pairs & ~(1 << trip);
+    if (others) {
+      return Rank(kFullHouse, (trip + 1) << 16 | (HighestRank(others) + 1)
+                                                     << 12);
+    }
+  }
+  if (flush) return Rank(kFlush, flush);
+  if (tables.straight_high[ranks] >= 0) {
+    return Rank(kStraight, (tables.straight_high[ranks] + 1) << 16);
+  }
+  if (trips) {
+    const int trip = HighestRank(trips);
+    return Rank(kThreeOfAKind, (trip + 1) << 16 |
+                                   TopRanks(tables, ranks & ~(1 << trip), 2) >>
+                                       4);
+  }
+  if (pairs) {
+    const int high = HighestRank(pairs);
+    const uint32_t lower = pairs & ~(1 << high);
+    if (lower) {
+      const int low = HighestRank(lower);
+      const uint32_t kickers = ranks & ~(1 << high) & ~(1 << low);
+      return Rank(kTwoPair, (high + 1) << 16 | (low + 1) << 12 |
+                                TopRanks(tables, kickers, 1) >> 8);
+    }
+    return Rank(kPair, (high + 1) << 16 |
+                           TopRanks(tables, ranks & ~(1 << high), 3) >> 4);
+  }
+  return Rank(kHighCard, TopRanks(tables, ranks, 5));
+}
+
+}  // namespace
+
+int RankHand(uint64_t cards) { return RankHand(GetTables(), cards); }
+
+void RankHands(absl::Span<const uint64_t> hands, absl::Span<int> ranks) {
+  SPIEL_CHECK_EQ(hands.size(), ranks.size());
+  const Tables& tables = GetTables();
+  for (int i = 0; i < hands.size(); ++i) {
+    ranks[i] = RankHand(tables, hands[i]);
+  }
+}
+
+}  // namespace open_spiel::universal_poker::logic
@@ -0,0 +1,49 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_HAND_EVALUATOR_H
+#define OPEN_SPIEL_HAND_EVALUATOR_H
+
+#include <cstdint>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+
+// A table-driven poker hand evaluator. It ranks any set of cards in the
+// CardSet layout (13 bits per suit, up to 4 suits) using a handful of
+// bit operations on the per-suit masks and lookups into tables indexed by
+// 13-bit rank masks. The tables are built once per process.
+//
+// Hands are ordered as by ACPC's rankCardset: straight flush, four of a kind,
+// full house, flush, straight (the ace also plays low), three of a kind, two
+// pair, one pair and high card, ties broken by the usual kickers. The rank
+// values themselves differ from ACPC's, so they are only meaningful when
+// compared to each other.
+
+// Returns the rank of the hand; a higher rank is a better hand.
+int RankHand(uint64_t cards);
+inline int RankHand(const CardSet& cards) { return RankHand(cards.cs.cards); }
+
+// Ranks many hands at once: ranks[i] = RankHand(hands[i]).
+void RankHands(absl::Span<const uint64_t> hands, absl::Span<int> ranks);
+
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_HAND_EVALUATOR_H
@@ -0,0 +1,106 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/universal_poker/logic/hand_evaluator.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+namespace {
+
+void HandsAreOrderedByCategoryAndKickers() {
+  // From best to worst, with ties listed next to each other.
+  const std::vector<std::vector<std::string>> ordered_hands = {
+      {"AhKhQhJhTh2c3d"},
+      {"6s5s4s3s2sAsAd"},
+      {"5h4h3h2hAh"},
+      {"AsAhAdAcKh"},
+      {"AsAhAdAc2h3d4c"},
+      {"KsKhKdKcAh"},
+      {"AsAhAdKcKh", "AsAhAdKcKhKd2c", "AsAhAdKcKhQdQc"},
+      {"KsKhKdAcAh"},
+      {"Ah9h7h5h3h2h", "Ah9h7h5h3h"},
+      {"Ah9h7h5h2h"},
+      {"AhKdQcJsTh"},
+      {"6h5d4c3s2h"},
+      {"5d4c3s2hAh"},
+      {"AsAhAd5c3h"},
+      {"2s2h2dAcKh"},
+      {"AsAhKdKcQh", "AsAhKdKcQhQs2d"},
+      {"AsAhKdKcJh"},
+      {"AsAhQdQcKh"},
+      {"AsAhKdQcJh"},
+      {"AsAh", "AdAc"},
+      {"KsKh"},
+      {"AhKdQcJs9h"},
+      {"AhKdQcJs8h"},
+      {"AhKd"},
+      {"Ah"},
+      {"Kh"},
+  };
+  int previous = -1;
+  for (int i = ordered_hands.size() - 1; i >= 0; --i) {
+    const int rank = RankHand(CardSet(ordered_hands[i][0]));
+    SPIEL_CHECK_GT(rank, previous);
+    for (const std::string& tie : ordered_hands[i]) {
+      SPIEL_CHECK_EQ(RankHand(CardSet(tie)), rank);
+    }
+    previous = rank;
+  }
+}
+
+// The evaluator must order hands exactly as the ACPC evaluator does, since
+// universal_poker uses either to settle showdowns.
+void OrderMatchesAcpc() {
+  std::mt19937 rng(0);
+  CardSet deck(/*num_suits=*/4, /*num_ranks=*/13);
+  std::vector<uint8_t> cards = deck.ToCardArray();
+  for (int num_cards = 1; num_cards <= 7; ++num_cards) {
+    std::vector<uint64_t> hands;
+    std::vector<int> acpc_ranks;
+    for (int i = 0; i < 2000; ++i) {
+      std::shuffle(cards.begin(), cards.end(), rng);
+      CardSet hand;
+      for (int c = 0; c < num_cards; ++c) hand.AddCard(cards[c]);
+      hands.push_back(hand.cs.cards);
+      acpc_ranks.push_back(hand.RankCards());
+    }
+    std::vector<int> ranks(hands.size());
+    RankHands(hands, absl::MakeSpan(ranks));
+    for (int i = 1; i < hands.size(); ++i) {
+      SPIEL_CHECK_EQ(ranks[i] < ranks[i - 1],
+                     acpc_ranks[i] < acpc_ranks[i - 1]);
+      SPIEL_CHECK_EQ(ranks[i] == ranks[i - 1],
+                     acpc_ranks[i] == acpc_ranks[i - 1]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+int main(int argc, char **argv) {
+  open_spiel::universal_poker::logic::HandsAreOrderedByCategoryAndKickers();
+  open_spiel::universal_poker::logic::OrderMatchesAcpc();
+}
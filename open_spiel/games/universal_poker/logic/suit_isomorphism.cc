@@ -0,0 +1,85 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/games/universal_poker/logic/suit_isomorphism.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+
+namespace open_spiel::universal_poker::logic {
+namespace {
+
+// Whether suit `a` has the same ranks as suit `b` in every group.
+bool SameRanksInAllGroups(absl::Span<const CardSet> groups, int a, int b) {
+  for (const CardSet& group : groups) {
+    if (group.cs.bySuit[a] != group.cs.bySuit[b]) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+SuitPermutation CanonicalSuitPermutation(absl::Span<const CardSet> groups) {
+  // Suits are ordered by their ranks in the first group, then in the second
+  // group and so on, with the most cards (as a bit mask) first. Suits which
+  // compare equal have the same ranks everywhere, so how ties are broken does
+  // not change the image.
+  std::array<int, kMaxSuits> order;
+  for (int s = 0; s < kMaxSuits; ++s) order[s] = s;
+  std::stable_sort(order.begin(), order.end(), [groups](int a, int b) {
+    for (const CardSet& group : groups) {
+      if (group.cs.bySuit[a] != group.cs.bySuit[b]) {
+        return group.cs.bySuit[a] > group.cs.bySuit[b];
+      }
+    }
+    return false;
+  });
+  SuitPermutation permutation;
+  for (int i = 0; i < kMaxSuits; ++i) permutation[order[i]] = i;
+  return permutation;
+}
+
+CardSet PermuteSuits(const CardSet& cards, const SuitPermutation& permutation) {
+  CardSet result;
+  for (int s = 0; s < kMaxSuits; ++s) {
+    result.cs.bySuit[permutation[s]] = cards.cs.bySuit[s];
+  }
+  return result;
+}
+
+void CanonicalizeSuits(absl::Span<CardSet> groups) {
+  const SuitPermutation permutation = CanonicalSuitPermutation(groups);
+  for (CardSet& group : groups) group = PermuteSuits(group, permutation);
+}
+
+SuitPermutation InterchangeableSuits(absl::Span<const CardSet> groups) {
+  SuitPermutation lowest;
+  for (int s = 0; s < kMaxSuits; ++s) {
+    lowest[s] = s;
+    for (int t = 0; t < s; ++t) {
+      if (SameRanksInAllGroups(groups, s, t)) {
+        lowest[s] = t;
+        break;
+      }
+    }
+  }
+  return lowest;
+}
+
+}  // namespace open_spiel::universal_poker::logic
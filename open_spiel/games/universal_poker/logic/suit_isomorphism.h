@@ -0,0 +1,70 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef OPEN_SPIEL_SUIT_ISOMORPHISM_H
+#define OPEN_SPIEL_SUIT_ISOMORPHISM_H
+
+#include <array>
+#include <cstdint>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+
+// Poker hands do not depend on the names of the suits: relabelling the suits
+// of every card of a deal changes neither the hand ranks nor what a player
+// can tell apart. These helpers map deals to a canonical relabelling.
+//
+// A deal is given as a sequence of groups (e.g. the hole cards, then the
+// board), each group being a set of cards whose order does not matter. Two
+// sequences are isomorphic if a single suit permutation maps each group onto
+// the group at the same position in the other sequence.
+
+// A suit permutation: card suit s becomes suit permutation[s].
+using SuitPermutation = std::array<uint8_t, kMaxSuits>;
+
+// Returns a permutation mapping `groups` to the canonical member of its
+// isomorphism class: isomorphic sequences of groups have equal images. The
+// suits used by the groups are mapped to the lowest suits, so the image of a
+// deal from an n-suit deck only uses the first n suits.
+SuitPermutation CanonicalSuitPermutation(absl::Span<const CardSet> groups);
+
+// Relabels the suits of `cards`.
+CardSet PermuteSuits(const CardSet& cards, const SuitPermutation& permutation);
+
+// Replaces `groups` with their canonical image.
+void CanonicalizeSuits(absl::Span<CardSet> groups);
+
+// Returns, for each suit, the lowest suit which can be swapped with it while
+// leaving every group unchanged, i.e. the lowest suit with the same ranks in
+// every group. Dealing cards which only differ by such a swap leads to
+// isomorphic deals.
+SuitPermutation InterchangeableSuits(absl::Span<const CardSet> groups);
+
+// Returns the card with the same rank as `card` and the lowest suit that is
+// interchangeable with its suit.
+inline uint8_t RepresentativeCard(uint8_t card,
+                                  const SuitPermutation& interchangeable) {
+  return card - card % kMaxSuits + interchangeable[card % kMaxSuits];
+}
+
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_SUIT_ISOMORPHISM_H
@@ -0,0 +1,154 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/games/universal_poker/logic/suit_isomorphism.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+namespace {
+
+constexpr int kNumSuits = 4;
+constexpr int kNumRanks = 3;
+constexpr int kNumCards = kNumSuits * kNumRanks;
+
+std::vector<CardSet> Canonical(std::vector<CardSet> groups) {
+  CanonicalizeSuits(absl::MakeSpan(groups));
+  return groups;
+}
+
+bool Equal(const std::vector<CardSet>& a, const std::vector<CardSet>& b) {
+  if (a.size() != b.size()) return false;
+  for (int i = 0; i < a.size(); ++i) {
+    if (a[i].cs.cards != b[i].cs.cards) return false;
+  }
+  return true;
+}
+
+bool Isomorphic(const std::vector<CardSet>& a, const std::vector<CardSet>& b) {
+  return Equal(Canonical(a), Canonical(b));
+}
+
+std::vector<SuitPermutation> AllPermutations() {
+  std::vector<SuitPermutation> permutations;
+  SuitPermutation permutation = {0, 1, 2, 3};
+  do {
+    permutations.push_back(permutation);
+  } while (std::next_permutation(permutation.begin(), permutation.end()));
+  return permutations;
+}
+
+// Every deal of two hole cards and one board card from a small deck.
+std::vector<std::vector<CardSet>> AllSmallDeals() {
+  std::vector<std::vector<CardSet>> deals;
+  for (int a = 0; a < kNumCards; ++a) {
+    for (int b = a + 1; b < kNumCards; ++b) {
+      for (int c = 0; c < kNumCards; ++c) {
+        if (c == a || c == b) continue;
+        deals.push_back({CardSet(std::vector<int>{a, b}),
+                         CardSet(std::vector<int>{c})});
+      }
+    }
+  }
+  return deals;
+}
+
+void IsomorphicDealsHaveTheSameImage() {
+  SPIEL_CHECK_TRUE(Isomorphic({CardSet("AhKh"), CardSet("2h3c4d")},
+                              {CardSet("AsKs"), CardSet("2s3d4c")}));
+  SPIEL_CHECK_TRUE(Isomorphic({CardSet("AhKd"), CardSet("2h")},
+                              {CardSet("AdKh"), CardSet("2d")}));
+  SPIEL_CHECK_FALSE(Isomorphic({CardSet("AhKh"), CardSet("2c")},
+                               {CardSet("AhKs"), CardSet("2c")}));
+  // The board pairs a hole card's suit in one deal and not the other.
+  SPIEL_CHECK_FALSE(Isomorphic({CardSet("AhKd"), CardSet("2h")},
+                               {CardSet("AhKd"), CardSet("2c")}));
+  // The split between groups matters, not only the union.
+  SPIEL_CHECK_FALSE(Isomorphic({CardSet("AhKh"), CardSet("2c")},
+                               {CardSet("Ah"), CardSet("Kh2c")}));
+}
+
+void CanonicalImageIsInvariantAndInTheOrbit() {
+  const std::vector<SuitPermutation> permutations = AllPermutations();
+  for (const std::vector<CardSet>& deal : AllSmallDeals()) {
+    const std::vector<CardSet> canonical = Canonical(deal);
+    bool in_orbit = false;
+    for (const SuitPermutation& permutation : permutations) {
+      std::vector<CardSet> image;
+      for (const CardSet& group : deal) {
+        image.push_back(PermuteSuits(group, permutation));
+      }
+      SPIEL_CHECK_TRUE(Equal(Canonical(image), canonical));
+      in_orbit = in_orbit || Equal(image, canonical);
+    }
+    SPIEL_CHECK_TRUE(in_orbit);
+  }
+}
+
+void CanonicalImageUsesTheLowestSuits() {
+  const std::vector<CardSet> canonical =
+      Canonical({CardSet("Ks"), CardSet("Qh")});
+  SPIEL_CHECK_EQ(canonical[0].ToString(), "Kc");
+  SPIEL_CHECK_EQ(canonical[1].ToString(), "Qd");
+}
+
+// Dealing a card and dealing its representative lead to isomorphic deals, and
+// distinct representatives lead to distinct deals.
+void RepresentativesEnumerateNextDeals() {
+  for (const std::vector<CardSet>& deal : AllSmallDeals()) {
+    const SuitPermutation interchangeable = InterchangeableSuits(deal);
+    CardSet dealt;
+    for (const CardSet& group : deal) dealt.cs.cards |= group.cs.cards;
+    std::set<uint8_t> representatives;
+    std::vector<std::vector<CardSet>> next_deals;
+    for (int card = 0; card < kNumCards; ++card) {
+      if (dealt.ContainsCards(card)) continue;
+      const uint8_t representative = RepresentativeCard(card, interchangeable);
+      SPIEL_CHECK_LE(representative, card);
+      SPIEL_CHECK_FALSE(dealt.ContainsCards(representative));
+      std::vector<CardSet> next = deal;
+      next.back().AddCard(card);
+      std::vector<CardSet> next_representative = deal;
+      next_representative.back().AddCard(representative);
+      SPIEL_CHECK_TRUE(Isomorphic(next, next_representative));
+      if (representatives.insert(representative).second) {
+        for (const std::vector<CardSet>& other : next_deals) {
+          SPIEL_CHECK_FALSE(Isomorphic(other, next_representative));
+        }
+        next_deals.push_back(next_representative);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+int main(int argc, char **argv) {
+  open_spiel::universal_poker::logic::IsomorphicDealsHaveTheSameImage();
+  open_spiel::universal_poker::logic::CanonicalImageIsInvariantAndInTheOrbit();
+  open_spiel::universal_poker::logic::CanonicalImageUsesTheLowestSuits();
+  open_spiel::universal_poker::logic::RepresentativesEnumerateNextDeals();
+}
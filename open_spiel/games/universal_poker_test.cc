@@ -15,10 +15,17 @@
 #include "open_spiel/games/universal_poker.h"
 
 #include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/public_tree_cfr.h"
 #include "open_spiel/game_parameters.h"
+#include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -188,6 +195,7 @@ void BasicUniversalPokerTests() {
   testing::LoadGameTest("universal_poker");
   testing::ChanceOutcomesTest(*LoadGame("universal_poker"));
   testing::RandomSimTest(*LoadGame("universal_poker"), 100);
+  testing::InformationStateFingerprintTest(*LoadGame("universal_poker"), 100);
 
   // testing::RandomSimBenchmark("leduc_poker", 10000, false);
   // testing::RandomSimBenchmark("universal_poker", 10000, false);
@@ -195,6 +203,234 @@ void BasicUniversalPokerTests() {
   testing::CheckChanceOutcomes(*LoadGame("universal_poker"));
 }
 
+// Returns the expected returns when every player picks uniformly at random,
+// collecting the information states on the way.
+std::vector<double> UniformPolicyReturns(
+    const State &state, std::unordered_set<std::string> *infostates) {
+  if (state.IsTerminal()) return state.Returns();
+  std::vector<std::pair<Action, double>> outcomes;
+  if (state.IsChanceNode()) {
+    outcomes = state.ChanceOutcomes();
+  } else {
+    infostates->insert(state.InformationStateString());
+    for (Action action : state.LegalActions()) {
+      outcomes.push_back({action, 1.0 / state.LegalActions().size()});
+    }
+  }
+  std::vector<double> returns(state.NumPlayers(), 0.0);
+  for (const auto &[action, prob] : outcomes) {
+    std::vector<double> child_returns =
+        UniformPolicyReturns(*state.Child(action), infostates);
+    for (int p = 0; p < returns.size(); ++p) {
+      returns[p] += prob * child_returns[p];
+    }
+  }
+  return returns;
+}
+
+void SuitIsomorphismTests() {
+  const std::string params =
+      "betting=limit,numPlayers=2,numRounds=2,blind=1 1,raiseSize=1 1,"
+      "firstPlayer=1 1,maxRaises=1 1,numSuits=4,numRanks=3,numHoleCards=1,"
+      "numBoardCards=0 1";
+  std::shared_ptr<const Game> game =
+      LoadGame(absl::StrCat("universal_poker(", params, ")"));
+  std::shared_ptr<const Game> iso_game = LoadGame(
+      absl::StrCat("universal_poker(", params, ",suitIsomorphism=True)"));
+  testing::ChanceOutcomesTest(*iso_game);
+  testing::RandomSimTest(*iso_game, 100);
+  testing::InformationStateFingerprintTest(*iso_game, 100);
+  testing::CheckChanceOutcomes(*iso_game);
+
+  // The first card is only dealt once per rank.
+  std::unique_ptr<State> state = iso_game->NewInitialState();
+  std::vector<std::pair<Action, double>> outcomes = state->ChanceOutcomes();
+  SPIEL_CHECK_EQ(outcomes.size(), 3);
+  for (const auto &[card, prob] : outcomes) {
+    SPIEL_CHECK_FLOAT_EQ(prob, 1.0 / 3);
+  }
+
+  // Suit-equivalent hands share their information state.
+  std::unique_ptr<State> hearts = game->NewInitialState();
+  std::unique_ptr<State> spades = game->NewInitialState();
+  for (const char *card : {"4h", "3d"}) {
+    hearts->ApplyAction(logic::CardSet(card).ToCardArray()[0]);
+  }
+  for (const char *card : {"4s", "3c"}) {
+    spades->ApplyAction(logic::CardSet(card).ToCardArray()[0]);
+  }
+  SPIEL_CHECK_NE(hearts->InformationStateString(0),
+                 spades->InformationStateString(0));
+  std::unique_ptr<State> iso_hearts = iso_game->NewInitialState();
+  std::unique_ptr<State> iso_spades = iso_game->NewInitialState();
+  for (Action action : hearts->History()) iso_hearts->ApplyAction(action);
+  for (Action action : spades->History()) iso_spades->ApplyAction(action);
+  SPIEL_CHECK_EQ(iso_hearts->InformationStateString(0),
+                 iso_spades->InformationStateString(0));
+  SPIEL_CHECK_EQ(iso_hearts->InformationStateFingerprint(0),
+                 iso_spades->InformationStateFingerprint(0));
+  // So do the observations, and the whole deal is shown canonically.
+  SPIEL_CHECK_EQ(iso_hearts->ObservationString(0),
+                 iso_spades->ObservationString(0));
+  SPIEL_CHECK_EQ(iso_hearts->ObservationTensor(0),
+                 iso_spades->ObservationTensor(0));
+  SPIEL_CHECK_EQ(iso_hearts->ToString(), iso_spades->ToString());
+
+  // The isomorphism is lossless: the values do not change, with fewer
+  // information states.
+  std::unordered_set<std::string> infostates;
+  std::unordered_set<std::string> iso_infostates;
+  std::vector<double> returns =
+      UniformPolicyReturns(*game->NewInitialState(), &infostates);
+  std::vector<double> iso_returns =
+      UniformPolicyReturns(*iso_game->NewInitialState(), &iso_infostates);
+  for (int p = 0; p < returns.size(); ++p) {
+    SPIEL_CHECK_FLOAT_NEAR(returns[p], iso_returns[p], 1e-9);
+  }
+  SPIEL_CHECK_LT(iso_infostates.size(), infostates.size());
+
+  // It can be combined with a gamedef.
+  LoadGame("universal_poker",
+           {{"gamedef", GameParameter(std::string(kKuhnLimit3P))},
+            {"suitIsomorphism", GameParameter(true)}});
+}
+
+void CardAbstractionTests() {
+  const std::string params =
+      "betting=limit,numPlayers=2,numRounds=2,blind=1 1,raiseSize=1 1,"
+      "firstPlayer=1 1,maxRaises=1 1,numSuits=2,numRanks=6,numHoleCards=1,"
+      "numBoardCards=0 1";
+  std::shared_ptr<const Game> game =
+      LoadGame(absl::StrCat("universal_poker(", params, ")"));
+  std::shared_ptr<const Game> abstract_game = LoadGame(
+      absl::StrCat("universal_poker(", params, ",cardBuckets=3 4)"));
+  testing::RandomSimTest(*abstract_game, 100);
+  testing::InformationStateFingerprintTest(*abstract_game, 100);
+  SPIEL_CHECK_EQ(abstract_game->InformationStateTensorShape()[0],
+                 2 + 3 + 4 + 2 * abstract_game->MaxGameLength());
+
+  // The six ranks make three preflop buckets: 2, 3-5 and 6-7.
+  std::unique_ptr<State> trey = abstract_game->NewInitialState();
+  std::unique_ptr<State> four = abstract_game->NewInitialState();
+  for (const char *card : {"3c", "7d"}) {
+    trey->ApplyAction(logic::CardSet(card).ToCardArray()[0]);
+  }
+  for (const char *card : {"4d", "7d"}) {
+    four->ApplyAction(logic::CardSet(card).ToCardArray()[0]);
+  }
+  SPIEL_CHECK_EQ(trey->InformationStateString(0),
+                 four->InformationStateString(0));
+  SPIEL_CHECK_EQ(trey->InformationStateFingerprint(0),
+                 four->InformationStateFingerprint(0));
+  SPIEL_CHECK_NE(trey->InformationStateString(0),
+                 trey->InformationStateString(1));
+
+  std::unordered_set<std::string> infostates;
+  std::unordered_set<std::string> abstract_infostates;
+  UniformPolicyReturns(*game->NewInitialState(), &infostates);
+  UniformPolicyReturns(*abstract_game->NewInitialState(),
+                       &abstract_infostates);
+  SPIEL_CHECK_LT(abstract_infostates.size(), infostates.size());
+
+  // It can be combined with a gamedef.
+  LoadGame("universal_poker",
+           {{"gamedef", GameParameter(std::string(kKuhnLimit3P))},
+            {"cardBuckets", GameParameter(std::string("2"))}});
+}
+
+void BetSizeAbstractionTests() {
+  SPIEL_CHECK_FLOAT_EQ(PseudoHarmonicMapping(0.5, 1, 0.5), 1.0);
+  SPIEL_CHECK_FLOAT_EQ(PseudoHarmonicMapping(0.5, 1, 1), 0.0);
+  SPIEL_CHECK_FLOAT_NEAR(PseudoHarmonicMapping(0.5, 1, 0.75), 3.0 / 7, 1e-9);
+
+  const std::string params =
+      "betting=nolimit,numPlayers=2,numRounds=2,blind=100 50,"
+      "firstPlayer=2 1,numSuits=2,numRanks=4,numHoleCards=1,"
+      "numBoardCards=0 1,stack=2000 2000,bettingAbstraction=fcba";
+  std::shared_ptr<const Game> game = LoadGame(
+      absl::StrCat("universal_poker(", params, ",betSizes=0.5 1 2)"));
+  SPIEL_CHECK_EQ(game->NumDistinctActions(), 6);
+  testing::RandomSimTest(*game, 100);
+  testing::InformationStateFingerprintTest(*game, 100);
+
+  // The small blind faces a pot of 200 after calling, so the bets raise to
+  // 200, 300 and 500 chips.
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (state->IsChanceNode()) state->ApplyAction(state->LegalActions()[0]);
+  SPIEL_CHECK_EQ(state->LegalActions(),
+                 std::vector<Action>({kFold, kCall, kBet, kBet + 1, kBet + 2,
+                                      kBet + 3}));
+  auto *poker_state = static_cast<UniversalPokerState *>(state.get());
+  // 400 chips is a bet of 1.5 pots, between the bets of 1 and 2 pots.
+  const double p = PseudoHarmonicMapping(1, 2, 1.5);
+  const std::vector<std::pair<Action, double>> translated =
+      poker_state->TranslateRaise(400);
+  SPIEL_CHECK_EQ(translated.size(), 2);
+  SPIEL_CHECK_EQ(translated[0].first, kBet + 1);
+  SPIEL_CHECK_FLOAT_EQ(translated[0].second, p);
+  SPIEL_CHECK_EQ(translated[1].first, kBet + 2);
+  SPIEL_CHECK_FLOAT_EQ(translated[1].second, 1 - p);
+  SPIEL_CHECK_TRUE(poker_state->TranslateRaise(300) ==
+                   (std::vector<std::pair<Action, double>>{{kBet + 1, 1.0}}));
+  SPIEL_CHECK_TRUE(poker_state->TranslateRaise(150) ==
+                   (std::vector<std::pair<Action, double>>{{kBet, 1.0}}));
+  SPIEL_CHECK_TRUE(poker_state->TranslateRaise(5000) ==
+                   (std::vector<std::pair<Action, double>>{{kBet + 3, 1.0}}));
+
+  std::unique_ptr<State> half_pot = state->Child(kBet);
+  std::unique_ptr<State> pot = state->Child(kBet + 1);
+  SPIEL_CHECK_NE(half_pot->InformationStateString(0),
+                 pot->InformationStateString(0));
+  SPIEL_CHECK_NE(half_pot->InformationStateFingerprint(0),
+                 pot->InformationStateFingerprint(0));
+
+  // Bets below the minimum raise are raised to it, and only offered once.
+  game = LoadGame(
+      absl::StrCat("universal_poker(", params, ",betSizes=0.1 0.2 1)"));
+  state = game->NewInitialState();
+  while (state->IsChanceNode()) state->ApplyAction(state->LegalActions()[0]);
+  SPIEL_CHECK_EQ(state->LegalActions(),
+                 std::vector<Action>({kFold, kCall, kBet, kBet + 2, kBet + 3}));
+
+  // Each round can have its own bets.
+  game = LoadGame(
+      absl::StrCat("universal_poker(", params, ",betSizes=0.5|1 2)"));
+  SPIEL_CHECK_EQ(game->NumDistinctActions(), 5);
+  testing::RandomSimTest(*game, 100);
+}
+
+// The public tree solver makes the same updates as CFR, with and without
+// card removal between two-card hands.
+void PublicTreeCFRTests() {
+  for (const char *hands : {"numSuits=4,numRanks=3,numHoleCards=1",
+                            "numSuits=2,numRanks=3,numHoleCards=2"}) {
+    std::shared_ptr<const Game> game = LoadGame(absl::StrCat(
+        "universal_poker(betting=limit,numPlayers=2,numRounds=2,blind=1 1,"
+        "raiseSize=1 1,firstPlayer=1 1,maxRaises=1 1,numBoardCards=0 1,",
+        hands, ")"));
+    algorithms::CFRPlusSolver solver(*game);
+    algorithms::PublicTreeCFRPlusSolver public_solver(*game);
+    for (int i = 0; i < 10; ++i) {
+      solver.EvaluateAndUpdatePolicy();
+      public_solver.EvaluateAndUpdatePolicy();
+    }
+    const std::unique_ptr<Policy> policy = solver.AveragePolicy();
+    const TabularPolicy public_policy = public_solver.AveragePolicy();
+    std::unordered_set<std::string> infostates;
+    UniformPolicyReturns(*game->NewInitialState(), &infostates);
+    SPIEL_CHECK_EQ(public_policy.PolicyTable().size(), infostates.size());
+    for (const auto &[infostate, actions_and_probs] :
+         public_policy.PolicyTable()) {
+      const ActionsAndProbs expected = policy->GetStatePolicy(infostate);
+      SPIEL_CHECK_EQ(actions_and_probs.size(), expected.size());
+      for (int i = 0; i < expected.size(); ++i) {
+        SPIEL_CHECK_FLOAT_NEAR(actions_and_probs[i].second, expected[i].second,
+                               1e-9);
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace universal_poker
 }  // namespace open_spiel
@@ -211,4 +447,8 @@ int main(int argc, char **argv) {
 
   open_spiel::universal_poker::BasicUniversalPokerTests();
   open_spiel::universal_poker::HUNLRegressionTests();
+  open_spiel::universal_poker::SuitIsomorphismTests();
+  open_spiel::universal_poker::CardAbstractionTests();
+  open_spiel::universal_poker::BetSizeAbstractionTests();
+  open_spiel::universal_poker::PublicTreeCFRTests();
 }
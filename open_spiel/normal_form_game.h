@@ -62,12 +62,12 @@ class NFGState : public SimMoveState {
   }
 
   void InformationStateTensor(Player player,
-                              std::vector<double>* values) const override {
-    values->resize(1);
+                              absl::Span<float> values) const override {
+    SPIEL_CHECK_EQ(values.size(), 1);
     if (IsTerminal()) {
-      (*values)[0] = 1;
+      values[0] = 1;
     } else {
-      (*values)[0] = 0;
+      values[0] = 0;
     }
   }
 };
@@ -22,22 +22,20 @@ import logging
 from absl import app
 from absl import flags
 import numpy as np
-from scipy.spatial import distance_matrix
 import networkx as nx
 import pyspiel
 
 
-def params(num_nodes):
-  distances = np.random.random( (num_nodes, 2) )
-  dist_mat = np.round( distance_matrix(distances, distances), 2 ).flatten()
-  generated_weights = str(dist_mat[0])
-  for i in range(1,dist_mat.size):
-    generated_weights+="," + str(dist_mat[i])
-    env_configs = {
-       "num_nodes": num_nodes,
-       "weights": generated_weights
-       }
-  return env_configs   
+def params(num_nodes, seed=None):
+  """Random Euclidean instance; the weights are generated natively."""
+  if seed is None:
+    seed = np.random.randint(2**31 - 1)
+  env_configs = {
+      "num_nodes": num_nodes,
+      "generator": "euclidean",
+      "seed": int(seed)
+      }
+  return env_configs
 
 def spiel_params(num_nodes):
     args = params(num_nodes)
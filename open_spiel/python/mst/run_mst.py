@@ -21,15 +21,13 @@ from __future__ import print_function
 import random
 from absl import app
 from absl import flags
-import numpy as np
-from scipy.spatial import distance_matrix
-
 import pyspiel
 
 FLAGS = flags.FLAGS
 
 flags.DEFINE_string("game", "mst", "Name of the game")
 flags.DEFINE_integer("num_nodes", None, "Number of nodes")
+flags.DEFINE_integer("seed", 42, "Seed of the random instance")
 flags.DEFINE_string("load_state", None,
                     "A file containing a string to load a specific state")
 
@@ -39,16 +37,11 @@ def main(_):
 
   print("Creating game: " + FLAGS.game)
   if FLAGS.num_nodes is not None:
-
-    distances = np.random.random((FLAGS.num_nodes,2))
-    dist_mat = np.round(distance_matrix(distances, distances),2).flatten()
-    generated_weights = str(dist_mat[0])
-    for i in range(1,dist_mat.size):
-      generated_weights+="," + str(dist_mat[i])
-
+    # Random Euclidean instance, generated natively from the seed.
     game = pyspiel.load_game(FLAGS.game,
                              {"num_nodes": pyspiel.GameParameter(FLAGS.num_nodes),
-                              "weights": pyspiel.GameParameter(generated_weights)})
+                              "generator": pyspiel.GameParameter("euclidean"),
+                              "seed": pyspiel.GameParameter(FLAGS.seed)})
   else:
     game = pyspiel.load_game(FLAGS.game, {"num_nodes": pyspiel.GameParameter(5),
                                           "weights": pyspiel.GameParameter("0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0")})
@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "open_spiel/algorithms/best_response.h"
 #include "open_spiel/algorithms/cfr.h"
@@ -25,8 +28,10 @@
 #include "open_spiel/algorithms/tabular_exploitability.h"
 #include "open_spiel/algorithms/tensor_game_utils.h"
 #include "open_spiel/algorithms/trajectories.h"
+#include "open_spiel/algorithms/vector_environment.h"
 #include "open_spiel/game_transforms/normal_form_extensive_game.h"
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
+#include "open_spiel/games/mst.h"
 #include "open_spiel/matrix_game.h"
 #include "open_spiel/normal_form_game.h"
 #include "open_spiel/policy.h"
@@ -45,6 +50,7 @@ namespace {
 
 using ::open_spiel::algorithms::Evaluator;
 using ::open_spiel::algorithms::Exploitability;
+using ::open_spiel::algorithms::FlatTrajectoryBatch;
 using ::open_spiel::algorithms::NashConv;
 using ::open_spiel::algorithms::TabularBestResponse;
 using ::open_spiel::matrix_game::MatrixGame;
@@ -165,6 +171,122 @@ class PyBot : public Bot {
   }
 };
 
+// Bindings of long-running native code release the GIL while it runs, so that
+// other Python threads can make progress, e.g. several actors each searching
+// with their own bot. The objects they use are not synchronized: a solver,
+// bot, evaluator, recorder or environment must only be used by one thread at
+// a time, while games may be shared. Calls back into Python, such as the
+// methods of a Bot implemented in Python, take the GIL again as needed.
+using ReleaseGil = py::call_guard<py::gil_scoped_release>;
+
+// Contiguous numpy buffers that state tensors are written into in place.
+template <typename T>
+using TensorBuffer = py::array_t<T, py::array::c_style>;
+
+enum class TensorKind { kObservation, kInformationState };
+
+// Writes the tensor of `state` for `player` into `out`, which must hold
+// exactly as many elements as the tensor.
+template <typename T>
+void WriteTensor(const State& state, Player player, TensorKind kind, T* out,
+                 int size) {
+  if (kind == TensorKind::kObservation) {
+    state.ObservationTensor(player, absl::Span<T>(out, size));
+  } else {
+    state.InformationStateTensor(player, absl::Span<T>(out, size));
+  }
+}
+
+// Fills row b of the [B, ...] buffer `out` with the tensor of states[b]. The
+// player defaults to the player to move in each state.
+template <typename T>
+void WriteTensorBatch(const std::vector<const State*>& states,
+                      TensorBuffer<T> out, Player player, TensorKind kind) {
+  SPIEL_CHECK_GE(out.ndim(), 1);
+  SPIEL_CHECK_EQ(out.shape(0), states.size());
+  if (states.empty()) return;
+  int row_size = out.size() / states.size();
+  T* data = out.mutable_data();
+  for (int b = 0; b < states.size(); ++b) {
+    Player p = player == kInvalidPlayer ? states[b]->CurrentPlayer() : player;
+    WriteTensor(*states[b], p, kind, data + b * row_size, row_size);
+  }
+}
+
+// Binds the numpy writers for one element type. Buffers are not converted:
+// they must already have dtype T and be C-contiguous, otherwise the values
+// would be written into a temporary copy.
+template <typename T>
+void DefineTensorWriters(py::module& m, py::class_<State>& state) {
+  state
+      .def(
+          "write_observation_tensor",
+          [](const State& state, Player player, TensorBuffer<T> out) {
+            WriteTensor(state, player, TensorKind::kObservation,
+                        out.mutable_data(), out.size());
+          },
+          py::arg("player"), py::arg("out").noconvert())
+      .def(
+          "write_information_state_tensor",
+          [](const State& state, Player player, TensorBuffer<T> out) {
+            WriteTensor(state, player, TensorKind::kInformationState,
+                        out.mutable_data(), out.size());
+          },
+          py::arg("player"), py::arg("out").noconvert());
+  m.def(
+      "write_observation_tensor_batch",
+      [](const std::vector<const State*>& states, TensorBuffer<T> out,
+         Player player) {
+        WriteTensorBatch(states, out, player, TensorKind::kObservation);
+      },
+      py::arg("states"), py::arg("out").noconvert(),
+      py::arg("player") = kInvalidPlayer,
+      "Writes the observation tensor of each state into a row of `out`.");
+  m.def(
+      "write_information_state_tensor_batch",
+      [](const std::vector<const State*>& states, TensorBuffer<T> out,
+         Player player) {
+        WriteTensorBatch(states, out, player, TensorKind::kInformationState);
+      },
+      py::arg("states"), py::arg("out").noconvert(),
+      py::arg("player") = kInvalidPlayer,
+      "Writes the information state tensor of each state into a row of `out`.");
+}
+
+// The numpy views of a FlatTrajectoryBatch point into its buffers and share an
+// owner, kept on the batch. When the batch is recorded into again while views
+// are alive, the owner takes its buffers over, so that the views stay valid,
+// and the batch is recorded into new ones.
+constexpr char kFlatBatchOwner[] = "_buffer_owner";
+
+py::object FlatBatchOwner(py::object batch) {
+  if (!py::hasattr(batch, kFlatBatchOwner)) {
+    batch.attr(kFlatBatchOwner) =
+        py::capsule(new FlatTrajectoryBatch(), [](void* buffers) {
+          delete static_cast<FlatTrajectoryBatch*>(buffers);
+        });
+  }
+  return batch.attr(kFlatBatchOwner);
+}
+
+template <typename T>
+py::array_t<T> FlatBatchView(py::object batch, const std::vector<T>& buffer,
+                             std::vector<py::ssize_t> shape) {
+  return py::array_t<T>(shape, buffer.data(),
+                        py::make_tuple(batch, FlatBatchOwner(batch)));
+}
+
+// Hands the buffers of `batch` over to its owner if any view uses them.
+void DetachFlatBatchViews(py::object batch) {
+  if (!py::hasattr(batch, kFlatBatchOwner)) return;
+  auto owner = batch.attr(kFlatBatchOwner).cast<py::capsule>();
+  // One reference is held by the batch and one by `owner`, the others by views.
+  if (owner.ref_count() <= 2) return;
+  FlatTrajectoryBatch* buffers = owner;
+  std::swap(*buffers, batch.cast<FlatTrajectoryBatch&>());
+  py::delattr(batch, kFlatBatchOwner);
+}
+
 // Definintion of our Python module.
 PYBIND11_MODULE(pyspiel, m) {
   m.doc() = "Open Spiel";
@@ -273,6 +395,13 @@ PYBIND11_MODULE(pyspiel, m) {
            (std::vector<int>(State::*)(int) const) & State::LegalActionsMask)
       .def("legal_actions_mask",
            (std::vector<int>(State::*)(void) const) & State::LegalActionsMask)
+      .def(
+          "write_legal_actions_mask",
+          [](const State& state, Player player, TensorBuffer<uint8_t> out) {
+            state.LegalActionsMask(
+                player, absl::Span<uint8_t>(out.mutable_data(), out.size()));
+          },
+          py::arg("player"), py::arg("out").noconvert())
       .def("action_to_string", (std::string(State::*)(Player, Action) const) &
                                    State::ActionToString)
       .def("action_to_string",
@@ -330,6 +459,9 @@ PYBIND11_MODULE(pyspiel, m) {
             return std::move(game_and_state.second);
           }));
 
+  DefineTensorWriters<float>(m, state);
+  DefineTensorWriters<double>(m, state);
+
   py::class_<Game, std::shared_ptr<Game>> game(m, "Game");
   game.def("num_distinct_actions", &Game::NumDistinctActions)
       .def("new_initial_state", &Game::NewInitialState)
@@ -451,7 +583,7 @@ PYBIND11_MODULE(pyspiel, m) {
 
   py::class_<Bot, PyBot> bot(m, "Bot");
   bot.def(py::init<>())
-      .def("step", &Bot::Step)
+      .def("step", &Bot::Step, ReleaseGil())
       .def("restart", &Bot::Restart)
       .def("restart_at", &Bot::RestartAt)
       .def("provides_force_action", &Bot::ProvidesForceAction)
@@ -459,7 +591,7 @@ PYBIND11_MODULE(pyspiel, m) {
       .def("inform_action", &Bot::InformAction)
       .def("provides_policy", &Bot::ProvidesPolicy)
       .def("get_policy", &Bot::GetPolicy)
-      .def("step_with_policy", &Bot::StepWithPolicy);
+      .def("step_with_policy", &Bot::StepWithPolicy, ReleaseGil());
 
   py::class_<algorithms::Evaluator> mcts_evaluator(m, "Evaluator");
   py::class_<algorithms::RandomRolloutEvaluator, algorithms::Evaluator>(
@@ -480,19 +612,19 @@ PYBIND11_MODULE(pyspiel, m) {
           py::arg("verbose"),
           py::arg("child_selection_policy") =
               algorithms::ChildSelectionPolicy::UCT)
-      .def("step", &algorithms::MCTSBot::Step)
-      .def("mcts_search", &algorithms::MCTSBot::MCTSearch);
+      .def("step", &algorithms::MCTSBot::Step, ReleaseGil())
+      .def("mcts_search", &algorithms::MCTSBot::MCTSearch, ReleaseGil());
 
   py::class_<TabularBestResponse>(m, "TabularBestResponse")
       .def(py::init<const open_spiel::Game&, int,
                     const std::unordered_map<std::string,
                                              open_spiel::ActionsAndProbs>&>())
       .def(py::init<const open_spiel::Game&, int, const open_spiel::Policy*>())
-      .def("value", &TabularBestResponse::Value)
+      .def("value", &TabularBestResponse::Value, ReleaseGil())
       .def("get_best_response_policy",
-           &TabularBestResponse::GetBestResponsePolicy)
+           &TabularBestResponse::GetBestResponsePolicy, ReleaseGil())
       .def("get_best_response_actions",
-           &TabularBestResponse::GetBestResponseActions)
+           &TabularBestResponse::GetBestResponseActions, ReleaseGil())
       .def("set_policy", py::overload_cast<const std::unordered_map<
                              std::string, open_spiel::ActionsAndProbs>&>(
                              &TabularBestResponse::SetPolicy))
@@ -525,14 +657,16 @@ PYBIND11_MODULE(pyspiel, m) {
   py::class_<open_spiel::algorithms::CFRSolver>(m, "CFRSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRSolver::EvaluateAndUpdatePolicy,
+           ReleaseGil())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy", &open_spiel::algorithms::CFRSolver::AveragePolicy);
 
   py::class_<open_spiel::algorithms::CFRPlusSolver>(m, "CFRPlusSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy,
+           ReleaseGil())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy",
            &open_spiel::algorithms::CFRPlusSolver::AveragePolicy);
@@ -540,7 +674,8 @@ PYBIND11_MODULE(pyspiel, m) {
   py::class_<open_spiel::algorithms::CFRBRSolver>(m, "CFRBRSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy,
+           ReleaseGil())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy",
            &open_spiel::algorithms::CFRPlusSolver::AveragePolicy);
@@ -550,7 +685,152 @@ PYBIND11_MODULE(pyspiel, m) {
       .def(py::init<const Game&, const std::unordered_map<std::string, int>&,
                     int>())
       .def("record_batch",
-           &open_spiel::algorithms::TrajectoryRecorder::RecordBatch);
+           &open_spiel::algorithms::TrajectoryRecorder::RecordBatch,
+           ReleaseGil());
+
+  // The buffer accessors return numpy views without copying. A view keeps the
+  // contents it was fetched with: recording into the batch again overwrites
+  // its buffers only when no view of them is alive.
+  py::class_<FlatTrajectoryBatch>(m, "FlatTrajectoryBatch", py::dynamic_attr())
+      .def(py::init<>())
+      .def_readonly("batch_size", &FlatTrajectoryBatch::batch_size)
+      .def_readonly("max_length", &FlatTrajectoryBatch::max_length)
+      .def_property_readonly(
+          "observations",
+          [](py::object self) {
+            const auto& b = self.cast<const FlatTrajectoryBatch&>();
+            return FlatBatchView(self, b.observations,
+                                 {b.batch_size, b.max_length, b.tensor_size});
+          })
+      .def_property_readonly(
+          "legal_mask",
+          [](py::object self) {
+            const auto& b = self.cast<const FlatTrajectoryBatch&>();
+            return FlatBatchView(self, b.legal_mask,
+                                 {b.batch_size, b.max_length, b.num_actions});
+          })
+      .def_property_readonly(
+          "policies",
+          [](py::object self) {
+            const auto& b = self.cast<const FlatTrajectoryBatch&>();
+            return FlatBatchView(self, b.policies,
+                                 {b.batch_size, b.max_length, b.num_actions});
+          })
+      .def_property_readonly(
+          "actions",
+          [](py::object self) {
+            const auto& b = self.cast<const FlatTrajectoryBatch&>();
+            return FlatBatchView(self, b.actions, {b.batch_size, b.max_length});
+          })
+      .def_property_readonly(
+          "player_ids",
+          [](py::object self) {
+            const auto& b = self.cast<const FlatTrajectoryBatch&>();
+            return FlatBatchView(self, b.player_ids,
+                                 {b.batch_size, b.max_length});
+          })
+      .def_property_readonly(
+          "valid",
+          [](py::object self) {
+            const auto& b = self.cast<const FlatTrajectoryBatch&>();
+            return FlatBatchView(self, b.valid, {b.batch_size, b.max_length});
+          })
+      .def_property_readonly(
+          "next_is_terminal",
+          [](py::object self) {
+            const auto& b = self.cast<const FlatTrajectoryBatch&>();
+            return FlatBatchView(self, b.next_is_terminal,
+                                 {b.batch_size, b.max_length});
+          })
+      .def_property_readonly(
+          "rewards",
+          [](py::object self) {
+            const auto& b = self.cast<const FlatTrajectoryBatch&>();
+            return FlatBatchView(self, b.rewards,
+                                 {b.batch_size, b.num_players});
+          })
+      .def_property_readonly("lengths", [](py::object self) {
+        const auto& b = self.cast<const FlatTrajectoryBatch&>();
+        return FlatBatchView(self, b.lengths, {b.batch_size});
+      });
+
+  using open_spiel::algorithms::FlatTrajectoryRecorder;
+  py::class_<FlatTrajectoryRecorder>(m, "FlatTrajectoryRecorder")
+      .def(py::init<std::shared_ptr<const Game>, int, int, bool, int>(),
+           py::arg("game"), py::arg("seed") = 0, py::arg("num_threads") = 1,
+           py::arg("use_observation") = false, py::arg("max_length") = -1)
+      .def(
+          "record_batch",
+          [](FlatTrajectoryRecorder& recorder,
+             const std::vector<const Policy*>& policies, int batch_size,
+             py::object batch) {
+            DetachFlatBatchViews(batch);
+            auto* buffers = batch.cast<FlatTrajectoryBatch*>();
+            py::gil_scoped_release release;
+            recorder.RecordBatch(policies, batch_size, buffers);
+          },
+          py::arg("policies"), py::arg("batch_size"), py::arg("batch"))
+      .def("record_batch",
+           py::overload_cast<const std::vector<const Policy*>&, int>(
+               &FlatTrajectoryRecorder::RecordBatch),
+           py::arg("policies"), py::arg("batch_size"), ReleaseGil());
+
+  // The buffer accessors return numpy views that keep the environment alive
+  // and are updated in place by reset() and step().
+  py::class_<open_spiel::algorithms::VectorEnvironment>(m, "VectorEnvironment")
+      .def(py::init<std::shared_ptr<const Game>, int, int, bool>(),
+           py::arg("game"), py::arg("num_envs"), py::arg("seed") = 0,
+           py::arg("use_observation") = false)
+      .def("reset", &open_spiel::algorithms::VectorEnvironment::Reset,
+           ReleaseGil())
+      .def("step",
+           [](open_spiel::algorithms::VectorEnvironment& env,
+              py::array_t<Action, py::array::c_style | py::array::forcecast>
+                  actions) {
+             SPIEL_CHECK_EQ(actions.size(), env.NumEnvs());
+             const Action* data = actions.data();
+             py::gil_scoped_release release;
+             env.Step(data);
+           })
+      .def("num_envs", &open_spiel::algorithms::VectorEnvironment::NumEnvs)
+      .def("tensor_size",
+           &open_spiel::algorithms::VectorEnvironment::TensorSize)
+      .def("num_episodes",
+           &open_spiel::algorithms::VectorEnvironment::NumEpisodes)
+      .def("observations",
+           [](py::object self) {
+             const auto& env =
+                 self.cast<const open_spiel::algorithms::VectorEnvironment&>();
+             return py::array_t<float>({env.NumEnvs(), env.TensorSize()},
+                                       env.Observations().data(), self);
+           })
+      .def("legal_mask",
+           [](py::object self) {
+             const auto& env =
+                 self.cast<const open_spiel::algorithms::VectorEnvironment&>();
+             return py::array_t<uint8_t>(
+                 {env.NumEnvs(), env.NumDistinctActions()},
+                 env.LegalMask().data(), self);
+           })
+      .def("current_players",
+           [](py::object self) {
+             const auto& env =
+                 self.cast<const open_spiel::algorithms::VectorEnvironment&>();
+             return py::array_t<int>({env.NumEnvs()},
+                                     env.CurrentPlayers().data(), self);
+           })
+      .def("rewards",
+           [](py::object self) {
+             const auto& env =
+                 self.cast<const open_spiel::algorithms::VectorEnvironment&>();
+             return py::array_t<double>({env.NumEnvs(), env.NumPlayers()},
+                                        env.Rewards().data(), self);
+           })
+      .def("dones", [](py::object self) {
+        const auto& env =
+            self.cast<const open_spiel::algorithms::VectorEnvironment&>();
+        return py::array_t<int>({env.NumEnvs()}, env.Dones().data(), self);
+      });
 
   m.def("create_matrix_game",
         py::overload_cast<const std::string&, const std::string&,
@@ -649,7 +929,7 @@ PYBIND11_MODULE(pyspiel, m) {
         "Returns the details of all available games.");
 
   m.def("evaluate_bots", open_spiel::EvaluateBots, py::arg("state"),
-        py::arg("bots"), py::arg("seed"),
+        py::arg("bots"), py::arg("seed"), ReleaseGil(),
         "Plays a single game with the given bots and returns the final "
         "utilities.");
 
@@ -666,8 +946,24 @@ PYBIND11_MODULE(pyspiel, m) {
         "A general implementation of deserialization of a game and state "
         "string serialized by serialize_game_and_state.");
 
+  m.def(
+      "serialize_states_binary",
+      [](const std::vector<const State*>& states) {
+        return py::bytes(open_spiel::SerializeStatesBinary(states));
+      },
+      "Serializes states of the same game into one compact binary buffer.");
+
+  m.def(
+      "deserialize_states_binary",
+      [](const Game& game, const py::bytes& data) {
+        return open_spiel::DeserializeStatesBinary(game,
+                                                   std::string(data));
+      },
+      "Reads the states from a buffer written by serialize_states_binary.");
+
   m.def("exploitability",
         py::overload_cast<const Game&, const Policy&>(&Exploitability),
+        ReleaseGil(),
         "Returns the sum of the utility that a best responder wins when when "
         "playing against 1) the player 0 policy contained in `policy` and 2) "
         "the player 1 policy contained in `policy`."
@@ -680,6 +976,7 @@ PYBIND11_MODULE(pyspiel, m) {
       py::overload_cast<
           const Game&, const std::unordered_map<std::string, ActionsAndProbs>&>(
           &Exploitability),
+      ReleaseGil(),
       "Returns the sum of the utility that a best responder wins when when "
       "playing against 1) the player 0 policy contained in `policy` and 2) "
       "the player 1 policy contained in `policy`."
@@ -687,7 +984,10 @@ PYBIND11_MODULE(pyspiel, m) {
       "games, and raises a SpielFatalError if an incompatible game is passed "
       "to it.");
 
-  m.def("nash_conv", py::overload_cast<const Game&, const Policy&>(&NashConv),
+  m.def("nash_conv",
+        py::overload_cast<const Game&, const Policy&, bool>(&NashConv),
+        py::arg("game"), py::arg("policy"),
+        py::arg("use_state_get_policy") = false, ReleaseGil(),
         "Returns the sum of the utility that a best responder wins when when "
         "playing against 1) the player 0 policy contained in `policy` and 2) "
         "the player 1 policy contained in `policy`."
@@ -700,6 +1000,7 @@ PYBIND11_MODULE(pyspiel, m) {
       py::overload_cast<
           const Game&, const std::unordered_map<std::string, ActionsAndProbs>&>(
           &NashConv),
+      ReleaseGil(),
       "Calculates a measure of how far the given policy is from a Nash "
       "equilibrium by returning the sum of the improvements in the value "
       "that each player could obtain by unilaterally changing their strategy "
@@ -712,6 +1013,7 @@ PYBIND11_MODULE(pyspiel, m) {
   m.def("expected_returns",
         py::overload_cast<const State&, const std::vector<const Policy*>&, int,
                           bool>(&open_spiel::algorithms::ExpectedReturns),
+        ReleaseGil(),
         "Computes the undiscounted expected returns from a depth-limited "
         "search.");
 
@@ -749,11 +1051,31 @@ PYBIND11_MODULE(pyspiel, m) {
             const Game&, const std::vector<open_spiel::TabularPolicy>&,
             const std::unordered_map<std::string, int>&, int, bool, int, int>(
             &open_spiel::algorithms::RecordBatchedTrajectory),
+        ReleaseGil(),
         "Records a batch of trajectories.");
 
   // Game-Specific Query API.
   m.def("negotiation_item_pool", &open_spiel::query::NegotiationItemPool);
   m.def("negotiation_agent_utils", &open_spiel::query::NegotiationAgentUtils);
+  m.def("mst_optimal_cost", &open_spiel::query::MstOptimalCost,
+        "Cost of the exact minimum spanning tree of an MST game.");
+  m.def("mst_optimal_edges", &open_spiel::query::MstOptimalEdges,
+        "Actions forming the exact minimum spanning tree of an MST game.");
+  m.def("mst_remaining_optimal_cost",
+        &open_spiel::query::MstRemainingOptimalCost,
+        "Cheapest cost of completing the spanning tree from an MST state.");
+  m.def(
+      "load_mst_game",
+      [](py::array_t<float, py::array::c_style | py::array::forcecast> weights,
+         const GameParameters& params) {
+        return open_spiel::mst::LoadGameWithWeights(
+            std::vector<float>(weights.data(),
+                               weights.data() + weights.size()),
+            params);
+      },
+      py::arg("weights"), py::arg("params") = GameParameters(),
+      "Creates an MST game from a square weight matrix without going through "
+      "the string weights parameter.");
 
   // Set an error handler that will raise exceptions. These exceptions are for
   // the Python interface only. When used from C++, OpenSpiel will never raise
@@ -19,7 +19,10 @@ from __future__ import division
 from __future__ import print_function
 
 import os
+import threading
+
 from absl.testing import absltest
+import numpy as np
 import six
 
 from open_spiel.python import policy
@@ -219,6 +222,121 @@ class PyspielTest(absltest.TestCase):
                                           batch_size, include_full_observations,
                                           seed, -1)
 
+  def test_write_tensors_into_numpy(self):
+    game = pyspiel.load_game("leduc_poker")
+    state = game.new_initial_state()
+    while state.is_chance_node():
+      state.apply_action(state.legal_actions()[0])
+    for dtype in [np.float32, np.float64]:
+      out = np.zeros(game.information_state_tensor_shape(), dtype=dtype)
+      state.write_information_state_tensor(0, out)
+      np.testing.assert_array_equal(out, state.information_state_tensor(0))
+      out = np.zeros(game.observation_tensor_shape(), dtype=dtype)
+      state.write_observation_tensor(1, out)
+      np.testing.assert_array_equal(out, state.observation_tensor(1))
+
+    states = [state, state.child(state.legal_actions()[0])]
+    out = np.zeros([2] + game.information_state_tensor_shape(), np.float32)
+    pyspiel.write_information_state_tensor_batch(states, out)
+    for row, batch_state in zip(out, states):
+      np.testing.assert_array_equal(row, batch_state.information_state_tensor())
+
+    # Buffers of the wrong dtype would only receive a converted copy.
+    with self.assertRaises(TypeError):
+      state.write_observation_tensor(0, np.zeros(
+          game.observation_tensor_shape(), dtype=np.int32))
+
+  def test_write_legal_actions_mask(self):
+    game = pyspiel.load_game("tic_tac_toe")
+    state = game.new_initial_state()
+    state.apply_action(4)
+    mask = np.zeros(game.num_distinct_actions(), dtype=np.uint8)
+    state.write_legal_actions_mask(1, mask)
+    np.testing.assert_array_equal(mask, state.legal_actions_mask(1))
+    state.write_legal_actions_mask(0, mask)
+    self.assertEqual(mask.sum(), 0)
+
+  def test_serialize_states_binary(self):
+    game = pyspiel.load_game("tic_tac_toe")
+    state = game.new_initial_state()
+    states = [state.clone()]
+    for action in [4, 0, 8]:
+      state.apply_action(action)
+      states.append(state.clone())
+    data = pyspiel.serialize_states_binary(states)
+    self.assertIsInstance(data, bytes)
+    restored = pyspiel.deserialize_states_binary(game, data)
+    self.assertEqual([s.history() for s in restored],
+                     [s.history() for s in states])
+
+  def test_flat_trajectory_recorder(self):
+    game = pyspiel.load_game("kuhn_poker")
+    uniform = pyspiel.UniformRandomPolicy(game)
+    recorder = pyspiel.FlatTrajectoryRecorder(game, seed=1, num_threads=2)
+    batch = pyspiel.FlatTrajectoryBatch()
+    recorder.record_batch([uniform, uniform], 8, batch)
+    self.assertEqual(batch.observations.shape,
+                     (8, game.max_game_length(),
+                      game.information_state_tensor_size()))
+    np.testing.assert_array_equal(batch.valid.sum(axis=1), batch.lengths)
+    np.testing.assert_array_equal(batch.next_is_terminal.sum(axis=1), 1)
+    np.testing.assert_allclose(batch.rewards.sum(axis=1), 0)
+
+  def test_flat_trajectory_views_outlive_rerecording(self):
+    game = pyspiel.load_game("kuhn_poker")
+    uniform = pyspiel.UniformRandomPolicy(game)
+    recorder = pyspiel.FlatTrajectoryRecorder(game, seed=1)
+    batch = pyspiel.FlatTrajectoryBatch()
+    recorder.record_batch([uniform, uniform], 4, batch)
+    observations = batch.observations
+    expected = observations.copy()
+    # A batch of another shape is written to new buffers, while the view
+    # keeps the ones it was taken from.
+    recorder.record_batch([uniform, uniform], 64, batch)
+    self.assertEqual(batch.observations.shape[0], 64)
+    np.testing.assert_array_equal(observations, expected)
+
+  def test_native_algorithms_run_in_threads(self):
+    # The games come from the LoadGame cache, and are shared by all the
+    # threads, which run the calls that release the GIL at the same time.
+    kuhn = pyspiel.load_game("kuhn_poker")
+    tic_tac_toe = pyspiel.load_game("tic_tac_toe")
+    soccer = pyspiel.load_game("markov_soccer")
+    num_threads = 4
+    barrier = threading.Barrier(num_threads)
+
+    def run(results, index, wait):
+      if wait:
+        barrier.wait()
+      solver = pyspiel.CFRSolver(kuhn)
+      for _ in range(20):
+        solver.evaluate_and_update_policy()
+      nash_conv = pyspiel.nash_conv(kuhn, solver.average_policy())
+      evaluator = pyspiel.RandomRolloutEvaluator(1, index)
+      bot = pyspiel.MCTSBot(tic_tac_toe, evaluator, 2, 100, 10, False, index,
+                            False)
+      action = bot.step(tic_tac_toe.new_initial_state())
+      bots = [pyspiel.make_uniform_random_bot(p, index) for p in range(2)]
+      returns = [
+          pyspiel.evaluate_bots(soccer.new_initial_state(), bots, seed)
+          for seed in range(10)
+      ]
+      results[index] = (nash_conv, action, returns)
+
+    results = [None] * num_threads
+    threads = [
+        threading.Thread(target=run, args=(results, i, True))
+        for i in range(num_threads)
+    ]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+    expected = [None] * num_threads
+    for i in range(num_threads):
+      run(expected, i, False)
+    self.assertEqual(results, expected)
+
 
 if __name__ == "__main__":
   absltest.main()
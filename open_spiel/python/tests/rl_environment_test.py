@@ -19,6 +19,7 @@ from __future__ import division
 from __future__ import print_function
 
 from absl.testing import absltest
+import numpy as np
 
 from open_spiel.python import rl_environment
 import pyspiel
@@ -140,6 +141,24 @@ class RLEnvironmentTest(absltest.TestCase):
     with self.assertRaises(AssertionError):
       self.fail(env_kuhn2.set_state(env_kuhn1.get_state))
 
+  def test_vector_environment(self):
+    game = pyspiel.load_game("tic_tac_toe")
+    env = pyspiel.VectorEnvironment(game, num_envs=4, use_observation=True)
+    observations = env.observations()
+    self.assertEqual(observations.shape, (4, 27))
+    self.assertEqual(env.legal_mask().shape, (4, 9))
+
+    # Same game as test_full_game in every environment.
+    for i in range(7):
+      self.assertTrue((env.current_players() == i % 2).all())
+      env.step(np.full(4, i))
+    self.assertTrue((env.dones() == 1).all())
+    self.assertTrue((env.rewards()[:, 0] == 1).all())
+    # The episodes restarted, and the views were updated in place.
+    self.assertTrue((env.legal_mask() == 1).all())
+    self.assertEqual(observations[:, :9].sum(), 4 * 9)
+    self.assertEqual(env.num_episodes(), 4)
+
 
 if __name__ == "__main__":
   absltest.main()
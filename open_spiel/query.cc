@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "open_spiel/games/mst.h"
 #include "open_spiel/games/negotiation.h"
 #include "open_spiel/spiel.h"
 
@@ -33,5 +34,24 @@ std::vector<int> NegotiationAgentUtils(const State& state, int player) {
   return nstate->AgentUtils()[player];
 }
 
+// MST
+double MstOptimalCost(const Game& game) {
+  const auto* mgame = dynamic_cast<const mst::MstGame*>(&game);
+  SPIEL_CHECK_TRUE(mgame != nullptr);
+  return mgame->OptimalCost();
+}
+
+std::vector<Action> MstOptimalEdges(const Game& game) {
+  const auto* mgame = dynamic_cast<const mst::MstGame*>(&game);
+  SPIEL_CHECK_TRUE(mgame != nullptr);
+  return mgame->OptimalEdges();
+}
+
+double MstRemainingOptimalCost(const State& state) {
+  const auto* mstate = dynamic_cast<const mst::MstState*>(&state);
+  SPIEL_CHECK_TRUE(mstate != nullptr);
+  return mstate->RemainingOptimalCost();
+}
+
 }  // namespace query
 }  // namespace open_spiel
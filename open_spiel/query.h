@@ -26,6 +26,11 @@ namespace query {
 std::vector<int> NegotiationItemPool(const State& state);
 std::vector<int> NegotiationAgentUtils(const State& state, int player);
 
+// MST
+double MstOptimalCost(const Game& game);
+std::vector<Action> MstOptimalEdges(const Game& game);
+double MstRemainingOptimalCost(const State& state);
+
 }  // namespace query
 }  // namespace open_spiel
 
@@ -14,18 +14,27 @@
 
 #include "open_spiel/spiel.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <ostream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/fingerprint.h"
+#include "open_spiel/utils/varint.h"
 
 namespace open_spiel {
 namespace {
@@ -35,6 +44,106 @@ constexpr const char* kSerializeMetaSectionHeader = "[Meta]";
 constexpr const char* kSerializeGameSectionHeader = "[Game]";
 constexpr const char* kSerializeStateSectionHeader = "[State]";
 
+// The double precision tensors are computed in single precision into this
+// buffer, then copied out, so the legacy overloads do not allocate per call.
+std::vector<float>& TensorScratch(int size) {
+  thread_local std::vector<float> scratch;
+  scratch.resize(size);
+  return scratch;
+}
+
+// First byte of each state written by State::SerializeBinary.
+constexpr char kBinaryHistoryTag = 'H';
+constexpr char kBinarySnapshotTag = 'S';
+constexpr char kBinaryTextTag = 'T';
+
+// Appends an exact encoding of `params` to `key`. Unlike
+// GameParametersToString, it distinguishes types and does not round doubles,
+// so two parameter sets have the same key only if they are equal.
+void AppendGameParametersKey(const GameParameters& params, std::string* key) {
+  absl::StrAppend(key, "(");
+  for (const auto& [name, value] : params) {
+    absl::StrAppend(key, name.size(), ":", name, "=");
+    switch (value.type()) {
+      case GameParameter::Type::kInt:
+        absl::StrAppend(key, "i", value.int_value());
+        break;
+      case GameParameter::Type::kDouble:
+        absl::StrAppend(key, absl::StrFormat("d%a", value.double_value()));
+        break;
+      case GameParameter::Type::kString:
+        absl::StrAppend(key, "s", value.string_value().size(), ":",
+                        value.string_value());
+        break;
+      case GameParameter::Type::kBool:
+        absl::StrAppend(key, "b", value.bool_value());
+        break;
+      case GameParameter::Type::kGame:
+        absl::StrAppend(key, "g");
+        AppendGameParametersKey(value.game_value(), key);
+        break;
+      default:
+        absl::StrAppend(key, "u");
+    }
+    absl::StrAppend(key, ";");
+  }
+  absl::StrAppend(key, ")");
+}
+
+// The games returned by LoadGame, keyed by AppendGameParametersKey of their
+// name and parameters. Only weak references are kept, so a game is freed once
+// nobody uses it; the expired entries are pruned when the map has doubled in
+// size since the last pruning. It is never destroyed, as games may still be
+// released during static destruction.
+struct GameCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::weak_ptr<const Game>> games;
+  int prune_size = 16;  // The size at which expired entries are pruned.
+};
+
+GameCache& GetGameCache() {
+  static GameCache* cache = new GameCache();
+  return *cache;
+}
+
+std::shared_ptr<const Game> CreateGameCached(const std::string& short_name,
+                                             const GameParameters& params) {
+  std::string key = short_name;
+  AppendGameParametersKey(params, &key);
+  GameCache& cache = GetGameCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.games.find(key);
+    if (it != cache.games.end()) {
+      if (std::shared_ptr<const Game> game = it->second.lock()) return game;
+    }
+  }
+
+  // The lock is not held here, since creating a game can load other games.
+  std::shared_ptr<const Game> game =
+      GameRegisterer::CreateByName(short_name, params);
+  if (game == nullptr) {
+    SpielFatalError(absl::StrCat("Unable to create game: ", short_name));
+  }
+  // Sampled stochastic games may keep random state in the game object, so
+  // every LoadGame must get its own instance.
+  if (game->GetType().chance_mode == GameType::ChanceMode::kSampledStochastic) {
+    return game;
+  }
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  std::weak_ptr<const Game>& entry = cache.games[key];
+  // If another thread created the same game meanwhile, use its instance.
+  if (std::shared_ptr<const Game> existing = entry.lock()) return existing;
+  entry = game;
+  if (cache.games.size() >= cache.prune_size) {
+    for (auto it = cache.games.begin(); it != cache.games.end();) {
+      it = it->second.expired() ? cache.games.erase(it) : std::next(it);
+    }
+    cache.prune_size = std::max<int>(16, 2 * cache.games.size());
+  }
+  return game;
+}
+
 // Returns the available parameter keys, to be used as a utility function.
 std::string ListValidParameters(
     const std::map<std::string, GameParameter>& param_spec) {
@@ -176,12 +285,7 @@ std::shared_ptr<const Game> LoadGame(const std::string& game_string) {
 
 std::shared_ptr<const Game> LoadGame(const std::string& short_name,
                                      const GameParameters& params) {
-  std::shared_ptr<const Game> result =
-      GameRegisterer::CreateByName(short_name, params);
-  if (result == nullptr) {
-    SpielFatalError(absl::StrCat("Unable to create game: ", short_name));
-  }
-  return result;
+  return CreateGameCached(short_name, params);
 }
 
 std::shared_ptr<const Game> LoadGame(GameParameters params) {
@@ -192,12 +296,7 @@ std::shared_ptr<const Game> LoadGame(GameParameters params) {
   }
   std::string name = it->second.string_value();
   params.erase(it);
-  std::shared_ptr<const Game> result =
-      GameRegisterer::CreateByName(name, params);
-  if (result == nullptr) {
-    SpielFatalError(absl::StrCat("Unable to create game: ", name));
-  }
-  return result;
+  return CreateGameCached(name, params);
 }
 
 State::State(std::shared_ptr<const Game> game)
@@ -205,6 +304,25 @@ State::State(std::shared_ptr<const Game> game)
       num_players_(game->NumPlayers()),
       game_(game) {}
 
+Game::Game(const Game& other)
+    : game_type_(other.game_type_), game_parameters_(other.game_parameters_) {
+  std::lock_guard<std::mutex> lock(other.defaulted_parameters_mutex_);
+  defaulted_parameters_ = other.defaulted_parameters_;
+}
+
+GameParameters Game::GetParameters() const {
+  GameParameters params = game_parameters_;
+  std::lock_guard<std::mutex> lock(defaulted_parameters_mutex_);
+  params.insert(defaulted_parameters_.begin(), defaulted_parameters_.end());
+  return params;
+}
+
+void Game::AddDefaultedParameter(const std::string& key,
+                                 const GameParameter& value) const {
+  std::lock_guard<std::mutex> lock(defaulted_parameters_mutex_);
+  defaulted_parameters_[key] = value;
+}
+
 template <>
 GameParameters Game::ParameterValue<GameParameters>(
     const std::string& key, std::optional<GameParameters> default_value) const {
@@ -242,7 +360,7 @@ int Game::ParameterValue<int>(const std::string& key,
       }
       default_game_parameter = default_iter->second;
     }
-    defaulted_parameters_[key] = default_game_parameter;
+    AddDefaultedParameter(key, default_game_parameter);
     return default_game_parameter.int_value();
   } else {
     return iter->second.int_value();
@@ -266,7 +384,7 @@ double Game::ParameterValue<double>(const std::string& key,
       }
       default_game_parameter = default_iter->second;
     }
-    defaulted_parameters_[key] = default_game_parameter;
+    AddDefaultedParameter(key, default_game_parameter);
     return default_game_parameter.double_value();
   } else {
     return iter->second.double_value();
@@ -290,7 +408,7 @@ std::string Game::ParameterValue<std::string>(
       }
       default_game_parameter = default_iter->second;
     }
-    defaulted_parameters_[key] = default_game_parameter;
+    AddDefaultedParameter(key, default_game_parameter);
     return default_game_parameter.string_value();
   } else {
     return iter->second.string_value();
@@ -314,7 +432,7 @@ bool Game::ParameterValue<bool>(const std::string& key,
       }
       default_game_parameter = default_iter->second;
     }
-    defaulted_parameters_[key] = default_game_parameter;
+    AddDefaultedParameter(key, default_game_parameter);
     return default_game_parameter.bool_value();
   } else {
     return iter->second.bool_value();
@@ -354,6 +472,47 @@ std::pair<Action, double> SampleAction(const ActionsAndProbs& outcomes,
       absl::StrCat("Internal error: failed to sample an outcome; z=", z));
 }
 
+void State::LegalActionsMask(Player player, absl::Span<uint8_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0);
+  for (Action action : LegalActions(player)) mask[action] = 1;
+}
+
+std::vector<int> State::LegalActionsMask(Player player) const {
+  std::vector<uint8_t> mask(num_distinct_actions_);
+  LegalActionsMask(player, absl::MakeSpan(mask));
+  return std::vector<int>(mask.begin(), mask.end());
+}
+
+absl::uint128 State::InformationStateFingerprint(Player player) const {
+  return Fingerprinter().Add(InformationStateString(player)).Fingerprint();
+}
+
+void State::InformationStateTensor(Player player,
+                                   absl::Span<double> values) const {
+  std::vector<float>& scratch = TensorScratch(values.size());
+  InformationStateTensor(player, absl::MakeSpan(scratch));
+  std::copy(scratch.begin(), scratch.end(), values.begin());
+}
+
+void State::InformationStateTensor(Player player,
+                                   std::vector<double>* values) const {
+  values->resize(game_->InformationStateTensorSize());
+  InformationStateTensor(player, absl::MakeSpan(*values));
+}
+
+void State::ObservationTensor(Player player, absl::Span<double> values) const {
+  std::vector<float>& scratch = TensorScratch(values.size());
+  ObservationTensor(player, absl::MakeSpan(scratch));
+  std::copy(scratch.begin(), scratch.end(), values.begin());
+}
+
+void State::ObservationTensor(Player player,
+                              std::vector<double>* values) const {
+  values->resize(game_->ObservationTensorSize());
+  ObservationTensor(player, absl::MakeSpan(*values));
+}
+
 std::string State::Serialize() const {
   // This simple serialization doesn't work for games with sampled chance
   // nodes, since the history doesn't give us enough information to reconstruct
@@ -364,6 +523,32 @@ std::string State::Serialize() const {
   return absl::StrCat(absl::StrJoin(History(), "\n"), "\n");
 }
 
+void State::SerializeBinary(std::string* out) const {
+  std::string snapshot;
+  if (SerializeSnapshot(&snapshot)) {
+    out->push_back(kBinarySnapshotTag);
+    AppendVarint(snapshot.size(), out);
+    out->append(snapshot);
+    return;
+  }
+  if (game_->GetType().chance_mode ==
+      GameType::ChanceMode::kSampledStochastic) {
+    // The history cannot be replayed, but the game may have its own text
+    // serialization, see Serialize(). It is read back as by
+    // DeserializeGameAndState, without the trailing newline.
+    std::string text = Serialize();
+    if (!text.empty() && text.back() == '\n') text.pop_back();
+    out->push_back(kBinaryTextTag);
+    AppendVarint(text.size(), out);
+    out->append(text);
+    return;
+  }
+  std::vector<Action> history = History();
+  out->push_back(kBinaryHistoryTag);
+  AppendVarint(history.size(), out);
+  for (Action action : history) AppendSignedVarint(action, out);
+}
+
 Action State::StringToAction(Player player,
                              const std::string& action_str) const {
   for (const Action action : LegalActions()) {
@@ -405,6 +590,48 @@ std::unique_ptr<State> Game::DeserializeState(const std::string& str) const {
   return state;
 }
 
+std::unique_ptr<State> Game::DeserializeStateBinary(
+    absl::string_view* data) const {
+  SPIEL_CHECK_FALSE(data->empty());
+  const char tag = data->front();
+  data->remove_prefix(1);
+  if (tag == kBinarySnapshotTag) {
+    uint64_t size = ReadVarint(data);
+    SPIEL_CHECK_LE(size, data->size());
+    std::unique_ptr<State> state = DeserializeSnapshot(data->substr(0, size));
+    data->remove_prefix(size);
+    return state;
+  }
+  if (tag == kBinaryTextTag) {
+    uint64_t size = ReadVarint(data);
+    SPIEL_CHECK_LE(size, data->size());
+    std::unique_ptr<State> state =
+        DeserializeState(std::string(data->substr(0, size)));
+    data->remove_prefix(size);
+    return state;
+  }
+  SPIEL_CHECK_EQ(tag, kBinaryHistoryTag);
+
+  std::unique_ptr<State> state = NewInitialState();
+  const uint64_t num_actions = ReadVarint(data);
+  std::vector<Action> joint_action;
+  for (uint64_t i = 0; i < num_actions; ++i) {
+    Action action = ReadSignedVarint(data);
+    if (state->IsSimultaneousNode()) {
+      // The history holds one action per player for simultaneous nodes.
+      joint_action.push_back(action);
+      if (joint_action.size() == state->NumPlayers()) {
+        state->ApplyActions(joint_action);
+        joint_action.clear();
+      }
+    } else {
+      state->ApplyAction(action);
+    }
+  }
+  SPIEL_CHECK_TRUE(joint_action.empty());
+  return state;
+}
+
 std::string SerializeGameAndState(const Game& game, const State& state) {
   std::string str = "";
 
@@ -476,6 +703,25 @@ DeserializeGameAndState(const std::string& serialized_state) {
       game, std::move(state));
 }
 
+std::string SerializeStatesBinary(const std::vector<const State*>& states) {
+  std::string data;
+  AppendVarint(states.size(), &data);
+  for (const State* state : states) state->SerializeBinary(&data);
+  return data;
+}
+
+std::vector<std::unique_ptr<State>> DeserializeStatesBinary(
+    const Game& game, absl::string_view data) {
+  const uint64_t num_states = ReadVarint(&data);
+  std::vector<std::unique_ptr<State>> states;
+  states.reserve(num_states);
+  for (uint64_t i = 0; i < num_states; ++i) {
+    states.push_back(game.DeserializeStateBinary(&data));
+  }
+  SPIEL_CHECK_TRUE(data.empty());
+  return states;
+}
+
 std::ostream& operator<<(std::ostream& stream, GameType::Dynamics value) {
   switch (value) {
     case GameType::Dynamics::kSimultaneous:
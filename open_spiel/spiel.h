@@ -15,17 +15,23 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_SPIEL_H_
 #define THIRD_PARTY_OPEN_SPIEL_SPIEL_H_
 
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <random>
 #include <sstream>
 #include <string>
+#include <typeinfo>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -164,6 +170,7 @@ class State {
   // See the documentation of the Game object for further details.
   State(std::shared_ptr<const Game> game);
   State(const State&) = default;
+  State& operator=(const State&) = default;
 
   // Returns current player. Player numbers start from 0.
   // Negative numbers are for chance (-1) or simultaneous (-2).
@@ -219,17 +226,17 @@ class State {
   // is added.
   virtual std::vector<Action> LegalActions() const = 0;
 
+  // Writes 1 for legal actions and 0 for illegal actions of `player` into
+  // `mask`, which must have `game.NumDistinctActions()` entries.
+  //
+  // The default implementation goes through LegalActions(player). Games that
+  // can read their legal moves straight off the board should override it, so
+  // that action masking does not build an action list on every step.
+  virtual void LegalActionsMask(Player player, absl::Span<uint8_t> mask) const;
+
   // Returns a vector of length `game.NumDistinctActions()` containing 1 for
   // legal actions and 0 for illegal actions.
-  std::vector<int> LegalActionsMask(Player player) const {
-    std::vector<int> mask(num_distinct_actions_, 0);
-    std::vector<Action> legal_actions = LegalActions(player);
-
-    for (auto const& value : legal_actions) {
-      mask[value] = 1;
-    }
-    return mask;
-  }
+  std::vector<int> LegalActionsMask(Player player) const;
 
   // Convenience function for turn-based games.
   std::vector<int> LegalActionsMask() const {
@@ -359,19 +366,37 @@ class State {
     return InformationStateString(CurrentPlayer());
   }
 
+  // A 128-bit fingerprint of InformationStateString(player): two states have
+  // the same fingerprint exactly when they have the same information state
+  // string, barring hash collisions. Tabular algorithms can key on it instead
+  // of the string.
+  //
+  // The default implementation hashes the string. Games whose information
+  // state string is expensive to build should override it to hash compact
+  // state data instead; the values need not match the default ones.
+  virtual absl::uint128 InformationStateFingerprint(Player player) const;
+  absl::uint128 InformationStateFingerprint() const {
+    return InformationStateFingerprint(CurrentPlayer());
+  }
+
   // Vector form, useful for neural-net function approximation approaches.
-  // The size of the vector must match Game::InformationStateShape()
-  // with values in lexicographic order. E.g. for 2x4x3, order would be:
-  // (0,0,0), (0,0,1), (0,0,2), (0,1,0), ... , (1,3,2).
-  // This function should resize the supplied vector if required.
+  // The values are written in lexicographic order into a buffer owned by the
+  // caller, whose size must match Game::InformationStateTensorSize(). E.g. for
+  // 2x4x3, order would be: (0,0,0), (0,0,1), (0,0,2), (0,1,0), ... , (1,3,2).
+  // Implementations must write every element, including the zeros.
 
   // There are currently no use-case for calling this function with
   // `kChancePlayerId` or `kTerminalPlayerId`. Thus, games are expected to raise
   // an error in those cases.
   virtual void InformationStateTensor(Player player,
-                                      std::vector<double>* values) const {
+                                      absl::Span<float> values) const {
     SpielFatalError("InformationStateTensor unimplemented!");
   }
+  // Double precision versions of the above. The tensor is computed in single
+  // precision and widened; the vector is resized as required.
+  void InformationStateTensor(Player player, absl::Span<double> values) const;
+  void InformationStateTensor(Player player,
+                              std::vector<double>* values) const;
   std::vector<double> InformationStateTensor(Player player) const {
     std::vector<double> normalized_info_state;
     InformationStateTensor(player, &normalized_info_state);
@@ -400,11 +425,15 @@ class State {
     return ObservationString(CurrentPlayer());
   }
 
-  // Returns the view of the game, preferably from `player`'s perspective.
+  // Returns the view of the game, preferably from `player`'s perspective. The
+  // buffer must have Game::ObservationTensorSize() elements, and conventions
+  // are the same as for InformationStateTensor.
   virtual void ObservationTensor(Player player,
-                                 std::vector<double>* values) const {
+                                 absl::Span<float> values) const {
     SpielFatalError("ObservationTensor unimplemented!");
   }
+  void ObservationTensor(Player player, absl::Span<double> values) const;
+  void ObservationTensor(Player player, std::vector<double>* values) const;
   std::vector<double> ObservationTensor(Player player) const {
     // We add this player check, to prevent errors if the game implementation
     // lacks that check (in particular as this function is the one used in
@@ -424,6 +453,14 @@ class State {
   // Return a copy of this state.
   virtual std::unique_ptr<State> Clone() const = 0;
 
+  // Overwrites `dst` with a copy of this state and returns true. `dst` is
+  // typically a state of the same game that is no longer needed, so unlike
+  // Clone this reuses its memory rather than allocating a new state; see
+  // algorithms/state_pool.h. Returns false, leaving `dst` unchanged, if the
+  // game does not support it or `dst` is not of the same type as this state.
+  // Games with copy-assignable states can implement it with CopyStateInto.
+  virtual bool CloneInto(State* dst) const { return false; }
+
   // Creates the child from State corresponding to action.
   std::unique_ptr<State> Child(Action action) const {
     std::unique_ptr<State> child = Clone();
@@ -506,6 +543,22 @@ class State {
   // If overridden, this must be the inverse of Game::DeserializeState.
   virtual std::string Serialize() const;
 
+  // Appends a compact binary encoding of the state to `out`, which can be
+  // read back with Game::DeserializeStateBinary. The state is written as a
+  // snapshot if the game provides one (see SerializeSnapshot), and otherwise
+  // as its history with each action varint-encoded, which is replayed on
+  // deserialization. Sampled stochastic games, whose history cannot be
+  // replayed, are written with Serialize instead. Use SerializeStatesBinary to
+  // write many states at once.
+  void SerializeBinary(std::string* out) const;
+
+  // Games can override this to append a direct binary snapshot of the state
+  // to `out` and return true. The snapshot must be readable by
+  // Game::DeserializeSnapshot without replaying the history, and the
+  // resulting state must have the same history as this one. Returns false if
+  // the game has no snapshot format, in which case the history is written.
+  virtual bool SerializeSnapshot(std::string* out) const { return false; }
+
   // Resamples a new history from the information state from player_id's view.
   // This resamples a private for the other players, but holds player_id's
   // privates constant, and the public information constant.
@@ -548,6 +601,15 @@ class State {
     SpielFatalError("DoApplyActions is not implemented.");
   }
 
+  // Implements CloneInto for a game state of type `DerivedState`, which must
+  // be copy-assignable.
+  template <typename DerivedState>
+  static bool CopyStateInto(const DerivedState& src, State* dst) {
+    if (typeid(*dst) != typeid(src)) return false;
+    *static_cast<DerivedState*>(dst) = src;
+    return true;
+  }
+
   // Fields common to every game state.
   int num_distinct_actions_;
   int num_players_;
@@ -564,6 +626,13 @@ class State {
 // unique_ptr, because shared pointers to the game object must be sent down to
 // the states that created them. So, they *must* be created via
 // shared_ptr<const Game> or via the LoadGame methods.
+//
+// Games are immutable once created, so the const methods of a Game may be
+// called from several threads at once. Implementations must keep it so: what
+// a const method updates, like the defaulted parameters recorded by
+// ParameterValue or the seed of the next state, must be synchronized. States
+// are not thread-safe: each thread must use its own states, e.g. clones of a
+// shared one.
 class Game : public std::enable_shared_from_this<Game> {
  public:
   virtual ~Game() = default;
@@ -588,11 +657,7 @@ class Game : public std::enable_shared_from_this<Game> {
 
   // If the game is parametrizable, returns an object with the current parameter
   // values, including defaulted values. Returns empty parameters otherwise.
-  GameParameters GetParameters() const {
-    GameParameters params = game_parameters_;
-    params.insert(defaulted_parameters_.begin(), defaulted_parameters_.end());
-    return params;
-  }
+  GameParameters GetParameters() const;
 
   // The number of players in this instantiation of the game.
   // Does not include the chance-player.
@@ -669,6 +734,17 @@ class Game : public std::enable_shared_from_this<Game> {
   // Game::SerializeState (i.e. it should also be overridden).
   virtual std::unique_ptr<State> DeserializeState(const std::string& str) const;
 
+  // Reads one state written by State::SerializeBinary from the front of
+  // `data` and advances `data` past it.
+  std::unique_ptr<State> DeserializeStateBinary(absl::string_view* data) const;
+
+  // Builds a state from a snapshot written by State::SerializeSnapshot. Must
+  // be overridden together with it.
+  virtual std::unique_ptr<State> DeserializeSnapshot(
+      absl::string_view snapshot) const {
+    SpielFatalError("DeserializeSnapshot unimplemented.");
+  }
+
   // Maximum length of any one game (in terms of number of decision nodes
   // visited in the game tree). For a simultaneous action game, this is the
   // maximum number of joint decisions. In a turn-based game, this is the
@@ -682,6 +758,9 @@ class Game : public std::enable_shared_from_this<Game> {
  protected:
   Game(GameType game_type, GameParameters game_parameters)
       : game_type_(game_type), game_parameters_(game_parameters) {}
+  // Copies the parameters, including those defaulted so far; for Clone.
+  Game(const Game& other);
+  Game& operator=(const Game&) = delete;
 
   // Access to game parameters. Returns the value provided by the user. If not:
   // - Defaults to the value stored as the default in
@@ -697,8 +776,16 @@ class Game : public std::enable_shared_from_this<Game> {
   // Any parameters supplied when constructing the game.
   GameParameters game_parameters_;
 
+
+ private:
+  // Records that the parameter `key` took the value `value` by default.
+  void AddDefaultedParameter(const std::string& key,
+                             const GameParameter& value) const;
+
   // Track the parameters for which a default value has been used. This
-  // enables us to report the actual value used for every parameter.
+  // enables us to report the actual value used for every parameter. Const
+  // methods may call ParameterValue concurrently, hence the mutex.
+  mutable std::mutex defaulted_parameters_mutex_;
   mutable GameParameters defaulted_parameters_;
 };
 
@@ -742,15 +829,25 @@ std::vector<std::string> RegisteredGames();
 // Returns a list of registered game types.
 std::vector<GameType> RegisteredGameTypes();
 
-// Returns a new game object from the specified string, which is the short
+// Returns a game object from the specified string, which is the short
 // name plus optional parameters, e.g. "go(komi=4.5,board_size=19)"
+//
+// Games are immutable, so the LoadGame functions share the games they create:
+// while a game is in use, loading it again with the same parameters returns
+// the same instance, without repeating any expensive setup. The cache does
+// not keep games alive, so a game is freed when its last user releases it.
+// The cache is thread-safe. Parameters are compared as given, so
+// "go" and "go(komi=7.5)" are cached separately even though they are the
+// same game. Sampled stochastic games are not cached, since they may keep
+// random state in the game object; use Game::Clone for a private copy of
+// other games.
 std::shared_ptr<const Game> LoadGame(const std::string& game_string);
 
-// Returns a new game object with the specified parameters.
+// Returns a game object with the specified parameters.
 std::shared_ptr<const Game> LoadGame(const std::string& short_name,
                                      const GameParameters& params);
 
-// Returns a new game object with the specified parameters; reads the name
+// Returns a game object with the specified parameters; reads the name
 // of the game from the 'name' parameter (which is not passed to the game
 // implementation).
 std::shared_ptr<const Game> LoadGame(GameParameters params);
@@ -799,6 +896,16 @@ std::string SerializeGameAndState(const Game& game, const State& state);
 std::pair<std::shared_ptr<const Game>, std::unique_ptr<State>>
 DeserializeGameAndState(const std::string& serialized_state);
 
+// Writes many states of the same game into one binary buffer: the number of
+// states as a varint, followed by each state as written by
+// State::SerializeBinary. Unlike SerializeGameAndState there is no header;
+// the reader must know the game.
+std::string SerializeStatesBinary(const std::vector<const State*>& states);
+
+// Reads all the states from a buffer written by SerializeStatesBinary.
+std::vector<std::unique_ptr<State>> DeserializeStatesBinary(
+    const Game& game, absl::string_view data);
+
 // We alias this here as we can't import state_distribution.h or we'd have a
 // circular dependency.
 using HistoryDistribution =
@@ -21,12 +21,15 @@
 #include <random>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/abseil-cpp/absl/time/clock.h"
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/fingerprint.h"
 
 namespace open_spiel {
 namespace testing {
@@ -137,6 +140,14 @@ void LegalActionsMaskTest(const Game& game, const State& state,
   }
 
   SPIEL_CHECK_EQ(num_ones, legal_actions.size());
+
+  // The mask of every other player agrees with its legal actions.
+  for (Player player = 0; player < game.NumPlayers(); ++player) {
+    if (player == state.CurrentPlayer()) continue;
+    std::vector<int> mask = state.LegalActionsMask(player);
+    SPIEL_CHECK_EQ(std::accumulate(mask.begin(), mask.end(), 0),
+                   state.LegalActions(player).size());
+  }
 }
 
 bool IsPowerOfTwo(int n) { return n == 0 || (n & (n - 1)) == 0; }
@@ -180,6 +191,25 @@ void TestSerializeDeserialize(const Game& game, const State* state) {
       game_and_state = DeserializeGameAndState(ser_str);
   SPIEL_CHECK_EQ(game.ToString(), game_and_state.first->ToString());
   SPIEL_CHECK_EQ(state->ToString(), game_and_state.second->ToString());
+
+  std::string binary;
+  state->SerializeBinary(&binary);
+  absl::string_view data = binary;
+  std::unique_ptr<State> binary_state = game.DeserializeStateBinary(&data);
+  SPIEL_CHECK_TRUE(data.empty());
+  SPIEL_CHECK_EQ(state->ToString(), binary_state->ToString());
+  // Without a snapshot, sampled stochastic games are written with Serialize,
+  // which need not restore the history.
+  std::string snapshot;
+  if (state->SerializeSnapshot(&snapshot) ||
+      game.GetType().chance_mode != GameType::ChanceMode::kSampledStochastic) {
+    SPIEL_CHECK_EQ(state->History(), binary_state->History());
+  }
+
+  std::vector<std::unique_ptr<State>> states = DeserializeStatesBinary(
+      game, SerializeStatesBinary({state, binary_state.get()}));
+  SPIEL_CHECK_EQ(states.size(), 2);
+  SPIEL_CHECK_EQ(state->ToString(), states[1]->ToString());
 }
 
 void TestHistoryContainsActions(const Game& game,
@@ -258,6 +288,13 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
     SPIEL_CHECK_EQ(state->ToString(), state_copy->ToString());
     SPIEL_CHECK_EQ(state->History(), state_copy->History());
 
+    // CloneInto, if supported, must be equivalent to Clone.
+    std::unique_ptr<open_spiel::State> recycled = game.NewInitialState();
+    if (state->CloneInto(recycled.get())) {
+      SPIEL_CHECK_EQ(state->ToString(), recycled->ToString());
+      SPIEL_CHECK_EQ(state->History(), recycled->History());
+    }
+
     if (serialize && (history.size() < 10 || IsPowerOfTwo(history.size()))) {
       TestSerializeDeserialize(game, state.get());
     }
@@ -543,5 +580,31 @@ void ResampleInfostateTest(const Game& game, int num_sims) {
   }
 }
 
+void InformationStateFingerprintTest(const Game& game, int num_sims) {
+  std::mt19937 rng;
+  std::unordered_map<std::string, absl::uint128> fingerprints;
+  std::unordered_map<absl::uint128, std::string, FingerprintHash> strings;
+  for (int i = 0; i < num_sims; ++i) {
+    std::unique_ptr<State> state = game.NewInitialState();
+    while (!state->IsTerminal()) {
+      if (!state->IsChanceNode()) {
+        for (Player p = 0; p < game.NumPlayers(); ++p) {
+          std::string info_state = state->InformationStateString(p);
+          absl::uint128 fingerprint = state->InformationStateFingerprint(p);
+          auto [string_it, new_string] =
+              fingerprints.insert({info_state, fingerprint});
+          auto [fingerprint_it, new_fingerprint] =
+              strings.insert({fingerprint, info_state});
+          SPIEL_CHECK_EQ(string_it->second, fingerprint);
+          SPIEL_CHECK_EQ(fingerprint_it->second, info_state);
+        }
+      }
+      std::vector<Action> actions = state->LegalActions();
+      std::uniform_int_distribution<int> dis(0, actions.size() - 1);
+      state->ApplyAction(actions[dis(rng)]);
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace open_spiel
@@ -58,6 +58,10 @@ void RandomSimTestNoSerialize(const Game& game, int num_sims);
 // Verifies that ResampleFromInfostate is correctly implemented.
 void ResampleInfostateTest(const Game& game, int num_sims);
 
+// Checks over num_sims random simulations that InformationStateFingerprint
+// and InformationStateString partition the information states identically.
+void InformationStateFingerprintTest(const Game& game, int num_sims);
+
 }  // namespace testing
 }  // namespace open_spiel
 
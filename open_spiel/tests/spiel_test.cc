@@ -290,6 +290,22 @@ void GameParametersTest() {
   SPIEL_CHECK_EQ(game2["param"].string_value(), "val");
 }
 
+void LoadGameCacheTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker(players=3)");
+  SPIEL_CHECK_EQ(game, LoadGame("kuhn_poker(players=3)"));
+  SPIEL_CHECK_EQ(game,
+                 LoadGame("kuhn_poker", {{"players", GameParameter(3)}}));
+  SPIEL_CHECK_NE(game, LoadGame("kuhn_poker(players=4)"));
+  SPIEL_CHECK_NE(game, LoadGame("kuhn_poker"));
+
+  // Doubles are compared exactly, not as printed by GameParametersToString.
+  SPIEL_CHECK_NE(LoadGame("go(komi=7.5)"), LoadGame("go(komi=7.5000001)"));
+
+  // The cache does not keep games alive.
+  std::weak_ptr<const Game> unused = LoadGame("kuhn_poker(players=5)");
+  SPIEL_CHECK_TRUE(unused.expired());
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace open_spiel
@@ -302,4 +318,5 @@ int main(int argc, char** argv) {
   open_spiel::testing::PolicyTest();
   open_spiel::testing::LeducPokerDeserializeTest();
   open_spiel::testing::GameParametersTest();
+  open_spiel::testing::LoadGameCacheTest();
 }
@@ -0,0 +1,89 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_FINGERPRINT_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_FINGERPRINT_H_
+
+#include <cstdint>
+#include <cstring>
+
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+
+namespace open_spiel {
+
+// Builds a 128-bit fingerprint from a sequence of integers and strings. The
+// value only depends on the sequence that was added, so unlike absl::Hash it
+// is the same across runs and platforms and can be stored.
+//
+// This is not a cryptographic hash: it is meant to replace string keys in
+// tables with millions of entries, where two 64-bit lanes make collisions
+// vanishingly unlikely.
+//
+//   absl::uint128 fp = Fingerprinter().Add(card).Add(num_bets).Fingerprint();
+class Fingerprinter {
+ public:
+  Fingerprinter& Add(uint64_t value) {
+    lo_ = Mix(lo_ ^ value);
+    hi_ = Mix(hi_ + value * kOddMultiplier);
+    return *this;
+  }
+
+  // Strings are length-prefixed, so that the boundary between consecutive
+  // strings is part of the fingerprint.
+  Fingerprinter& Add(absl::string_view str) {
+    Add(str.size());
+    size_t pos = 0;
+    for (; pos + sizeof(uint64_t) <= str.size(); pos += sizeof(uint64_t)) {
+      uint64_t chunk;
+      std::memcpy(&chunk, str.data() + pos, sizeof(uint64_t));
+      Add(chunk);
+    }
+    if (pos < str.size()) {
+      uint64_t chunk = 0;
+      std::memcpy(&chunk, str.data() + pos, str.size() - pos);
+      Add(chunk);
+    }
+    return *this;
+  }
+
+  absl::uint128 Fingerprint() const {
+    return absl::MakeUint128(Mix(hi_ ^ lo_), lo_);
+  }
+
+ private:
+  static constexpr uint64_t kOddMultiplier = 0x9e3779b97f4a7c15ULL;
+
+  // The splitmix64 finalizer: a bijection with good avalanche behaviour.
+  static uint64_t Mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  uint64_t lo_ = 0x243f6a8885a308d3ULL;
+  uint64_t hi_ = 0x13198a2e03707344ULL;
+};
+
+// Hasher for unordered containers keyed by fingerprints. Fingerprints are
+// already well mixed, so the low word is used as is.
+struct FingerprintHash {
+  size_t operator()(absl::uint128 fingerprint) const {
+    return static_cast<size_t>(absl::Uint128Low64(fingerprint));
+  }
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_FINGERPRINT_H_
@@ -0,0 +1,63 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/fingerprint.h"
+
+#include <string>
+#include <unordered_set>
+
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+void TestFingerprintIsDeterministic() {
+  SPIEL_CHECK_EQ(Fingerprinter().Add(3).Add("abc").Fingerprint(),
+                 Fingerprinter().Add(3).Add("abc").Fingerprint());
+  SPIEL_CHECK_NE(Fingerprinter().Add(3).Add(4).Fingerprint(),
+                 Fingerprinter().Add(4).Add(3).Fingerprint());
+  SPIEL_CHECK_NE(Fingerprinter().Fingerprint(),
+                 Fingerprinter().Add(0).Fingerprint());
+}
+
+void TestStringBoundaries() {
+  SPIEL_CHECK_NE(Fingerprinter().Add("ab").Add("c").Fingerprint(),
+                 Fingerprinter().Add("a").Add("bc").Fingerprint());
+  const std::string with_trailing_zero("abcdefgh\0", 9);
+  SPIEL_CHECK_NE(Fingerprinter().Add("abcdefgh").Fingerprint(),
+                 Fingerprinter().Add(with_trailing_zero).Fingerprint());
+  SPIEL_CHECK_NE(Fingerprinter().Add(std::string(9, 'x')).Fingerprint(),
+                 Fingerprinter().Add(std::string(10, 'x')).Fingerprint());
+}
+
+void TestNoCollisionsOnSmallSequences() {
+  std::unordered_set<absl::uint128, FingerprintHash> seen;
+  for (int a = 0; a < 100; ++a) {
+    for (int b = 0; b < 100; ++b) {
+      SPIEL_CHECK_TRUE(seen.insert(Fingerprinter().Add(a).Add(b).Fingerprint())
+                           .second);
+    }
+    SPIEL_CHECK_TRUE(seen.insert(Fingerprinter().Add(a).Fingerprint()).second);
+  }
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::TestFingerprintIsDeterministic();
+  open_spiel::TestStringBoundaries();
+  open_spiel::TestNoCollisionsOnSmallSequences();
+}
@@ -0,0 +1,76 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_VARINT_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_VARINT_H_
+
+#include <cstdint>
+#include <string>
+
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+
+// Little-endian base-128 integers, as in protocol buffers: 7 bits per byte,
+// with the high bit set on every byte but the last. Values below 128 take a
+// single byte, which covers most action ids.
+inline void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Reads a varint from the front of `data` and advances past it. Returns false
+// if `data` ends in the middle of the value or the value is longer than 64
+// bits, for input which may be corrupt.
+inline bool TryReadVarint(absl::string_view* data, uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (data->empty()) return false;
+    uint8_t byte = static_cast<uint8_t>(data->front());
+    data->remove_prefix(1);
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (byte < 0x80) return true;
+  }
+  return false;
+}
+
+// As TryReadVarint, but fails on invalid data.
+inline uint64_t ReadVarint(absl::string_view* data) {
+  uint64_t value;
+  if (!TryReadVarint(data, &value)) {
+    SpielFatalError("Truncated varint, or longer than 64 bits.");
+  }
+  return value;
+}
+
+// Signed values are zigzag-encoded first, so that small negative values such
+// as kChancePlayerId stay short.
+inline void AppendSignedVarint(int64_t value, std::string* out) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               out);
+}
+
+inline int64_t ReadSignedVarint(absl::string_view* data) {
+  uint64_t zigzag = ReadVarint(data);
+  return static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+}
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_VARINT_H_
@@ -0,0 +1,85 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/varint.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+void TestUnsignedRoundTrip() {
+  const std::vector<uint64_t> values = {
+      0, 1, 127, 128, 300, 1ULL << 35, std::numeric_limits<uint64_t>::max()};
+  std::string data;
+  for (uint64_t value : values) AppendVarint(value, &data);
+  absl::string_view view = data;
+  for (uint64_t value : values) SPIEL_CHECK_EQ(ReadVarint(&view), value);
+  SPIEL_CHECK_TRUE(view.empty());
+}
+
+void TestSignedRoundTrip() {
+  const std::vector<int64_t> values = {0,
+                                       -1,
+                                       1,
+                                       -64,
+                                       64,
+                                       -1000000,
+                                       std::numeric_limits<int64_t>::min(),
+                                       std::numeric_limits<int64_t>::max()};
+  std::string data;
+  for (int64_t value : values) AppendSignedVarint(value, &data);
+  absl::string_view view = data;
+  for (int64_t value : values) SPIEL_CHECK_EQ(ReadSignedVarint(&view), value);
+  SPIEL_CHECK_TRUE(view.empty());
+}
+
+void TestEncodedSizes() {
+  std::string data;
+  AppendVarint(127, &data);
+  SPIEL_CHECK_EQ(data.size(), 1);
+  AppendVarint(128, &data);
+  SPIEL_CHECK_EQ(data.size(), 3);
+  data.clear();
+  AppendSignedVarint(-1, &data);
+  SPIEL_CHECK_EQ(data.size(), 1);
+}
+
+void TestInvalidData() {
+  uint64_t value;
+  absl::string_view truncated = "\x80\x80";
+  SPIEL_CHECK_FALSE(TryReadVarint(&truncated, &value));
+  const std::string too_long(10, '\xff');
+  absl::string_view view = too_long;
+  SPIEL_CHECK_FALSE(TryReadVarint(&view, &value));
+  absl::string_view valid = "\xac\x02";
+  SPIEL_CHECK_TRUE(TryReadVarint(&valid, &value));
+  SPIEL_CHECK_EQ(value, 300);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::TestUnsignedRoundTrip();
+  open_spiel::TestSignedRoundTrip();
+  open_spiel::TestEncodedSizes();
+  open_spiel::TestInvalidData();
+}